@@ -26,6 +26,22 @@ local TAU = Math.constants.TAU
 
 
 
+-- Looks up the target and its Transform; returns true once both are found
+local function FindTarget()
+    gun = gun or Engine.GetGameObjectByTag(GameObjectName)
+    if not gun then
+        return false
+    end
+    transform = gun:GetComponent("Transform")
+    if not transform then
+        return false
+    end
+    local x, y, z = transform:GetPositionXYZ()
+    initial_position = { x = x, y = y, z = z }
+    Engine.Log("Gun found and initial position updated.", { 1, 1, 1, 1 })
+    return true
+end
+
 function OnInit()
     local startTime = os.clock()
 
@@ -40,32 +56,14 @@ function OnInit()
 
 
 
-    if not gun then
-        gun = Engine.GetGameObjectByTag(GameObjectName)
-        if gun then
-            transform = gun:GetComponent("Transform")
-            if transform then
-                local pos = transform:GetPosition()
-                initial_position = { x = pos.x, y = pos.y, z = pos.z }
-                Engine.Log("Gun found and initial position updated.", { 1, 1, 1, 1 })
-            else
-                Engine.Log("Transform component not found on Gun.", { 1, 1, 0, 1 })
-                return
+    -- Keep looking for the target in the background instead of re-checking every OnUpdate
+    if not FindTarget() then
+        Engine.Log("Gun GameObject not found yet, waiting for it.", { 1, 1, 0, 1 })
+        Engine.StartCoroutine(function()
+            while not FindTarget() do
+                Engine.Wait(0.5)
             end
-        else
-            Engine.Log("Gun GameObject still not found.", { 1, 1, 0, 1 })
-            return
-        end
-    elseif not transform then
-        transform = gun:GetComponent("Transform")
-        if transform then
-            local pos = transform:GetPosition()
-            initial_position = { x = pos.x, y = pos.y, z = pos.z }
-            Engine.Log("Transform component found and initial position updated.", { 1, 1, 1, 1 })
-        else
-            Engine.Log("Transform component still not found on Gun.", { 1, 1, 0, 1 })
-            return
-        end
+        end)
     end
     Engine.Log("Init OK", { 0.0, 1.0, 0.0, 1.0 })
 
@@ -83,31 +81,9 @@ function OnUpdate(deltaTime)
     Engine.Expose("elapsedTime", elapsedTime)
     Engine.Expose("bobAmplitude", bobAmplitude)
     Engine.Expose("bobFrequency", bobFrequency)
-    -- Ensure that the Gun and its Transform component are valid
-    if not gun then
-        gun = Engine.GetGameObjectByTag(GameObjectName)
-        if gun then
-            transform = gun:GetComponent("Transform")
-            if transform then
-                local pos = transform:GetPosition()
-                initial_position = { x = pos.x, y = pos.y, z = pos.z }
-                Engine.Log("Gun found and initial position updated.", { 1, 1, 1, 1 })
-            else
-                Engine.Log("Transform component not found on Gun.", { 1, 1, 0, 1 })
-                return
-            end
-        else
-            return
-        end
-    elseif not transform then
-        transform = gun:GetComponent("Transform")
-        if transform then
-            local pos = transform:GetPosition()
-            initial_position = { x = pos.x, y = pos.y, z = pos.z }
-            Engine.Log("Transform component found and initial position updated.", { 1, 1, 1, 1 })
-        else
-            return
-        end
+    -- Nothing to animate until the coroutine started in OnInit has found the target
+    if not transform then
+        return
     end
 
     -- Increment elapsed time
@@ -122,29 +98,15 @@ function OnUpdate(deltaTime)
         new_rotation = new_rotation - 360
     end
 
-    -- Define the new rotation (spinning around the Y-axis)
-    local rotation = {
-        x = 0,            -- Preserving existing rotation on X-axis
-        y = new_rotation, -- Updated rotation on Y-axis for spinning
-        z = 0             -- Preserving existing rotation on Z-axis
-    }
-
-    -- Apply the new rotation to the Transform component
-    transform:SetRotation(rotation)
+    -- Apply the new rotation (spinning around the Y-axis); the XYZ setters don't create tables
+    transform:SetRotationXYZ(0, new_rotation, 0)
 
     -- === Bobbing the Gun Up and Down ===
     -- Calculate the bobbing offset using a sine wave
     local bobOffset = bobAmplitude * math.sin(TAU * bobFrequency * elapsedTime)
 
-    -- Define the new position by adding the bobbing offset to the initial Y position
-    local new_position = {
-        x = initial_position.x,             -- No change on X-axis
-        y = initial_position.y + bobOffset, -- Bouncing up and down on Y-axis
-        z = initial_position.z              -- No change on Z-axis
-    }
-
-    -- Apply the new position to the Transform component
-    transform:SetPosition(new_position)
+    -- Apply the new position: bouncing up and down on the Y-axis around the initial position
+    transform:SetPositionXYZ(initial_position.x, initial_position.y + bobOffset, initial_position.z)
 
     -- === Optional: Log Current Rotation and Position ===
     -- Uncomment the following lines if you wish to log the gun's current rotation and position
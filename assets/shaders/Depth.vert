@@ -3,8 +3,10 @@ layout(location = 0) in vec3 aPos;
 
 uniform mat4 lightSpaceMatrix;
 uniform mat4 model;
+uniform vec3 uPositionScale = vec3(1.0);  // Quantized positions: aPos * scale + offset
+uniform vec3 uPositionOffset = vec3(0.0);
 
 void main()
 {
-    gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+    gl_Position = lightSpaceMatrix * model * vec4(aPos * uPositionScale + uPositionOffset, 1.0);
 }
@@ -10,10 +10,32 @@ out vec2 TexCoord;
 out vec3 Normal;
 out vec3 FragPos;
 
+// Vertex format decode (see Engine/VertexFormat.h)
+uniform vec3 uPositionScale = vec3(1.0);  // Quantized positions: aPos * scale + offset
+uniform vec3 uPositionOffset = vec3(0.0);
+uniform bool uOctahedralNormals = false;  // aNormal.xy holds an octahedral encoded normal
+
+vec3 DecodePosition(vec3 p)
+{
+    return p * uPositionScale + uPositionOffset;
+}
+
+vec3 DecodeNormal(vec3 n)
+{
+    if (!uOctahedralNormals)
+        return n;
+    vec3 v = vec3(n.xy, 1.0 - abs(n.x) - abs(n.y));
+    if (v.z < 0.0)
+        v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(v);
+}
+
 void main()
 {
-    gl_Position = uMVP * vec4(aPos, 1.0);
+    vec3 position = DecodePosition(aPos);
+
+    gl_Position = uMVP * vec4(position, 1.0);
     TexCoord = aTexCoord;
-    Normal = aNormal;
-    FragPos = vec3(uMVP * vec4(aPos, 1.0));
+    Normal = DecodeNormal(aNormal);
+    FragPos = vec3(uMVP * vec4(position, 1.0));
 }
@@ -11,17 +11,40 @@ out vec2 TexCoord;    // Passed to fragment shader
 out vec3 Normal;      // Passed to fragment shader
 out vec3 FragPos;     // Passed to fragment shader
 
+// Vertex format decode (see Engine/VertexFormat.h)
+uniform vec3 uPositionScale = vec3(1.0);  // Quantized positions: aPos * scale + offset
+uniform vec3 uPositionOffset = vec3(0.0);
+uniform bool uOctahedralNormals = false;  // aNormal.xy holds an octahedral encoded normal
+
+vec3 DecodePosition(vec3 p)
+{
+    return p * uPositionScale + uPositionOffset;
+}
+
+vec3 DecodeNormal(vec3 n)
+{
+    if (!uOctahedralNormals)
+        return n;
+    vec3 v = vec3(n.xy, 1.0 - abs(n.x) - abs(n.y));
+    if (v.z < 0.0)
+        v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(v);
+}
+
 void main()
 {
+    vec3 position = DecodePosition(aPos);
+    vec3 normal = DecodeNormal(aNormal);
+
     // Compute the fragment position in world space
-    FragPos = vec3(uModel * vec4(aPos, 1.0));
+    FragPos = vec3(uModel * vec4(position, 1.0));
     
     // Transform the normal vector
-    Normal = mat3(transpose(inverse(uModel))) * aNormal;  
+    Normal = mat3(transpose(inverse(uModel))) * normal;  
     
     // Pass through the texture coordinate
     TexCoord = aTexCoord;
     
     // Final vertex position
-    gl_Position = uMVP * vec4(aPos, 1.0);
+    gl_Position = uMVP * vec4(position, 1.0);
 }
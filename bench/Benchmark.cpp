@@ -0,0 +1,149 @@
+// bench/Benchmark.cpp
+
+#include "Benchmark.h"
+
+#include "Engine/Utilitys.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+bool BenchmarkRunner::ShouldRun(const std::string &name) const
+{
+    return m_Options.Filter.empty() || name.find(m_Options.Filter) != std::string::npos;
+}
+
+void BenchmarkRunner::Run(const std::string &name, size_t items, const std::function<void()> &body,
+                          const std::function<void()> &setup)
+{
+    if (!ShouldRun(name))
+        return;
+
+    for (int i = 0; i < m_Options.Warmup; ++i)
+    {
+        if (setup)
+            setup();
+        body();
+    }
+
+    std::vector<double> samples;
+    samples.reserve(m_Options.Repetitions);
+    for (int i = 0; i < m_Options.Repetitions; ++i)
+    {
+        if (setup)
+            setup();
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+
+    m_Results.push_back(Summarize(name, items, std::move(samples)));
+
+    const BenchmarkResult &result = m_Results.back();
+    std::printf("%-48s median %10.3f ms  mean %10.3f ms  stddev %8.3f ms  (%d runs)\n",
+                result.Name.c_str(), result.MedianMs, result.MeanMs, result.StdDevMs,
+                static_cast<int>(result.SamplesMs.size()));
+    std::fflush(stdout);
+}
+
+BenchmarkResult BenchmarkRunner::Summarize(const std::string &name, size_t items, std::vector<double> samplesMs)
+{
+    BenchmarkResult result;
+    result.Name = name;
+    result.Items = items;
+    result.SamplesMs = std::move(samplesMs);
+    if (result.SamplesMs.empty())
+        return result;
+
+    std::vector<double> sorted(result.SamplesMs);
+    std::sort(sorted.begin(), sorted.end());
+    size_t count = sorted.size();
+
+    double sum = 0.0;
+    for (double sample : sorted)
+        sum += sample;
+    result.MeanMs = sum / count;
+    result.MedianMs = count % 2 ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) * 0.5;
+    result.MinMs = sorted.front();
+    result.MaxMs = sorted.back();
+
+    // Sample standard deviation; one run has none
+    if (count > 1)
+    {
+        double squares = 0.0;
+        for (double sample : sorted)
+            squares += (sample - result.MeanMs) * (sample - result.MeanMs);
+        result.StdDevMs = std::sqrt(squares / (count - 1));
+    }
+    return result;
+}
+
+static void WriteJsonNumber(std::ostream &out, double value)
+{
+    char number[32];
+    std::snprintf(number, sizeof(number), "%.6f", std::isfinite(value) ? value : 0.0);
+    out << number;
+}
+
+bool BenchmarkRunner::WriteJSON(const std::string &path) const
+{
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty())
+        std::filesystem::create_directories(parent, ec);
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+        return false;
+
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    out << "{\n  \"version\": 1,\n  \"timestamp\": \"" << timestamp << "\",\n";
+    out << "  \"context\": {\"compiler\": ";
+#if defined(__VERSION__)
+    WriteJsonString(out, __VERSION__);
+#else
+    WriteJsonString(out, "unknown");
+#endif
+    out << ", \"hardware_threads\": " << std::thread::hardware_concurrency();
+    out << ", \"repetitions\": " << m_Options.Repetitions << ", \"warmup\": " << m_Options.Warmup << "},\n";
+    out << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < m_Results.size(); ++i)
+    {
+        const BenchmarkResult &result = m_Results[i];
+        out << (i ? ",\n" : "\n") << "    {\"name\": ";
+        WriteJsonString(out, result.Name);
+        out << ", \"items\": " << result.Items;
+        out << ", \"mean_ms\": ";
+        WriteJsonNumber(out, result.MeanMs);
+        out << ", \"median_ms\": ";
+        WriteJsonNumber(out, result.MedianMs);
+        out << ", \"stddev_ms\": ";
+        WriteJsonNumber(out, result.StdDevMs);
+        out << ", \"min_ms\": ";
+        WriteJsonNumber(out, result.MinMs);
+        out << ", \"max_ms\": ";
+        WriteJsonNumber(out, result.MaxMs);
+        out << ", \"items_per_second\": ";
+        WriteJsonNumber(out, result.Items && result.MedianMs > 0.0 ? result.Items * 1000.0 / result.MedianMs : 0.0);
+        out << ", \"samples_ms\": [";
+        for (size_t sample = 0; sample < result.SamplesMs.size(); ++sample)
+        {
+            if (sample)
+                out << ", ";
+            WriteJsonNumber(out, result.SamplesMs[sample]);
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,59 @@
+// bench/Benchmark.h
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// Shared by every scenario in a run
+struct BenchmarkOptions
+{
+    int Repetitions = 10;       // Timed runs per benchmark
+    int Warmup = 1;             // Untimed runs before them (file cache, allocator pools)
+    std::string Filter;         // Only benchmarks whose name contains this run
+    std::vector<int> Objects = {100, 1000, 10000}; // Object counts for the scaling scenarios
+};
+
+// Timing statistics of one benchmark, in milliseconds per run
+struct BenchmarkResult
+{
+    std::string Name;
+    size_t Items = 0; // Work items per run (objects, files, meshlets); 0 if not meaningful
+    std::vector<double> SamplesMs;
+    double MeanMs = 0.0;
+    double MedianMs = 0.0;
+    double StdDevMs = 0.0;
+    double MinMs = 0.0;
+    double MaxMs = 0.0;
+};
+
+/**
+ * @brief Runs benchmarks with warmup and repetitions and collects their statistics.
+ *
+ * Each benchmark is a body timed as a whole, with an optional untimed setup
+ * before every run (warmup runs included) for scenarios that consume their
+ * input. Results are written as one JSON document so CI can diff runs.
+ */
+class BenchmarkRunner
+{
+public:
+    explicit BenchmarkRunner(const BenchmarkOptions &options) : m_Options(options) {}
+
+    // False if the filter excludes `name`
+    bool ShouldRun(const std::string &name) const;
+
+    // Times `body`; `items` is the work per run, reported as throughput
+    void Run(const std::string &name, size_t items, const std::function<void()> &body,
+             const std::function<void()> &setup = nullptr);
+
+    const std::vector<BenchmarkResult> &GetResults() const { return m_Results; }
+
+    // Every result plus the run configuration; false if the file can't be written
+    bool WriteJSON(const std::string &path) const;
+
+    static BenchmarkResult Summarize(const std::string &name, size_t items, std::vector<double> samplesMs);
+
+private:
+    BenchmarkOptions m_Options;
+    std::vector<BenchmarkResult> m_Results;
+};
@@ -0,0 +1,513 @@
+// bench/main.cpp
+
+// Headless benchmark suite: runs engine code paths without a window or a GL
+// context and writes timing statistics as JSON. Run from the repository root
+// so assets/, scenes/ and bench/scripts/ resolve.
+
+#include "Benchmark.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/SceneManager.h"
+#include "Engine/SceneIndex.h"
+#include "Engine/LuaAPI.h"
+#include "Componenets/GameObject.h"
+#include "Componenets/Mesh.h"
+#include "Componenets/Transform.h"
+#include "Rendering/LODSelector.h"
+#include "Rendering/MeshletCulling.h"
+#include "Rendering/SoftwareRasterizer.h"
+#include "Windows/LoggerWindow.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Engine globals, normally defined in Engine.cpp
+AssetManager g_AssetManager;
+LoggerWindow *g_LoggerWindow;
+SceneIndex g_SceneIndex;
+std::vector<std::shared_ptr<GameObject>> g_GameObjects;
+
+static const char *BenchScript = "bench/scripts/Spin.lua";
+static const int LuaFramesPerRun = 10;
+static const int CullingViews = 16;
+static const int RasterWidth = 1280;
+static const int RasterHeight = 720;
+
+// Keeps results of otherwise unused computations alive
+static volatile float s_Sink = 0.0f;
+
+// Regular files in `directory` with the given extension, sorted so runs are comparable
+static std::vector<std::filesystem::path> ListFiles(const std::string &directory, const std::string &extension)
+{
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, ec))
+    {
+        if (entry.is_regular_file() && entry.path().extension() == extension)
+            files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+static void ClearScene()
+{
+    g_SceneIndex.Clear();
+    g_GameObjects.clear();
+}
+
+// `count` objects named BenchObject<i> on a grid in front of the origin, so culling and LOD see near, far and off-screen objects
+static void SpawnObjects(int count)
+{
+    ClearScene();
+    g_GameObjects.reserve(count);
+
+    int side = std::max(1, static_cast<int>(std::ceil(std::cbrt(static_cast<double>(count)))));
+    for (int i = 0; i < count; ++i)
+    {
+        auto gameObject = std::make_shared<GameObject>(i, "BenchObject" + std::to_string(i));
+        auto transform = std::make_shared<TransformComponent>();
+        int x = i % side;
+        int y = (i / side) % side;
+        int z = i / (side * side);
+        transform->position = glm::vec3((x - side * 0.5f) * 4.0f, (y - side * 0.5f) * 4.0f, -4.0f - z * 4.0f);
+        transform->rotation = glm::vec3(0.0f, static_cast<float>((i * 37) % 360), 0.0f);
+        gameObject->AddComponent(transform);
+
+        g_GameObjects.push_back(gameObject);
+        g_SceneIndex.Add(gameObject.get());
+    }
+}
+
+// Same composition RenderWindow uses
+static glm::mat4 ModelMatrix(const TransformComponent &transform)
+{
+    glm::mat4 model = glm::translate(glm::mat4(1.f), transform.position);
+    model = glm::rotate(model, glm::radians(transform.rotation.x), glm::vec3(1.f, 0.f, 0.f));
+    model = glm::rotate(model, glm::radians(transform.rotation.y), glm::vec3(0.f, 1.f, 0.f));
+    model = glm::rotate(model, glm::radians(transform.rotation.z), glm::vec3(0.f, 0.f, 1.f));
+    return glm::scale(model, transform.scale);
+}
+
+static glm::mat4 Projection()
+{
+    return glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+}
+
+// Union of the submeshes' object space bounds
+static void ModelBounds(const Model &model, glm::vec3 &boundsMin, glm::vec3 &boundsMax)
+{
+    boundsMin = boundsMax = glm::vec3(0.f);
+    for (size_t i = 0; i < model.submeshes.size(); ++i)
+    {
+        const Submesh &submesh = model.submeshes[i];
+        glm::vec3 subMin(submesh.boundsMin[0], submesh.boundsMin[1], submesh.boundsMin[2]);
+        glm::vec3 subMax(submesh.boundsMax[0], submesh.boundsMax[1], submesh.boundsMax[2]);
+        boundsMin = i ? glm::min(boundsMin, subMin) : subMin;
+        boundsMax = i ? glm::max(boundsMax, subMax) : subMax;
+    }
+}
+
+static void BenchOBJParsing(BenchmarkRunner &runner)
+{
+    for (const std::filesystem::path &path : ListFiles("assets/models", ".obj"))
+    {
+        // Items are bytes of OBJ text, so items_per_second is parse throughput
+        std::error_code ec;
+        size_t bytes = static_cast<size_t>(std::filesystem::file_size(path, ec));
+        std::string file = path.string();
+        runner.Run("obj_parse/" + path.filename().string(), bytes, [&]()
+                   { g_AssetManager.loadAsset<Model>(AssetType::MODEL, file); });
+    }
+}
+
+static void BenchMeshletCulling(BenchmarkRunner &runner)
+{
+    for (const std::filesystem::path &path : ListFiles("assets/models", ".obj"))
+    {
+        std::string name = "meshlet_cull/" + path.filename().string();
+        if (!runner.ShouldRun(name))
+            continue;
+
+        std::shared_ptr<Model> model = g_AssetManager.loadAsset<Model>(AssetType::MODEL, path.string());
+        if (!model)
+            continue;
+
+        size_t meshlets = 0;
+        for (const Submesh &submesh : model->submeshes)
+            meshlets += submesh.meshlets.size();
+        if (meshlets == 0)
+            continue;
+
+        glm::vec3 boundsMin, boundsMax;
+        ModelBounds(*model, boundsMin, boundsMax);
+
+        // Cameras circling the model at twice its radius, seeing it whole from every side
+        glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        float radius = std::max(glm::length(boundsMax - boundsMin) * 0.5f, 0.01f);
+        std::vector<Frustum> frustums;
+        std::vector<glm::vec3> eyes;
+        for (int view = 0; view < CullingViews; ++view)
+        {
+            float angle = glm::two_pi<float>() * view / CullingViews;
+            glm::vec3 eye = center + glm::vec3(std::cos(angle), 0.3f, std::sin(angle)) * radius * 2.0f;
+            frustums.push_back(MeshletCulling::ExtractFrustum(Projection() * glm::lookAt(eye, center, glm::vec3(0.f, 1.f, 0.f))));
+            eyes.push_back(eye);
+        }
+
+        const glm::mat4 identity(1.f);
+        runner.Run(name, meshlets * CullingViews, [&]()
+                   {
+                       int visible = 0;
+                       for (int view = 0; view < CullingViews; ++view)
+                       {
+                           for (const Submesh &submesh : model->submeshes)
+                           {
+                               bool coneCulling = g_MeshletCullingSettings.ConeCulling &&
+                                                  (submesh.closed || g_MeshletCullingSettings.ConeCullOpenMeshes);
+                               for (const Meshlet &meshlet : submesh.meshlets)
+                               {
+                                   if (MeshletCulling::Classify(meshlet, identity, 1.0f, frustums[view], eyes[view],
+                                                                g_MeshletCullingSettings.FrustumCulling, coneCulling) == MeshletVisibility::Visible)
+                                       visible++;
+                               }
+                           }
+                       }
+                       s_Sink = s_Sink + static_cast<float>(visible); });
+    }
+}
+
+// Full software frames of each model: vertex stage, clipping, binning and tile rasterization
+static void BenchSoftwareRaster(BenchmarkRunner &runner)
+{
+    for (const std::filesystem::path &path : ListFiles("assets/models", ".obj"))
+    {
+        std::string name = "software_raster/" + path.filename().string();
+        if (!runner.ShouldRun(name))
+            continue;
+
+        std::shared_ptr<Model> model = g_AssetManager.loadAsset<Model>(AssetType::MODEL, path.string());
+        if (!model)
+            continue;
+
+        // Items are submitted triangles, so items_per_second is raster throughput
+        size_t triangles = 0;
+        for (const Submesh &submesh : model->submeshes)
+            triangles += static_cast<size_t>(submesh.indexCount) / 3;
+        if (triangles == 0)
+            continue;
+
+        ClearScene();
+        auto gameObject = std::make_shared<GameObject>(0, "RasterObject");
+        gameObject->AddComponent(std::make_shared<TransformComponent>());
+        auto mesh = std::make_shared<MeshComponent>();
+        mesh->submeshes = model->submeshes;
+        mesh->MeshPath = path.string();
+        gameObject->AddComponent(mesh);
+        g_GameObjects.push_back(gameObject);
+
+        // Same framing as the first meshlet culling view
+        glm::vec3 boundsMin, boundsMax;
+        ModelBounds(*model, boundsMin, boundsMax);
+        glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+        float radius = std::max(glm::length(boundsMax - boundsMin) * 0.5f, 0.01f);
+        glm::vec3 eye = center + glm::vec3(1.f, 0.3f, 0.f) * radius * 2.0f;
+        glm::mat4 view = glm::lookAt(eye, center, glm::vec3(0.f, 1.f, 0.f));
+
+        // Textures are decoded on the first frame and cached, so warmup runs absorb the decode
+        SoftwareRasterizer rasterizer;
+        rasterizer.Init();
+        rasterizer.Resize(RasterWidth, RasterHeight);
+        runner.Run(name, triangles, [&]()
+                   {
+                       rasterizer.RenderScene(g_GameObjects, view, Projection());
+                       s_Sink = s_Sink + static_cast<float>(rasterizer.GetRasterizedTriangleCount()); });
+
+        ClearScene();
+    }
+}
+
+static void BenchScenes(BenchmarkRunner &runner)
+{
+    SceneManager sceneManager;
+    std::filesystem::path savePath = std::filesystem::temp_directory_path() / "TesseractBench.scene";
+
+    for (const std::filesystem::path &path : ListFiles("scenes", ".scene"))
+    {
+        std::string file = path.string();
+        std::string loadName = "scene_load/" + path.filename().string();
+        std::string saveName = "scene_save/" + path.filename().string();
+
+        runner.Run(loadName, 1, [&]()
+                   { sceneManager.LoadScene(g_GameObjects, file); });
+
+        if (runner.ShouldRun(saveName))
+        {
+            if (!runner.ShouldRun(loadName))
+                sceneManager.LoadScene(g_GameObjects, file);
+            runner.Run(saveName, g_GameObjects.size(), [&]()
+                       { sceneManager.SaveScene(g_GameObjects, savePath.string()); });
+        }
+        ClearScene();
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(savePath, ec);
+}
+
+// How scripts are hosted: one VM each, one shared VM, or private VMs updated on the job system
+struct LuaBenchMode
+{
+    const char *Name;
+    bool Shared;
+    bool Parallel;
+};
+
+static const LuaBenchMode LuaBenchModes[] = {
+    {"isolated", false, false},
+    {"shared", true, false},
+    {"parallel", false, true},
+};
+
+// One Spin.lua instance per spawned object
+static void CreateScripts(std::vector<std::unique_ptr<LuaManager>> &scripts, int count, const LuaBenchMode &mode)
+{
+    int failures = 0;
+    scripts.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        auto script = std::make_unique<LuaManager>();
+        script->SetThreadSafe(mode.Parallel);
+        if (script->Initialize(BenchScript))
+        {
+            script->UpdateVariable("TargetName", "BenchObject" + std::to_string(i));
+            script->Init();
+        }
+        else
+            failures++;
+        scripts.push_back(std::move(script));
+    }
+    if (failures > 0)
+        fprintf(stderr, "[Bench] %d of %d scripts failed to initialize (%s)\n", failures, count, mode.Name);
+}
+
+static void DestroyScripts(std::vector<std::unique_ptr<LuaManager>> &scripts)
+{
+    scripts.clear();
+    LuaManager::ShutdownSharedState();
+}
+
+// Script part of one engine frame, in the order MyEngine::Run does it
+static void UpdateScripts(std::vector<std::unique_ptr<LuaManager>> &scripts, float deltaTime)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &script : scripts)
+    {
+        if (!script->RunsInParallel())
+            script->Update(deltaTime);
+    }
+    LuaManager::UpdateParallel(deltaTime);
+    LuaManager::UpdateAll(deltaTime);
+
+    double workMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LuaManager::CollectGarbage(LuaManager::ComputeGCBudget(workMs));
+}
+
+static void BenchLua(BenchmarkRunner &runner, const std::vector<int> &objectCounts)
+{
+    bool previousShared = LuaManager::IsSharedStateEnabled();
+    bool previousParallel = LuaManager::IsParallelUpdatesEnabled();
+    std::vector<std::unique_ptr<LuaManager>> scripts;
+
+    for (const LuaBenchMode &mode : LuaBenchModes)
+    {
+        LuaManager::SetSharedStateEnabled(mode.Shared);
+        LuaManager::SetParallelUpdatesEnabled(mode.Parallel);
+
+        for (int count : objectCounts)
+        {
+            std::string suffix = std::string(mode.Name) + "/" + std::to_string(count);
+            std::string initName = "lua_init/" + suffix;
+            std::string updateName = "lua_update/" + suffix;
+            if (!runner.ShouldRun(initName) && !runner.ShouldRun(updateName))
+                continue;
+
+            SpawnObjects(count);
+
+            runner.Run(initName, count, [&]()
+                       { CreateScripts(scripts, count, mode); }, [&]()
+                       { DestroyScripts(scripts); });
+
+            if (runner.ShouldRun(updateName))
+            {
+                if (scripts.empty())
+                    CreateScripts(scripts, count, mode);
+                runner.Run(updateName, static_cast<size_t>(count) * LuaFramesPerRun, [&]()
+                           {
+                               for (int frame = 0; frame < LuaFramesPerRun; ++frame)
+                                   UpdateScripts(scripts, 1.0f / 60.0f); });
+            }
+
+            DestroyScripts(scripts);
+            ClearScene();
+        }
+    }
+
+    LuaManager::SetSharedStateEnabled(previousShared);
+    LuaManager::SetParallelUpdatesEnabled(previousParallel);
+}
+
+static void BenchTransforms(BenchmarkRunner &runner, const std::vector<int> &objectCounts)
+{
+    for (int count : objectCounts)
+    {
+        std::string name = "transform_update/" + std::to_string(count);
+        if (!runner.ShouldRun(name))
+            continue;
+
+        SpawnObjects(count);
+        runner.Run(name, count, [&]()
+                   {
+                       float sum = 0.0f;
+                       for (const auto &gameObject : g_GameObjects)
+                       {
+                           std::shared_ptr<TransformComponent> transform = gameObject->GetComponent<TransformComponent>();
+                           transform->rotation.y = std::fmod(transform->rotation.y + 1.5f, 360.0f);
+                           sum += ModelMatrix(*transform)[3][0];
+                       }
+                       s_Sink = s_Sink + sum; });
+        ClearScene();
+    }
+}
+
+// Per-object part of RenderWindow's scene pass: model matrix, projected bounds and LOD choice
+static void BenchLODSelection(BenchmarkRunner &runner, const std::vector<int> &objectCounts)
+{
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.f, 2.f, 10.f), glm::vec3(0.f, 0.f, -20.f), glm::vec3(0.f, 1.f, 0.f));
+    const glm::mat4 proj = Projection();
+    const glm::vec3 boundsMin(-1.f), boundsMax(1.f);
+
+    for (int count : objectCounts)
+    {
+        std::string name = "lod_select/" + std::to_string(count);
+        if (!runner.ShouldRun(name))
+            continue;
+
+        SpawnObjects(count);
+        std::vector<int> currentLOD(count, 0);
+        runner.Run(name, count, [&]()
+                   {
+                       for (size_t i = 0; i < g_GameObjects.size(); ++i)
+                       {
+                           std::shared_ptr<TransformComponent> transform = g_GameObjects[i]->GetComponent<TransformComponent>();
+                           glm::mat4 model = ModelMatrix(*transform);
+                           glm::vec3 worldCenter = glm::vec3(model * glm::vec4((boundsMin + boundsMax) * 0.5f, 1.f));
+                           float maxScale = std::max(std::fabs(transform->scale.x), std::max(std::fabs(transform->scale.y), std::fabs(transform->scale.z)));
+                           float worldRadius = glm::length(boundsMax - boundsMin) * 0.5f * maxScale;
+                           float screenSize = LODSelector::ProjectedScreenSize(worldCenter, worldRadius, view, proj);
+                           currentLOD[i] = LODSelector::SelectLOD(screenSize, currentLOD[i], MAX_MESH_LODS, g_LODSettings);
+                       }
+                       s_Sink = s_Sink + static_cast<float>(currentLOD.back()); });
+        ClearScene();
+    }
+}
+
+static std::vector<int> ParseCounts(const char *text)
+{
+    std::vector<int> counts;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        int count = std::atoi(item.c_str());
+        if (count > 0)
+            counts.push_back(count);
+    }
+    return counts;
+}
+
+static void PrintUsage()
+{
+    printf("Usage: TesseractBench [options]\n"
+           "  --repetitions N   timed runs per benchmark (default 10)\n"
+           "  --warmup N        untimed runs before them (default 1)\n"
+           "  --objects A,B,..  object counts for Lua, transform and LOD benchmarks (default 100,1000,10000)\n"
+           "  --filter TEXT     only run benchmarks whose name contains TEXT\n"
+           "  --output PATH     JSON results file (default bench_results.json)\n");
+}
+
+int main(int argc, char **argv)
+{
+    BenchmarkOptions options;
+    std::string outputPath = "bench_results.json";
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc)
+            options.Repetitions = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+            options.Warmup = std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--objects") == 0 && i + 1 < argc)
+            options.Objects = ParseCounts(argv[++i]);
+        else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            options.Filter = argv[++i];
+        else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+            outputPath = argv[++i];
+        else if (std::strcmp(argv[i], "--help") == 0)
+        {
+            PrintUsage();
+            return 0;
+        }
+        else
+        {
+            fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    // Log lines are collected but never shown; the logger is cleared between scenarios
+    LoggerWindow logger;
+    g_LoggerWindow = &logger;
+
+    // No GL context: models stay CPU-side, textures are decoded and dropped
+    g_AssetManager.SetGPUUploadEnabled(false);
+
+    BenchmarkRunner runner(options);
+
+    BenchOBJParsing(runner);
+    logger.Clear();
+    BenchMeshletCulling(runner);
+    logger.Clear();
+    BenchSoftwareRaster(runner);
+    logger.Clear();
+    BenchScenes(runner);
+    logger.Clear();
+    BenchLua(runner, options.Objects);
+    logger.Clear();
+    BenchTransforms(runner, options.Objects);
+    BenchLODSelection(runner, options.Objects);
+
+    ClearScene();
+    LuaManager::ShutdownSharedState();
+
+    if (!runner.WriteJSON(outputPath))
+    {
+        fprintf(stderr, "[Bench] Failed to write %s\n", outputPath.c_str());
+        return 1;
+    }
+    printf("%zu benchmarks written to %s\n", runner.GetResults().size(), outputPath.c_str());
+    return 0;
+}
@@ -0,0 +1,36 @@
+-- Spin.lua
+-- Benchmark script: spins and bobs one object. The harness sets TargetName
+-- before OnInit, so every instance drives its own object.
+
+local Engine = require("./assets/scripts/engine")
+
+TargetName = TargetName or ""
+
+local transform = nil
+local elapsedTime = 0
+local rotationSpeed = 90 -- Degrees per second
+local bobAmplitude = 0.25
+local baseY = 0
+
+function OnInit()
+    local target = Engine.GetGameObjectByName(TargetName)
+    if target then
+        transform = target:GetComponent("Transform")
+    end
+    if transform then
+        local _, y, _ = transform:GetPositionXYZ()
+        baseY = y
+    end
+end
+
+function OnUpdate(deltaTime)
+    if not transform then
+        return
+    end
+
+    elapsedTime = elapsedTime + deltaTime
+
+    local x, _, z = transform:GetPositionXYZ()
+    transform:SetPositionXYZ(x, baseY + bobAmplitude * math.sin(elapsedTime * 2), z)
+    transform:SetRotationXYZ(0, (elapsedTime * rotationSpeed) % 360, 0)
+end
@@ -4,6 +4,7 @@
 
 #include <string>
 #include <yaml-cpp/yaml.h>
+#include "Engine/EntityHandle.h"
 
 // Forward declaration to avoid circular dependency
 class GameObject;
@@ -12,10 +13,14 @@ class Component
 {
 public:
     // Constructor accepting a pointer to the owning GameObject
-    Component() {}
+    Component() : m_Handle(EntityRegistry::Get().Register(this)) {}
 
     // Virtual destructor
-    virtual ~Component() {}
+    virtual ~Component() { EntityRegistry::Get().Unregister(m_Handle); }
+
+    // Handles are tied to the instance
+    Component(const Component &) = delete;
+    Component &operator=(const Component &) = delete;
 
     // Pure virtual methods
     virtual const std::string &GetName() const = 0;
@@ -35,6 +40,12 @@ public:
     // Getter for the owning GameObject
     GameObject *GetOwner() const { return m_Owner; }
 
+    // Generational handle scripts refer to this component by
+    EntityHandle GetHandle() const { return m_Handle; }
+
 protected:
     GameObject *m_Owner; // Pointer to the owning GameObject
+
+private:
+    EntityHandle m_Handle;
 };
@@ -2,6 +2,7 @@
 #include "GameObject.h"
 #include "Transform.h"
 #include <iostream>
+#include <algorithm>
 #include "gcml.h"
 
 #include "../Windows/LoggerWindow.h"
@@ -9,10 +10,15 @@
 extern LoggerWindow *g_LoggerWindow;
 
 GameObject::GameObject(int id, const std::string &name)
-    : id(id), name(name)
+    : id(id), name(name), m_Handle(EntityRegistry::Get().Register(this))
 {
 }
 
+GameObject::~GameObject()
+{
+    EntityRegistry::Get().Unregister(m_Handle);
+}
+
 int GameObject::GetComponentCount() const
 {
     return static_cast<int>(components.size());
@@ -23,6 +29,11 @@ std::string GameObject::GetName() const
     return name;
 }
 
+bool GameObject::HasTag(const std::string &tag) const
+{
+    return std::find(tags.begin(), tags.end(), tag) != tags.end();
+}
+
 
 
 void GameObject::AddComponent(const std::shared_ptr<Component> &component)
@@ -60,6 +71,10 @@ YAML::Node GameObject::Serialize()
     YAML::Node node;
     node["ID"] = id;
     node["Name"] = name;
+    if (!tags.empty())
+    {
+        node["Tags"] = tags;
+    }
 
     YAML::Node componentsNode;
     for (const auto &compPair : components)
@@ -84,6 +99,10 @@ void GameObject::Deserialize(const YAML::Node &node)
     {
         name = node["Name"].as<std::string>();
     }
+    if (node["Tags"])
+    {
+        tags = node["Tags"].as<std::vector<std::string>>();
+    }
     if (node["Components"])
     {
         YAML::Node componentsNode = node["Components"];
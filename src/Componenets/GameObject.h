@@ -4,6 +4,7 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 #include "Component.h"
 #include "Transform.h"
@@ -20,14 +21,27 @@ class GameObject
 public:
     int id;
     std::string name;
+
+    // Free-form labels for lookups (Engine.GetGameObjectByTag); edit through g_SceneIndex once the object is in the scene
+    std::vector<std::string> tags;
     std::unordered_map<std::string, std::shared_ptr<Component>> components;
 
     int GetComponentCount() const;
 
     GameObject(int id, const std::string &name);
+    ~GameObject();
+
+    // Handles are tied to the instance
+    GameObject(const GameObject &) = delete;
+    GameObject &operator=(const GameObject &) = delete;
+
+    // Generational handle scripts refer to this object by; invalid once the object is destroyed
+    EntityHandle GetHandle() const { return m_Handle; }
 
     std::string GetName() const;
 
+    bool HasTag(const std::string &tag) const;
+
     void AddComponent(const std::shared_ptr<Component> &component);
     std::shared_ptr<Component> GetComponentByName(const std::string &name) const;
 
@@ -47,4 +61,7 @@ public:
     // Serialization methods
     YAML::Node Serialize();
     void Deserialize(const YAML::Node &node);
+
+private:
+    EntityHandle m_Handle;
 };
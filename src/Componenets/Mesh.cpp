@@ -17,17 +17,28 @@ MeshComponent::MeshComponent()
 }
 
 MeshComponent::~MeshComponent()
+{
+    // The retention was this component's request; later loads of the model shouldn't inherit it
+    if (RetainCPUData)
+        g_AssetManager.RetainCPUMeshData(MeshPath, false);
+
+    ReleaseSubmeshes();
+}
+
+void MeshComponent::ReleaseSubmeshes()
 {
     for (auto &submesh : submeshes)
     {
         // Delete OpenGL buffers associated with the submesh
         if (submesh.vbo != 0)
         {
+            GPUMemory::Get().ReleaseBuffer(submesh.vbo);
             glDeleteBuffers(1, &submesh.vbo);
             submesh.vbo = 0;
         }
         if (submesh.ebo != 0)
         {
+            GPUMemory::Get().ReleaseBuffer(submesh.ebo);
             glDeleteBuffers(1, &submesh.ebo);
             submesh.ebo = 0;
         }
@@ -42,6 +53,7 @@ MeshComponent::~MeshComponent()
         {
             if (texture.id != 0)
             {
+                GPUMemory::Get().ReleaseTexture(texture.id);
                 glDeleteTextures(1, &texture.id);
             }
         }
@@ -92,7 +104,7 @@ YAML::Node MeshComponent::Serialize()
     {
         YAML::Node submeshNode;
         submeshNode["vao"] = static_cast<int>(submesh.vao);
-        submeshNode["indexCount"] = static_cast<int>(submesh.indices.size());
+        submeshNode["indexCount"] = static_cast<int>(submesh.indexCount);
 
         // Serialize Textures
         YAML::Node texturesNode;
@@ -109,6 +121,7 @@ YAML::Node MeshComponent::Serialize()
         submeshesNode.push_back(submeshNode);
     }
     node["MeshPath"] = MeshPath;
+    node["RetainCPUData"] = RetainCPUData;
     node["submeshes_len"] = submeshes.size();
     node["submeshes"] = submeshesNode;
 
@@ -122,10 +135,17 @@ void MeshComponent::Deserialize(const YAML::Node &node)
     {
         submeshes_len = node["submeshes_len"].as<int>();
     }
+    if (node["RetainCPUData"])
+    {
+        RetainCPUData = node["RetainCPUData"].as<bool>();
+    }
     if (node["MeshPath"])
     {
         MeshPath = node["MeshPath"].as<std::string>();
 
+        // Also clears a retention left over from an earlier scene
+        g_AssetManager.RetainCPUMeshData(MeshPath, RetainCPUData);
+
         DEBUG_PRINT("Loading Mesh: %s", MeshPath.c_str());
 
         std::shared_ptr<Model> model = g_AssetManager.loadAsset<Model>(AssetType::MODEL, MeshPath.c_str());
@@ -156,14 +176,14 @@ void MeshComponent::Deserialize(const YAML::Node &node)
             {
                 Submesh submesh;
 
-                if (submeshNode["vao"])
+                // GL names saved with the scene; meaningless without a context
+                if (submeshNode["vao"] && g_AssetManager.IsGPUUploadEnabled())
                 {
                     submesh.vao = submeshNode["vao"].as<int>();
                 }
                 if (submeshNode["indexCount"])
                 {
-                    submesh.indices.reserve(submeshNode["indexCount"].as<int>());
-                    // Assuming indices are stored elsewhere or need to be loaded
+                    submesh.indexCount = submeshNode["indexCount"].as<int>();
                 }
                 if (submeshNode["textures"])
                 {
@@ -171,7 +191,7 @@ void MeshComponent::Deserialize(const YAML::Node &node)
                     for (const auto &texNode : texturesNode)
                     {
                         Texture texture;
-                        texture.id = texNode["id"].as<int>();
+                        texture.id = g_AssetManager.IsGPUUploadEnabled() ? texNode["id"].as<int>() : 0;
                         texture.type = texNode["type"].as<std::string>();
                         texture.path = texNode["path"].as<std::string>();
                         submesh.textures.push_back(texture);
@@ -18,6 +18,12 @@ public:
     std::vector<Submesh> submeshes;    // List of submeshes
     std::string MeshPath;
 
+    // Keep CPU vertex/index copies after upload (picking, physics, re-export)
+    bool RetainCPUData = false;
+
+    // LOD picked last frame, used for hysteresis (not serialized)
+    int CurrentLOD = 0;
+
     static const std::string name;
 
 
@@ -25,6 +31,9 @@ public:
     MeshComponent();
     ~MeshComponent();
 
+    // Deletes the submeshes' GL buffers and textures and empties the list
+    void ReleaseSubmeshes();
+
     virtual const std::string& GetName() const override;
     static const std::string& GetStaticName();
 
@@ -39,6 +39,9 @@ YAML::Node ScriptComponent::Serialize()
     // ScriptPath
     node["ScriptPath"] = ScriptPath;
 
+    if (ThreadSafe)
+        node["ThreadSafe"] = true;
+
     return node;
 }
 
@@ -49,6 +52,8 @@ void ScriptComponent::Deserialize(const YAML::Node &node)
         ScriptPath = node["ScriptPath"].as<std::string>();
     }
 
+    ThreadSafe = node["ThreadSafe"] && node["ThreadSafe"].as<bool>();
+
     DEBUG_PRINT("Script Path: %s", ScriptPath.c_str());
 
     Initialize();
@@ -70,6 +75,7 @@ bool ScriptComponent::Initialize()
     }
 
     // Initialize LuaManager with the script path
+    m_LuaManager.SetThreadSafe(ThreadSafe);
     if (!m_LuaManager.Initialize(ScriptPath))
     {
         DEBUG_PRINT("ScriptComponent: Failed to initialize LuaManager");
@@ -81,14 +87,18 @@ bool ScriptComponent::Initialize()
 
 void ScriptComponent::Update(float deltaTime)
 {
+    // Thread-safe scripts are updated together by LuaManager::UpdateParallel
+    if (m_LuaManager.RunsInParallel())
+        return;
+
     // Call the Update method of LuaManager
     m_LuaManager.Update(deltaTime);
 }
 
 void ScriptComponent::Init()
 {
-    // Call the Update method of LuaManager
-    m_LuaManager.CallLuaFunction("OnInit");
+    // Call the script's OnInit
+    m_LuaManager.Init();
 }
 
 void ScriptComponent::UpdateVariable(const std::string &name, const LuaManager::LuaExposedVariant &value)
@@ -17,6 +17,9 @@ public:
 
     std::string ScriptPath; // Path to the Lua script
 
+    // Script may run OnUpdate on a worker thread (see LuaManager::SetThreadSafe); applies on Initialize
+    bool ThreadSafe = false;
+
     // Component interface implementation
     virtual const std::string &GetName() const override;
     static const std::string &GetStaticName();
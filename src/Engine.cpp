@@ -7,6 +7,9 @@
 #include "Engine.h"
 #include <cstdio>
 #include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <thread>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <string>
@@ -31,11 +34,18 @@
 
 #include "Engine/ThemeManager.h"
 #include "Engine/SceneManager.h"
+#include "Engine/SceneIndex.h"
 #include "Engine/LuaAPI.h"
+#include "Engine/LuaBytecodeCache.h"
 #include "Engine/Utilitys.h"
 
-#include "Engine/ScopedTimer.h"
 #include "Engine/Profiler.h"
+#include "Engine/FrameStats.h"
+#include "Engine/MemoryTracker.h"
+#include "Rendering/GPUProfiler.h"
+#include "Rendering/SoftwareRasterizer.h"
+#include "Componenets/CameraComponent.h"
+#include <glm/gtc/matrix_transform.hpp>
 
 // #define YAML_CPP_STATIC_DEFINE
 #include <yaml-cpp/yaml.h>
@@ -48,6 +58,8 @@ LoggerWindow *g_LoggerWindow;
 
 SceneManager g_SceneManager;
 
+SceneIndex g_SceneIndex;
+
 std::vector<std::shared_ptr<GameObject>> g_GameObjects;
 
 std::shared_ptr<CameraComponent> g_RuntimeCameraObject;
@@ -95,10 +107,19 @@ bool MyEngine::Init(int width, int height, const std::string &title)
         return false;
     }
 
+    // GPU timer queries, if the driver has them
+    GPUProfiler::Get().Initialize();
+
     // ------------------------------------------
     // 3) Initialize ImGui
     // ------------------------------------------
     IMGUI_CHECKVERSION();
+
+    // ImGui's own heap is charged to the editor
+    ImGui::SetAllocatorFunctions([](size_t size, void *)
+                                 { return MemoryTracker::Allocate(size, MemoryTag::Editor); },
+                                 [](void *ptr, void *)
+                                 { MemoryTracker::Free(ptr); });
     ImGui::CreateContext();
     ImGuiIO &io = ImGui::GetIO();
     (void)io;
@@ -161,6 +182,7 @@ bool MyEngine::Init(int width, int height, const std::string &title)
     m_SceneWindow = std::make_unique<SceneWindow>();
     m_luaEditor = std::make_unique<LuaEditorWindow>();
     m_profilerWindow = std::make_unique<ProfilerWindow>();
+    m_MemoryWindow = std::make_unique<MemoryWindow>();
 
     m_GameRunning = false;
     m_FirstTickGameRunning = true;
@@ -198,7 +220,7 @@ void MyEngine::Run()
 
         // Poll events
         {
-            ScopedTimer timer("glfwPollEvents");
+            PROFILE_ZONE("glfwPollEvents");
             glfwPollEvents();
         }
 
@@ -217,7 +239,7 @@ void MyEngine::Run()
         if (m_TimeAccumulator >= 0.1)
         {
             m_Fps = static_cast<float>(m_FrameCount / m_TimeAccumulator);
-            m_Ms = 100.0f / m_Fps; // Assuming m_Ms represents milliseconds per frame
+            m_Ms = 1000.0f / m_Fps; // Milliseconds per frame
 
             // Reset counters
             m_FrameCount = 0;
@@ -230,14 +252,14 @@ void MyEngine::Run()
         if (m_FirstTickGameRunning && m_GameRunning)
         {
 
-            ScopedTimer timer("SaveScene");
+            PROFILE_ZONE("SaveScene");
             m_FirstTickGameRunning = false;
 
             std::string savePath = createTempFolder().string() + "/TesseractEngineTempScene.scene";
             DEBUG_PRINT("Save path: %s", savePath.c_str());
             g_SceneManager.SaveScene(g_GameObjects, savePath);
 
-            ScopedTimer LUA_INIT_timer("GameObjectsScriptInit");
+            PROFILE_ZONE("GameObjectsScriptInit");
             for (auto &Gameobject : g_GameObjects)
             {
 
@@ -245,7 +267,7 @@ void MyEngine::Run()
                 std::shared_ptr<ScriptComponent> script = Gameobject->GetComponent<ScriptComponent>();
                 if (script)
                 {                                                                         // Null Checks
-                    ScopedTimer Lua_timer("GameObjectLuaCall_INIT: " + Gameobject->name); // var has to be named that or it will be redecl
+                    PROFILE_ZONE("GameObjectLuaCall_INIT");
 
                     script->Init();
                 }
@@ -254,7 +276,7 @@ void MyEngine::Run()
 
         if (!m_FirstTickGameRunning && !m_GameRunning)
         {
-            ScopedTimer timer("LoadScene");
+            PROFILE_ZONE("LoadScene");
             m_FirstTickGameRunning = true;
 
             std::string loadPath = createTempFolder().string() + "/TesseractEngineTempScene.scene";
@@ -269,22 +291,32 @@ void MyEngine::Run()
 
         if (m_GameRunning)
         {
-            ScopedTimer timer("UpdateGameObjects");
+            PROFILE_ZONE("UpdateGameObjects");
             for (auto &Gameobject : g_GameObjects)
             {
 
                 Gameobject->Update(frame_delta);
             }
+
+            // Thread-safe scripts run concurrently; their transform writes land after all of them finished
+            {
+                PROFILE_ZONE("LuaUpdateParallel");
+                LuaManager::UpdateParallel(static_cast<float>(frame_delta));
+            }
+
+            // Scripts in the shared Lua state run from one loop inside the VM
+            PROFILE_ZONE("LuaUpdateAll");
+            LuaManager::UpdateAll(static_cast<float>(frame_delta));
         }
 
         // Render and show various windows
         {
-            ScopedTimer timer("RenderGame");
+            PROFILE_ZONE("RenderGame");
 
             m_RenderWindow->Show(&m_GameRunning); // The spinning triangle as ImGui::Image
         }
         {
-            ScopedTimer timer("ShowEditor");
+            PROFILE_ZONE("ShowEditor");
 
             m_InspectorWindow->Show();
             m_PerformanceWindow->Show(m_Fps, m_Ms); // FPS & ms
@@ -296,25 +328,282 @@ void MyEngine::Run()
             {
                 m_profilerWindow->Show();
             }
+
+            if (m_showMemory)
+            {
+                m_MemoryWindow->Show();
+            }
         }
 
         // After rendering
         m_PerformanceWindow->UpdatePerformanceStats(-1, g_GPU_Triangles_drawn_to_screen);
 
+        // Lua collection runs here, in whatever the frame has left, instead of inside script updates
+        LuaManager::CollectGarbage(LuaManager::ComputeGCBudget((glfwGetTime() - current_time) * 1000.0));
+
         // End frame
         EndFrame();
 
         // Mark the end of frame for profiling
+        bool capturingTrace = Profiler::Get().IsCapturing();
         Profiler::Get().EndFrame();
+
+        // Right after the profiler, so a hitch keeps this frame's call tree
+        FrameStats::Get().EndFrame();
+
+        MemoryTracker::Get().EndFrame();
+
+        if (capturingTrace && !Profiler::Get().IsCapturing())
+        {
+            const Profiler &profiler = Profiler::Get();
+            if (profiler.GetLastCaptureSucceeded())
+                m_LoggerWindow->AddLog("[Profiler] Trace written to %s (%zu events)", profiler.GetLastCapturePath().c_str(), profiler.GetLastCaptureEventCount());
+            else
+                m_LoggerWindow->AddLog("[Profiler] Failed to write trace %s", ImVec4(1.0f, 0.3f, 0.3f, 1.0f), profiler.GetLastCapturePath().c_str());
+        }
     }
 
     DEBUG_PRINT("[OK] Engine Run ");
 }
 
+// Set from the SIGINT handler so a headless run ends with its summary
+static volatile std::sig_atomic_t s_HeadlessStopRequested = 0;
+
+static void HandleHeadlessInterrupt(int)
+{
+    s_HeadlessStopRequested = 1;
+}
+
+bool MyEngine::InitHeadless(const HeadlessOptions &options)
+{
+    DEBUG_PRINT("[START] Engine Init (headless)");
+
+    m_Headless = true;
+    m_HeadlessOptions = options;
+
+    m_LoggerWindow = std::make_unique<LoggerWindow>();
+    m_LoggerWindow->SetConsoleOutput(true);
+    g_LoggerWindow = m_LoggerWindow.get();
+
+    // No GL context: models are parsed and kept CPU-side, textures and shaders are skipped
+    g_AssetManager.SetGPUUploadEnabled(false);
+
+    if (options.TickRate <= 0.0)
+    {
+        fprintf(stderr, "[Engine] Tick rate must be positive\n");
+        return false;
+    }
+    if (!options.CapturePath.empty() && (options.CaptureWidth <= 0 || options.CaptureHeight <= 0))
+    {
+        fprintf(stderr, "[Engine] Capture size must be positive\n");
+        return false;
+    }
+    if (!std::filesystem::is_regular_file(options.ScenePath))
+    {
+        fprintf(stderr, "[Engine] Scene not found: %s\n", options.ScenePath.c_str());
+        return false;
+    }
+
+    auto loadStart = std::chrono::steady_clock::now();
+    g_SceneManager.LoadScene(g_GameObjects, options.ScenePath);
+    double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+    m_LoggerWindow->AddLog("[Headless] Loaded %s: %zu objects in %.2f ms", options.ScenePath.c_str(), g_GameObjects.size(), loadMs);
+
+    // Same as pressing Start in the editor
+    for (auto &Gameobject : g_GameObjects)
+    {
+        std::shared_ptr<ScriptComponent> script = Gameobject->GetComponent<ScriptComponent>();
+        if (script)
+        {
+            script->Init();
+        }
+    }
+
+    m_Running = true;
+    m_GameRunning = true;
+    DEBUG_PRINT("[OK] Engine Init (headless)");
+    return true;
+}
+
+void MyEngine::RunHeadless()
+{
+    DEBUG_PRINT("[START] Engine Run (headless)");
+
+    const HeadlessOptions &options = m_HeadlessOptions;
+    const float deltaTime = static_cast<float>(1.0 / options.TickRate);
+    const auto tickInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / options.TickRate));
+
+    if (options.Uncapped)
+        m_LoggerWindow->AddLog("[Headless] Ticking uncapped (dt %.4f s)", deltaTime);
+    else
+        m_LoggerWindow->AddLog("[Headless] Ticking at %.1f Hz (dt %.4f s)", options.TickRate, deltaTime);
+
+    s_HeadlessStopRequested = 0;
+    std::signal(SIGINT, HandleHeadlessInterrupt);
+
+    // Tick times, not wall frame times: sleeping in fixed mode would hide the work
+    FrameStats::Get().Reset();
+
+    auto start = std::chrono::steady_clock::now();
+    auto nextTick = start;
+    auto lastStats = start;
+    long long ticks = 0;
+    long long ticksAtLastStats = 0;
+
+    while (m_Running && !s_HeadlessStopRequested)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (options.MaxTicks > 0 && ticks >= options.MaxTicks)
+            break;
+        if (options.MaxSeconds > 0.0 && std::chrono::duration<double>(now - start).count() >= options.MaxSeconds)
+            break;
+
+        auto tickStart = now;
+        {
+            PROFILE_ZONE("UpdateGameObjects");
+            for (auto &Gameobject : g_GameObjects)
+            {
+                Gameobject->Update(deltaTime);
+            }
+        }
+        {
+            PROFILE_ZONE("LuaUpdateParallel");
+            LuaManager::UpdateParallel(deltaTime);
+        }
+        {
+            PROFILE_ZONE("LuaUpdateAll");
+            LuaManager::UpdateAll(deltaTime);
+        }
+
+        double workMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tickStart).count();
+        LuaManager::CollectGarbage(LuaManager::ComputeGCBudget(workMs));
+        double tickMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tickStart).count();
+        ticks++;
+
+        bool capturingTrace = Profiler::Get().IsCapturing();
+        Profiler::Get().EndFrame();
+
+        // After the profiler, so a hitch keeps this tick's call tree
+        FrameStats::Get().AddFrame(tickMs);
+        MemoryTracker::Get().EndFrame();
+
+        if (capturingTrace && !Profiler::Get().IsCapturing())
+        {
+            const Profiler &profiler = Profiler::Get();
+            if (profiler.GetLastCaptureSucceeded())
+                m_LoggerWindow->AddLog("[Profiler] Trace written to %s (%zu events)", profiler.GetLastCapturePath().c_str(), profiler.GetLastCaptureEventCount());
+            else
+                m_LoggerWindow->AddLog("[Profiler] Failed to write trace %s", profiler.GetLastCapturePath().c_str());
+        }
+
+        now = std::chrono::steady_clock::now();
+        double sinceStats = std::chrono::duration<double>(now - lastStats).count();
+        if (options.StatsInterval > 0.0 && sinceStats >= options.StatsInterval)
+        {
+            FrameTimeSummary window = FrameStats::Get().ComputeWindow(static_cast<size_t>(ticks - ticksAtLastStats));
+            m_LoggerWindow->AddLog("[Headless] tick %lld: %.1f ticks/s, tick avg %.3f ms, p99 %.3f ms, max %.3f ms, heap %.1f MB",
+                                   ticks, (ticks - ticksAtLastStats) / sinceStats, window.AverageMs, window.P99Ms, window.MaxMs,
+                                   MemoryTracker::Get().GetTotalBytes() / (1024.0 * 1024.0));
+            lastStats = now;
+            ticksAtLastStats = ticks;
+        }
+
+        // Fixed rate: wait for the next slot, but don't try to catch up after a long tick
+        if (!options.Uncapped)
+        {
+            nextTick += tickInterval;
+            if (nextTick < now)
+                nextTick = now;
+            else
+                std::this_thread::sleep_until(nextTick);
+        }
+    }
+
+    std::signal(SIGINT, SIG_DFL);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    FrameTimeSummary session = FrameStats::Get().ComputeSession();
+    m_LoggerWindow->AddLog("[Headless] %lld ticks (%.1f s simulated) in %.2f s: %.1f ticks/s",
+                           ticks, ticks * static_cast<double>(deltaTime), seconds, seconds > 0.0 ? ticks / seconds : 0.0);
+    m_LoggerWindow->AddLog("[Headless] Tick time avg %.3f ms, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms, %llu over %.0f ms",
+                           session.AverageMs, session.P50Ms, session.P95Ms, session.P99Ms, session.MaxMs,
+                           static_cast<unsigned long long>(FrameStats::Get().GetHitchCount()), FrameStats::Get().GetHitchThresholdMs());
+
+    if (!options.CapturePath.empty())
+        CaptureHeadlessFrame();
+
+    DEBUG_PRINT("[OK] Engine Run (headless)");
+}
+
+void MyEngine::CaptureHeadlessFrame()
+{
+    const HeadlessOptions &options = m_HeadlessOptions;
+
+    // The scene's default runtime camera, else its first camera, else the editor's fallback view
+    std::shared_ptr<CameraComponent> camera;
+    for (auto &Gameobject : g_GameObjects)
+    {
+        std::shared_ptr<CameraComponent> candidate = Gameobject->GetComponent<CameraComponent>();
+        if (!candidate)
+            continue;
+        if (!camera || (candidate->DefaultRuntimeCamera && !camera->DefaultRuntimeCamera))
+            camera = candidate;
+    }
+
+    glm::mat4 view;
+    glm::mat4 proj;
+    if (camera)
+    {
+        view = camera->GetViewMatrix();
+        proj = camera->GetProjectionMatrix();
+    }
+    else
+    {
+        view = glm::translate(glm::mat4(1.f), glm::vec3(0.f, 0.f, -5.f));
+        proj = glm::perspective(glm::radians(45.0f), (float)options.CaptureWidth / (float)options.CaptureHeight, 0.1f, 2048.0f);
+    }
+
+    SoftwareRasterizer rasterizer;
+    rasterizer.Init();
+    rasterizer.Resize(options.CaptureWidth, options.CaptureHeight);
+
+    auto start = std::chrono::steady_clock::now();
+    rasterizer.RenderScene(g_GameObjects, view, proj);
+    double renderMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    const RenderFrameStats &stats = rasterizer.GetFrameStats();
+    if (rasterizer.SavePNG(options.CapturePath))
+    {
+        m_LoggerWindow->AddLog("[Headless] Captured %dx%d frame to %s in %.2f ms (%d submeshes, %d triangles, %d skipped)",
+                               options.CaptureWidth, options.CaptureHeight, options.CapturePath.c_str(), renderMs,
+                               stats.Submeshes, stats.Triangles, stats.SkippedSubmeshes);
+    }
+    else
+    {
+        m_LoggerWindow->AddLog("[Headless] Failed to write capture %s", ImVec4(1.0f, 0.0f, 0.0f, 1.0f), options.CapturePath.c_str());
+    }
+}
+
 void MyEngine::Cleanup()
 {
     DEBUG_PRINT("[START] Engine Cleanup ");
 
+    if (m_Headless)
+    {
+        // Scripts go before the shared Lua state they may live in
+        g_SceneIndex.Clear();
+        g_GameObjects.clear();
+        LuaManager::ShutdownSharedState();
+
+        fflush(stdout);
+        m_Running = false;
+        DEBUG_PRINT("[OK] Engine Cleanup ");
+        return;
+    }
+
+    // Queries belong to the GL context
+    GPUProfiler::Get().Shutdown();
+
     // ImGui cleanup
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
@@ -334,6 +623,8 @@ void MyEngine::Cleanup()
 
 void MyEngine::BeginFrame()
 {
+    PROFILE_ZONE("BeginFrame");
+
     // ImGui new frame
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
@@ -342,6 +633,8 @@ void MyEngine::BeginFrame()
 
 void MyEngine::EndFrame()
 {
+    PROFILE_ZONE("EndFrame");
+
     // Render ImGui
     ImGui::Render();
 
@@ -353,7 +646,11 @@ void MyEngine::EndFrame()
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     // Draw the ImGui data
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    {
+        PROFILE_ZONE("ImGuiRenderDrawData");
+        GPU_PROFILE_ZONE("ImGuiRenderDrawData");
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    }
 
     // (Optional) handle multi-viewport
     ImGuiIO &io = ImGui::GetIO();
@@ -365,7 +662,11 @@ void MyEngine::EndFrame()
         glfwMakeContextCurrent(backup_current_context);
     }
 
+    // Reads back GPU zones of an earlier frame, if they're done
+    GPUProfiler::Get().EndFrame();
+
     // Swap
+    PROFILE_ZONE("SwapBuffers");
     glfwSwapBuffers(m_Window);
 }
 
@@ -419,6 +720,64 @@ void MyEngine::ShowDockSpace()
         if (ImGui::BeginMenu("Tools"))
         {
             ImGui::Checkbox("Show Profiler", &m_showProfiler); // Add a checkbox to toggle the profiler
+            ImGui::Checkbox("Show Memory", &m_showMemory);
+
+            // Chrome trace / Perfetto JSON of the next frames, from all threads
+            if (ImGui::MenuItem("Capture Trace (300 frames)", nullptr, false, !Profiler::Get().IsCapturing()))
+            {
+                std::string tracePath = Profiler::DefaultCapturePath();
+                if (Profiler::Get().BeginCapture(300, tracePath))
+                    m_LoggerWindow->AddLog("[Profiler] Capturing 300 frames to %s", tracePath.c_str());
+            }
+
+            ImGui::Separator();
+
+            // Applies to scripts initialized afterwards
+            bool sharedLuaState = LuaManager::IsSharedStateEnabled();
+            if (ImGui::Checkbox("Shared Lua VM", &sharedLuaState))
+            {
+                LuaManager::SetSharedStateEnabled(sharedLuaState);
+            }
+
+            // Thread-safe scripts run OnUpdate on the job system
+            bool parallelScripts = LuaManager::IsParallelUpdatesEnabled();
+            if (ImGui::Checkbox("Parallel Lua Scripts", &parallelScripts))
+            {
+                LuaManager::SetParallelUpdatesEnabled(parallelScripts);
+            }
+
+            bool bytecodeCache = LuaBytecodeCache::Get().IsEnabled();
+            if (ImGui::Checkbox("Lua Bytecode Cache", &bytecodeCache))
+            {
+                LuaBytecodeCache::Get().SetEnabled(bytecodeCache);
+            }
+
+            if (ImGui::MenuItem("Clear Lua Bytecode Cache"))
+            {
+                LuaBytecodeCacheStats stats = LuaBytecodeCache::Get().GetStats();
+                m_LoggerWindow->AddLog("[LuaBytecodeCache] %d memory hits, %d disk hits, %d compiles (%.2f ms), %d invalidated, %.1f KB cached",
+                                       stats.MemoryHits, stats.DiskHits, stats.Compiles, stats.CompileMs,
+                                       stats.Invalidations, stats.MemoryBytes / 1024.0);
+                LuaBytecodeCache::Get().Clear(true);
+            }
+
+            if (ImGui::MenuItem("Benchmark Lua Init (1000 scripts)"))
+            {
+                const std::string benchmarkScript = "assets/scripts/BouncingItem.lua";
+                for (bool shared : {false, true})
+                {
+                    LuaInitBenchmark result = LuaManager::BenchmarkInitialization(benchmarkScript, 1000, shared);
+                    m_LoggerWindow->AddLog("[LuaBenchmark] %s: %d scripts in %.2f ms (%.1f us/script), %.2f MB Lua heap (%.1f KB/script), %d failed",
+                                           result.Shared ? "Shared VM" : "VM per script",
+                                           result.Scripts, result.TotalMs, result.PerScriptUs,
+                                           result.TotalBytes / (1024.0 * 1024.0), result.BytesPerScript / 1024.0,
+                                           result.Failures);
+                    if (result.Shared)
+                    {
+                        m_LoggerWindow->AddLog("[LuaBenchmark] Shared VM base heap: %.1f KB", result.SharedBaseBytes / 1024.0);
+                    }
+                }
+            }
             ImGui::EndMenu();
         }
         if (ImGui::BeginMenu("Engine"))
@@ -11,6 +11,7 @@
 #include "Windows/SceneWindow.h"
 #include "Windows/LuaEditorWindow.h"
 #include "Windows/ProfilerWindow.h"
+#include "Windows/MemoryWindow.h"
 
 #include "Componenets/GameObject.h"
 #include "Componenets/Mesh.h"
@@ -29,6 +30,20 @@
 // Forward declaration to avoid including GLFW in the header if you prefer
 struct GLFWwindow;
 
+// Settings for MyEngine::InitHeadless
+struct HeadlessOptions
+{
+    std::string ScenePath;
+    double TickRate = 60.0;      // Ticks per second; every tick advances the game by 1 / TickRate
+    bool Uncapped = false;       // Tick as fast as possible instead of holding TickRate in real time
+    long long MaxTicks = 0;      // Stop after this many ticks; 0 = no limit
+    double MaxSeconds = 0.0;     // Stop after this much wall time; 0 = no limit
+    double StatsInterval = 5.0;  // Seconds between status lines; 0 = only the summary at the end
+    std::string CapturePath;     // PNG of the final state from the software rasterizer; empty = no capture
+    int CaptureWidth = 1280;
+    int CaptureHeight = 720;
+};
+
 // The main engine class that owns the application loop
 class MyEngine
 {
@@ -37,19 +52,36 @@ public:
     void Run();
     void Cleanup();
 
+    /**
+     * @brief Simulation without a window: no GLFW, GL context or ImGui.
+     *
+     * Loads the scene with assets kept CPU-side, starts its scripts and logs
+     * to stdout. RunHeadless then ticks GameObject::Update and the Lua
+     * scripts until a tick/time limit is hit or SIGINT arrives, and prints
+     * tick time percentiles. Cleanup works for both modes.
+     */
+    bool InitHeadless(const HeadlessOptions &options);
+    void RunHeadless();
+
 private:
     // Internal helpers
     void BeginFrame();
     void EndFrame();
     void ShowDockSpace();
 
+    // Renders the scene with the software rasterizer and writes HeadlessOptions::CapturePath
+    void CaptureHeadlessFrame();
+
 private:
     GLFWwindow *m_Window = nullptr;
     bool m_Running = false;
+    bool m_Headless = false;
+    HeadlessOptions m_HeadlessOptions;
     bool m_GameRunning = false;
 
     bool m_FirstTickGameRunning = true;
     bool m_showProfiler = true;
+    bool m_showMemory = false;
 
     // Windows
     std::unique_ptr<RenderWindow> m_RenderWindow;
@@ -60,6 +92,7 @@ private:
     std::unique_ptr<LuaEditorWindow> m_luaEditor;
 
     std::unique_ptr<ProfilerWindow> m_profilerWindow;
+    std::unique_ptr<MemoryWindow> m_MemoryWindow;
 
     double m_LastFrameTime = 0.0; // Initialize with the current time
     double m_TimeAccumulator = 0.0;
@@ -11,6 +11,12 @@
 #include <filesystem>
 #include <variant>
 
+#include "Engine/MemoryTracker.h"
+
+// Decoded pixels are charged to Textures until stbi_image_free
+#define STBI_MALLOC(size) MemoryTracker::Allocate(size, MemoryTag::Textures)
+#define STBI_REALLOC(ptr, size) MemoryTracker::Reallocate(ptr, size, MemoryTag::Textures)
+#define STBI_FREE(ptr) MemoryTracker::Free(ptr)
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
 
@@ -19,6 +25,8 @@
 
 #include "Windows/LoggerWindow.h"
 #include "Rendering/Shader.h"
+#include "Engine/MeshOptimizer.h"
+#include "Engine/MeshSimplifier.h"
 
 GLuint LoadTextureFromList(const std::string &path);
 Shader *LoadShaderFromList(const std::string &path);
@@ -27,6 +35,7 @@ Model *LoadModelFromList(const std::string &path);
 int LoadedAssets = 0;
 
 extern LoggerWindow *g_LoggerWindow;
+extern AssetManager g_AssetManager;
 
 std::string getDirectoryPath(const std::string &fullPath)
 {
@@ -52,9 +61,10 @@ void AssetManager::DebugAssetMap()
 
 AssetManager::AssetVariant AssetManager::loadAssetFromDisk(AssetType type, const std::string &path)
 {
+    MemoryTagScope memoryTag(MemoryTag::Assets);
+
     // DebugAssetMap();
     g_LoggerWindow->AddLog("[AssetManager] Loading asset: %s", path.c_str());
-    LoadedAssets = m_AssetMap.size();
     switch (type)
     {
     case AssetType::TEXTURE:
@@ -114,6 +124,11 @@ GLuint LoadTextureFromList(const std::string &path)
     {
         return 0;
     }
+    if (!g_AssetManager.IsGPUUploadEnabled())
+    {
+        stbi_image_free(data);
+        return 0;
+    }
 
     GLenum format = GL_RGBA;
     if (channels == 1)
@@ -129,6 +144,7 @@ GLuint LoadTextureFromList(const std::string &path)
     glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0,
                  format, GL_UNSIGNED_BYTE, data);
     glGenerateMipmap(GL_TEXTURE_2D);
+    GPUMemory::Get().RecordTexture(texID, GPUMemoryCategory::Texture, GPUMemory::TextureBytes(width, height, channels, true), path);
 
     // Set texture params
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -146,6 +162,11 @@ GLuint LoadTextureFromList(const std::string &path)
 
 Shader *LoadShaderFromList(const std::string &path)
 {
+    // Compiling needs a GL context
+    if (!g_AssetManager.IsGPUUploadEnabled())
+    {
+        return nullptr;
+    }
 
     // Build actual paths from the base path
     std::string vertPath = path + ".vert";
@@ -165,23 +186,37 @@ Shader *LoadShaderFromList(const std::string &path)
     return newShader;
 }
 
-GLuint LoadTexture(const std::string &path, const std::string &directory)
+// Decodes an image referenced by a model; no GL, so it may run on any thread
+static DecodedTexture DecodeTexture(const std::string &type, const std::string &path, const std::string &directory)
 {
-    std::string fullPath = directory + path;
-    int width, height, channels;
-    unsigned char *data = stbi_load(fullPath.c_str(), &width, &height, &channels, 0);
+    DecodedTexture texture;
+    texture.type = type;
+    texture.path = path;
+    texture.fullPath = directory + path;
+
+    unsigned char *data = stbi_load(texture.fullPath.c_str(), &texture.width, &texture.height, &texture.channels, 0);
     if (!data)
     {
-        DEBUG_PRINT("[AssetManager] failed to load texture: %s: %s", fullPath.c_str(), stbi_failure_reason());
-        return 0;
+        DEBUG_PRINT("[AssetManager] failed to load texture: %s: %s", texture.fullPath.c_str(), stbi_failure_reason());
+        return texture;
     }
+    texture.pixels.assign(data, data + static_cast<size_t>(texture.width) * texture.height * texture.channels);
+    stbi_image_free(data);
+    return texture;
+}
+
+// Uploads a decoded image with mipmaps; 0 if it failed to decode or uploads are disabled
+static GLuint UploadTexture(const DecodedTexture &texture)
+{
+    if (texture.pixels.empty() || !g_AssetManager.IsGPUUploadEnabled())
+        return 0;
 
     GLenum format;
-    if (channels == 1)
+    if (texture.channels == 1)
         format = GL_RED;
-    else if (channels == 3)
+    else if (texture.channels == 3)
         format = GL_RGB;
-    else if (channels == 4)
+    else if (texture.channels == 4)
         format = GL_RGBA;
     else
         format = GL_RGB; // Default fallback
@@ -190,9 +225,11 @@ GLuint LoadTexture(const std::string &path, const std::string &directory)
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0,
-                 format, GL_UNSIGNED_BYTE, data);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, texture.width, texture.height, 0,
+                 format, GL_UNSIGNED_BYTE, texture.pixels.data());
     glGenerateMipmap(GL_TEXTURE_2D);
+    GPUMemory::Get().RecordTexture(textureID, GPUMemoryCategory::Texture,
+                                   GPUMemory::TextureBytes(texture.width, texture.height, texture.channels, true), texture.fullPath);
 
     // Set texture parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -201,7 +238,6 @@ GLuint LoadTexture(const std::string &path, const std::string &directory)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     glBindTexture(GL_TEXTURE_2D, 0);
-    stbi_image_free(data);
 
     return textureID;
 }
@@ -225,10 +261,18 @@ struct VertexHash
     }
 };
 
-// Hash map for deduplication
-std::unordered_map<Vertex, unsigned int, VertexHash> vertexCache;
+// Hash map for deduplication (one per submesh, indices are local to each submesh)
+using VertexCache = std::unordered_map<Vertex, unsigned int, VertexHash>;
 
 Model *LoadModelFromList(const std::string &path)
+{
+    std::unique_ptr<ParsedModel> parsed = ParseModel(path, g_AssetManager.GetModelParseOptions());
+    if (!parsed)
+        return nullptr;
+    return UploadModel(*parsed);
+}
+
+std::unique_ptr<ParsedModel> ParseModel(const std::string &path, const ModelParseOptions &options)
 {
     auto start = std::chrono::high_resolution_clock::now();
 
@@ -257,6 +301,7 @@ Model *LoadModelFromList(const std::string &path)
 
     // Map material name to Submesh
     std::unordered_map<std::string, Submesh> materialToSubmesh;
+    std::unordered_map<std::string, VertexCache> materialToVertexCache;
     materialToSubmesh[currentMaterial] = Submesh();
 
     std::string line;
@@ -350,6 +395,7 @@ Model *LoadModelFromList(const std::string &path)
             {
                 // Current material's submesh
                 Submesh &currentSubmesh = materialToSubmesh[currentMaterial];
+                VertexCache &vertexCache = materialToVertexCache[currentMaterial];
 
                 auto addVertex = [&](unsigned int v, unsigned int t, unsigned int n) -> unsigned int
                 {
@@ -416,7 +462,7 @@ Model *LoadModelFromList(const std::string &path)
     DEBUG_PRINT("MTL READ");
 
     // Load MTL file if specified
-    std::unordered_map<std::string, std::vector<Texture>> materialTexturesMap;
+    std::unordered_map<std::string, std::vector<DecodedTexture>> materialTexturesMap;
     if (!mtlFileName.empty())
     {
         std::ifstream mtlFile(directory + mtlFileName);
@@ -442,51 +488,21 @@ Model *LoadModelFromList(const std::string &path)
                     std::string texturePath;
                     mtlIss >> texturePath;
                     if (!texturePath.empty())
-                    {
-                        GLuint texID = LoadTexture(texturePath, directory);
-                        if (texID != 0)
-                        {
-                            Texture texture;
-                            texture.id = texID;
-                            texture.type = "texture_diffuse";
-                            texture.path = texturePath;
-                            materialTexturesMap[currentMaterialName].push_back(texture);
-                        }
-                    }
+                        materialTexturesMap[currentMaterialName].push_back(DecodeTexture("texture_diffuse", texturePath, directory));
                 }
                 else if (mtlPrefix == "map_Ks")
                 {
                     std::string texturePath;
                     mtlIss >> texturePath;
                     if (!texturePath.empty())
-                    {
-                        GLuint texID = LoadTexture(texturePath, directory);
-                        if (texID != 0)
-                        {
-                            Texture texture;
-                            texture.id = texID;
-                            texture.type = "texture_specular";
-                            texture.path = texturePath;
-                            materialTexturesMap[currentMaterialName].push_back(texture);
-                        }
-                    }
+                        materialTexturesMap[currentMaterialName].push_back(DecodeTexture("texture_specular", texturePath, directory));
                 }
                 else if (mtlPrefix == "map_Bump" || mtlPrefix == "map_bump" || mtlPrefix == "bump")
                 {
                     std::string texturePath;
                     mtlIss >> texturePath;
                     if (!texturePath.empty())
-                    {
-                        GLuint texID = LoadTexture(texturePath, directory);
-                        if (texID != 0)
-                        {
-                            Texture texture;
-                            texture.id = texID;
-                            texture.type = "texture_normal";
-                            texture.path = texturePath;
-                            materialTexturesMap[currentMaterialName].push_back(texture);
-                        }
-                    }
+                        materialTexturesMap[currentMaterialName].push_back(DecodeTexture("texture_normal", texturePath, directory));
                 }
                 // Add more texture types as needed
             }
@@ -503,46 +519,168 @@ Model *LoadModelFromList(const std::string &path)
 
     DEBUG_PRINT("MTL SUBASSIGN");
 
-    // Assign textures to submeshes based on their material
+    if (materialToSubmesh.empty())
+    {
+        return nullptr;
+    }
+
+    auto parsed = std::make_unique<ParsedModel>();
+    parsed->path = path;
+
+    // Prepare each material's submesh; everything up to the GL upload
     for (auto &pair : materialToSubmesh)
     {
         const std::string &materialName = pair.first;
         Submesh &submesh = pair.second;
 
-        if (materialTexturesMap.find(materialName) != materialTexturesMap.end())
+        // Reorder indices/vertices for the post-transform cache before uploading
+        if (!submesh.indices.empty())
         {
-            submesh.textures = materialTexturesMap[materialName];
+            MeshOptimizeReport report = MeshOptimizer::OptimizeSubmesh(submesh);
+            g_LoggerWindow->AddLog("[MeshOptimizer] %s (%s): %zu tris, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (%.2f ms)",
+                                   path.c_str(), materialName.c_str(), report.TriangleCount,
+                                   report.Before.ACMR, report.After.ACMR,
+                                   report.Before.ATVR, report.After.ATVR,
+                                   report.Milliseconds);
         }
-        else
+
+        // Meshlets over the final LOD 0 order; tiny submeshes gain nothing from per-cluster culling
+        if (options.buildMeshlets && submesh.indices.size() / 3 > 2 * MeshletBuilder::MaxTriangles)
         {
-            // If no material textures found, you can assign default textures or leave it empty
+            submesh.meshlets = MeshletBuilder::Build(submesh.vertices, submesh.indices);
+            submesh.closed = MeshletBuilder::IsClosed(submesh.vertices, submesh.indices);
+            g_LoggerWindow->AddLog("[Meshlet] %s (%s): %zu meshlets, %s",
+                                   path.c_str(), materialName.c_str(), submesh.meshlets.size(),
+                                   submesh.closed ? "closed" : "open (cone culling off)");
         }
 
-        // Initialize OpenGL buffers for the submesh
-        submesh.Initialize();
-    }
+        // Simplified index buffers sharing the optimized vertex buffer
+        if (options.generateLODs && !submesh.indices.empty())
+        {
+            auto lodStart = std::chrono::high_resolution_clock::now();
+            std::vector<SimplifiedLOD> simplified = MeshSimplifier::GenerateLODs(submesh.vertices, submesh.indices, {0.5f, 0.25f, 0.125f});
+            auto lodEnd = std::chrono::high_resolution_clock::now();
 
-    if (materialToSubmesh.empty())
-    {
-        return nullptr;
+            std::string lodTriangles = std::to_string(submesh.indices.size() / 3);
+            float maxError = 0.0f;
+            for (SimplifiedLOD &lod : simplified)
+            {
+                lodTriangles += " / " + std::to_string(lod.indices.size() / 3);
+                maxError = std::max(maxError, lod.error);
+                submesh.lodIndices.push_back(std::move(lod.indices));
+            }
+            g_LoggerWindow->AddLog("[MeshSimplifier] %s (%s): LOD tris %s, max error %.4g (%.2f ms)",
+                                   path.c_str(), materialName.c_str(), lodTriangles.c_str(), maxError,
+                                   std::chrono::duration<double, std::milli>(lodEnd - lodStart).count());
+        }
+
+        ParsedSubmesh entry;
+        entry.material = materialName;
+        entry.submesh = std::move(submesh);
+        auto textures = materialTexturesMap.find(materialName);
+        if (textures != materialTexturesMap.end())
+            entry.textures = std::move(textures->second);
+        parsed->submeshes.push_back(std::move(entry));
     }
 
+    auto end = std::chrono::high_resolution_clock::now();
+    parsed->parseSeconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+    return parsed;
+}
+
+Model *UploadModel(ParsedModel &parsed)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    const std::string &path = parsed.path;
+
+    VertexLayout vertexLayout = g_AssetManager.GetVertexLayout();
+    bool uploadToGPU = g_AssetManager.IsGPUUploadEnabled();
+    bool retainCPUData = !uploadToGPU || g_AssetManager.ShouldRetainCPUMeshData(path);
+    size_t modelGPUBytes = 0;
+    size_t modelFloat32Bytes = 0;
+    size_t modelCPUBytesRetained = 0;
+    size_t modelCPUBytesReleased = 0;
+
     // Create Model object
     Model *model = new Model();
+    model->submeshes.reserve(parsed.submeshes.size());
 
-    // Move submeshes to the model
-    DEBUG_PRINT("SUB MIGRATE");
-
-    for (auto &pair : materialToSubmesh)
+    for (ParsedSubmesh &entry : parsed.submeshes)
     {
-        model->submeshes.emplace_back(std::move(pair.second));
+        const std::string &materialName = entry.material;
+        Submesh &submesh = entry.submesh;
+
+        // Assign textures to submeshes based on their material. Headless loads keep the
+        // reference without a GL texture so CPU consumers (the software rasterizer) see the material
+        for (const DecodedTexture &decoded : entry.textures)
+        {
+            GLuint texID = UploadTexture(decoded);
+            if (texID != 0 || (!uploadToGPU && !decoded.pixels.empty()))
+            {
+                Texture texture;
+                texture.id = texID;
+                texture.type = decoded.type;
+                texture.path = decoded.path;
+                submesh.textures.push_back(texture);
+            }
+        }
+
+        // Initialize OpenGL buffers for the submesh; headless loads only keep the CPU data
+        if (uploadToGPU)
+            submesh.Initialize(vertexLayout, path);
+        else
+            submesh.ComputeMetadata();
+
+        modelGPUBytes += submesh.gpuVertexBytes + submesh.gpuIndexBytes;
+        modelFloat32Bytes += submesh.vertices.size() * sizeof(Vertex);
+        for (const SubmeshLOD &lod : submesh.lods)
+            modelFloat32Bytes += lod.indexCount * sizeof(unsigned int);
+        // Only Initialize picks a layout; headless submeshes stay unpacked
+        if (uploadToGPU && submesh.layout != vertexLayout)
+        {
+            g_LoggerWindow->AddLog("[AssetManager] %s (%s): UVs out of half float range, using %s layout",
+                                   path.c_str(), materialName.c_str(), VertexLayoutName(submesh.layout));
+        }
+
+        // The GPU owns the data now; keep the CPU copies only when asked to
+        if (retainCPUData)
+            modelCPUBytesRetained += submesh.CPUDataBytes();
+        else
+            modelCPUBytesReleased += submesh.ReleaseCPUData();
+
+        model->submeshes.emplace_back(std::move(submesh));
     }
-    // Code to analyze
+    parsed.submeshes.clear();
+
+    g_AssetManager.RecordMeshCPUData(modelCPUBytesRetained, modelCPUBytesReleased);
+    g_LoggerWindow->AddLog("[AssetManager] %s: CPU mesh data %s (%.1f KB)",
+                           path.c_str(), retainCPUData ? "retained" : "released",
+                           (retainCPUData ? modelCPUBytesRetained : modelCPUBytesReleased) / 1024.0);
+
+    g_AssetManager.RecordMeshUpload(modelGPUBytes, modelFloat32Bytes);
+    if (uploadToGPU)
+        g_LoggerWindow->AddLog("[AssetManager] %s: %.1f KB vertex/index data (%s), %.1f KB as Float32/uint32",
+                               path.c_str(), modelGPUBytes / 1024.0, VertexLayoutName(vertexLayout), modelFloat32Bytes / 1024.0);
+    else
+        g_LoggerWindow->AddLog("[AssetManager] %s: %.1f KB vertex/index data, CPU only (GPU upload disabled)",
+                               path.c_str(), modelFloat32Bytes / 1024.0);
+
     auto end = std::chrono::high_resolution_clock::now();
-    g_LoggerWindow->AddLog("[AssetManager] Loaded Mesh in %.6f seconds",
-                           std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count());
+    double uploadSeconds = std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+    g_LoggerWindow->AddLog("[AssetManager] Loaded Mesh in %.6f seconds (%.6f parsing, %.6f uploading)",
+                           parsed.parseSeconds + uploadSeconds, parsed.parseSeconds, uploadSeconds);
 
     DEBUG_PRINT("[AssetManager] Loaded model with %lld submeshes.", model->submeshes.size());
 
     return model;
 }
+
+std::shared_ptr<Model> AssetManager::FinishModelLoad(ParsedModel &parsed)
+{
+    MemoryTagScope memoryTag(MemoryTag::Assets);
+
+    std::shared_ptr<Model> model(UploadModel(parsed));
+    m_AssetMap[generateKey(AssetType::MODEL, parsed.path)] = model;
+    LoadedAssets = static_cast<int>(m_AssetMap.size());
+    return model;
+}
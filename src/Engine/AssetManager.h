@@ -2,6 +2,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 #include <GL/glew.h>
 #include <vector>
@@ -10,13 +11,20 @@
 #include "stdexcept"
 #include <iostream>
 #include "Rendering/Shader.h"
+#include "Rendering/GPUMemory.h"
+#include "Engine/VertexFormat.h"
+#include "Engine/Meshlet.h"
 #include <algorithm>
 #include <cmath> // For std::abs
 #include <memory>
+#include <cstddef>
 
 // Forward-declare your Shader class
 class Shader;
 
+// Number of assets in the AssetManager cache
+extern int LoadedAssets;
+
 // Define types of assets
 enum class AssetType
 {
@@ -74,6 +82,13 @@ struct Texture
     std::string path;
 };
 
+// A range of the submesh's element buffer holding one level of detail
+struct SubmeshLOD
+{
+    GLsizei indexCount = 0;
+    size_t indexOffset = 0; // In indices, not bytes
+};
+
 // In AssetManager.h or a separate header file
 
 struct Submesh
@@ -83,9 +98,81 @@ struct Submesh
     std::vector<Texture> textures;
     GLuint vao = 0, vbo = 0, ebo = 0;
 
-    // Initialize OpenGL buffers for the submesh
-    void Initialize()
+    // Simplified index buffers (LOD 1..n), uploaded after the full index buffer
+    std::vector<std::vector<unsigned int>> lodIndices;
+    std::vector<SubmeshLOD> lods; // lods[0] is the full resolution mesh
+
+    // Clusters of the full resolution index buffer for per-meshlet culling (empty for small submeshes)
+    std::vector<Meshlet> meshlets;
+    bool closed = false; // Watertight, back faces can never be seen
+
+    // Object space bounds
+    float boundsMin[3] = {0.0f, 0.0f, 0.0f};
+    float boundsMax[3] = {0.0f, 0.0f, 0.0f};
+
+    // GPU-side format chosen at upload time
+    VertexLayout layout = VertexLayout::Float32;
+    GLenum indexType = GL_UNSIGNED_INT;
+    float positionScale[3] = {1.0f, 1.0f, 1.0f};
+    float positionOffset[3] = {0.0f, 0.0f, 0.0f};
+
+    // Bytes uploaded to the vertex/index buffers
+    size_t gpuVertexBytes = 0;
+    size_t gpuIndexBytes = 0;
+
+    // Counts stay valid after the CPU copies are released
+    GLsizei vertexCount = 0;
+    GLsizei indexCount = 0;
+    bool cpuDataRetained = true;
+
+    // Counts, bounds and LOD ranges: everything Initialize derives from the CPU data without touching GL
+    void ComputeMetadata()
+    {
+        vertexCount = static_cast<GLsizei>(vertices.size());
+        indexCount = static_cast<GLsizei>(indices.size());
+
+        for (int i = 0; i < 3; ++i)
+        {
+            boundsMin[i] = vertices.empty() ? 0.0f : vertices[0].position[i];
+            boundsMax[i] = boundsMin[i];
+        }
+        for (const Vertex &v : vertices)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                boundsMin[i] = std::min(boundsMin[i], v.position[i]);
+                boundsMax[i] = std::max(boundsMax[i], v.position[i]);
+            }
+        }
+
+        // Every LOD lives in the same element buffer, back to back
+        lods.clear();
+        lods.push_back({indexCount, 0});
+        size_t offset = indices.size();
+        for (const std::vector<unsigned int> &lod : lodIndices)
+        {
+            lods.push_back({static_cast<GLsizei>(lod.size()), offset});
+            offset += lod.size();
+        }
+    }
+
+    // Initialize OpenGL buffers for the submesh; `owner` is the asset the GPU memory is charged to
+    void Initialize(VertexLayout requestedLayout = VertexLayout::Compact, const std::string &owner = std::string())
     {
+        PackedVertexData packed = PackVertices(vertices, requestedLayout);
+        layout = packed.layout;
+        ComputeMetadata();
+
+        std::vector<unsigned int> allIndices(indices);
+        for (const std::vector<unsigned int> &lod : lodIndices)
+            allIndices.insert(allIndices.end(), lod.begin(), lod.end());
+
+        for (int i = 0; i < 3; ++i)
+        {
+            positionScale[i] = packed.positionScale[i];
+            positionOffset[i] = packed.positionOffset[i];
+        }
+
         glGenVertexArrays(1, &vao);
         glGenBuffers(1, &vbo);
         glGenBuffers(1, &ebo);
@@ -93,24 +180,121 @@ struct Submesh
         glBindVertexArray(vao);
 
         glBindBuffer(GL_ARRAY_BUFFER, vbo);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, packed.bytes.size(), packed.bytes.data(), GL_STATIC_DRAW);
+        gpuVertexBytes = packed.bytes.size();
 
+        // 16-bit indices whenever every vertex is addressable with them
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
-
-        // Vertex positions
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)0);
-        // Texture coordinates
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)(3 * sizeof(float)));
-        // Normals
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void *)(5 * sizeof(float)));
+        if (vertices.size() < 65536)
+        {
+            std::vector<uint16_t> shortIndices(allIndices.begin(), allIndices.end());
+            indexType = GL_UNSIGNED_SHORT;
+            gpuIndexBytes = shortIndices.size() * sizeof(uint16_t);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, gpuIndexBytes, shortIndices.data(), GL_STATIC_DRAW);
+        }
+        else
+        {
+            indexType = GL_UNSIGNED_INT;
+            gpuIndexBytes = allIndices.size() * sizeof(unsigned int);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, gpuIndexBytes, allIndices.data(), GL_STATIC_DRAW);
+        }
+
+        GPUMemory::Get().RecordBuffer(vbo, GPUMemoryCategory::VertexBuffer, gpuVertexBytes, owner);
+        GPUMemory::Get().RecordBuffer(ebo, GPUMemoryCategory::IndexBuffer, gpuIndexBytes, owner);
+
+        GLsizei stride = static_cast<GLsizei>(packed.stride);
+        switch (layout)
+        {
+        case VertexLayout::Compact:
+            // Vertex positions
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void *)offsetof(CompactVertex, position));
+            // Texture coordinates (half floats)
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void *)offsetof(CompactVertex, texCoord));
+            // Normals (octahedral, decoded in the vertex shader)
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, stride, (void *)offsetof(CompactVertex, normal));
+            break;
+        case VertexLayout::Quantized:
+            // Vertex positions (snorm16, dequantized with uPositionScale/uPositionOffset)
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_SHORT, GL_TRUE, stride, (void *)offsetof(QuantizedVertex, position));
+            // Texture coordinates (half floats)
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void *)offsetof(QuantizedVertex, texCoord));
+            // Normals (octahedral, decoded in the vertex shader)
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(2, 2, GL_SHORT, GL_TRUE, stride, (void *)offsetof(QuantizedVertex, normal));
+            break;
+        case VertexLayout::Float32:
+        default:
+            // Vertex positions
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void *)0);
+            // Texture coordinates
+            glEnableVertexAttribArray(1);
+            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void *)(3 * sizeof(float)));
+            // Normals
+            glEnableVertexAttribArray(2);
+            glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void *)(5 * sizeof(float)));
+            break;
+        }
 
         glBindVertexArray(0);
     }
 
+    /**
+     * @brief Frees the CPU-side vertex/index copies once they live on the GPU.
+     *
+     * @return Number of bytes released.
+     */
+    size_t ReleaseCPUData()
+    {
+        size_t released = CPUDataBytes();
+        std::vector<Vertex>().swap(vertices);
+        std::vector<unsigned int>().swap(indices);
+        std::vector<std::vector<unsigned int>>().swap(lodIndices);
+        cpuDataRetained = false;
+        return released;
+    }
+
+    // Bytes held by the CPU-side vertex/index copies
+    size_t CPUDataBytes() const
+    {
+        size_t bytes = vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(unsigned int);
+        for (const std::vector<unsigned int> &lod : lodIndices)
+            bytes += lod.capacity() * sizeof(unsigned int);
+        return bytes;
+    }
+
+    size_t IndexSize() const
+    {
+        return indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int);
+    }
+
+    int LODCount() const
+    {
+        return lods.empty() ? 1 : static_cast<int>(lods.size());
+    }
+
+    // Index range for a LOD, clamped to the coarsest one available
+    SubmeshLOD GetLOD(int lod) const
+    {
+        if (lods.empty())
+            return {indexCount, 0};
+        lod = std::max(0, std::min(lod, static_cast<int>(lods.size()) - 1));
+        return lods[lod];
+    }
+
+    // Uploads the per-submesh decode parameters the vertex shaders need for packed layouts
+    void SetVertexFormatUniforms(const Shader *shader) const
+    {
+        shader->SetVec3("uPositionScale", glm::vec3(positionScale[0], positionScale[1], positionScale[2]));
+        shader->SetVec3("uPositionOffset", glm::vec3(positionOffset[0], positionOffset[1], positionOffset[2]));
+        shader->SetBool("uOctahedralNormals", layout != VertexLayout::Float32);
+    }
+
     // Render the submesh
     void Draw(Shader *shader)
     {
@@ -137,9 +321,11 @@ struct Submesh
             glBindTexture(GL_TEXTURE_2D, textures[i].id);
         }
 
+        SetVertexFormatUniforms(shader);
+
         // Draw mesh
         glBindVertexArray(vao);
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
+        glDrawElements(GL_TRIANGLES, indexCount, indexType, 0);
         glBindVertexArray(0);
 
         // Always good practice to set everything back to defaults once configured.
@@ -170,13 +356,67 @@ struct Model
             if (submesh.vao != 0)
                 glDeleteVertexArrays(1, &submesh.vao);
             if (submesh.vbo != 0)
+            {
+                GPUMemory::Get().ReleaseBuffer(submesh.vbo);
                 glDeleteBuffers(1, &submesh.vbo);
+            }
             if (submesh.ebo != 0)
+            {
+                GPUMemory::Get().ReleaseBuffer(submesh.ebo);
                 glDeleteBuffers(1, &submesh.ebo);
+            }
         }
     }
 };
 
+// Image referenced by a model, decoded but not uploaded yet
+struct DecodedTexture
+{
+    std::string type;     // texture_diffuse, texture_specular or texture_normal
+    std::string path;     // As written in the MTL file, relative to the model
+    std::string fullPath; // What was actually loaded
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    std::vector<unsigned char> pixels; // Empty if the file couldn't be decoded
+};
+
+// One material's submesh with its textures, ready for upload
+struct ParsedSubmesh
+{
+    std::string material;
+    Submesh submesh;
+    std::vector<DecodedTexture> textures;
+};
+
+/**
+ * @brief CPU half of a model load.
+ *
+ * ParseModel does everything that doesn't need GL: OBJ/MTL parsing, texture
+ * decoding, vertex cache optimization, meshlets and LOD simplification, so
+ * it may run on a worker thread. UploadModel (or AssetManager::FinishModelLoad)
+ * then creates the textures and buffers on the thread owning the context.
+ */
+struct ParsedModel
+{
+    std::string path;
+    std::vector<ParsedSubmesh> submeshes;
+    double parseSeconds = 0.0;
+};
+
+// AssetManager settings ParseModel depends on, read on the thread that starts the load
+struct ModelParseOptions
+{
+    bool buildMeshlets = true;
+    bool generateLODs = true;
+};
+
+// nullptr if the file can't be opened
+std::unique_ptr<ParsedModel> ParseModel(const std::string &path, const ModelParseOptions &options);
+
+// Uploads and consumes the parsed submeshes; GL thread only
+Model *UploadModel(ParsedModel &parsed);
+
 // The main AssetManager
 class AssetManager
 {
@@ -224,6 +464,7 @@ public:
                 return nullptr; // For smart pointers, return nullptr on failure
             }
             m_AssetMap[key] = assetData;
+            LoadedAssets = static_cast<int>(m_AssetMap.size());
             return std::get<std::shared_ptr<T>>(assetData);
         }
         catch (const std::exception &e)
@@ -236,7 +477,86 @@ public:
 
     void DebugAssetMap();
 
+    // Vertex layout used for models loaded from now on
+    void SetVertexLayout(VertexLayout layout) { m_VertexLayout = layout; }
+    VertexLayout GetVertexLayout() const { return m_VertexLayout; }
+
+    // Running totals over every uploaded submesh
+    void RecordMeshUpload(size_t gpuBytes, size_t float32Bytes)
+    {
+        m_MeshGPUBytes += gpuBytes;
+        m_MeshFloat32Bytes += float32Bytes;
+    }
+    size_t GetMeshGPUBytes() const { return m_MeshGPUBytes; }
+    size_t GetMeshFloat32Bytes() const { return m_MeshFloat32Bytes; }
+
+    /**
+     * @brief Whether loaded assets are handed to GL.
+     *
+     * Disabled for headless runs without a GL context: models are parsed,
+     * optimized and kept CPU-side, model textures are decoded and kept as
+     * path references with id 0, and shaders fail to load. Applies to
+     * assets loaded afterwards.
+     */
+    void SetGPUUploadEnabled(bool enabled) { m_GPUUploadEnabled = enabled; }
+    bool IsGPUUploadEnabled() const { return m_GPUUploadEnabled; }
+
+    // Meshlet clusters for models loaded from now on
+    void SetBuildMeshlets(bool build) { m_BuildMeshlets = build; }
+    bool GetBuildMeshlets() const { return m_BuildMeshlets; }
+
+    // Simplified LOD index buffers for models loaded from now on
+    void SetGenerateLODs(bool generate) { m_GenerateLODs = generate; }
+    bool GetGenerateLODs() const { return m_GenerateLODs; }
+
+    ModelParseOptions GetModelParseOptions() const { return {m_BuildMeshlets, m_GenerateLODs}; }
+
+    // Uploads a model parsed with ParseModel and caches it like loadAsset; GL thread only
+    std::shared_ptr<Model> FinishModelLoad(ParsedModel &parsed);
+
+    /**
+     * @brief CPU-side mesh data retention policy.
+     *
+     * By default submeshes drop their vertex/index vectors after upload.
+     * Retention can be enabled globally or for individual model paths
+     * (picking, physics, re-export). Applies to models loaded afterwards.
+     */
+    void SetRetainCPUMeshData(bool retain) { m_RetainCPUMeshData = retain; }
+    bool GetRetainCPUMeshData() const { return m_RetainCPUMeshData; }
+    void RetainCPUMeshData(const std::string &path, bool retain = true)
+    {
+        if (retain)
+            m_RetainCPUMeshPaths.insert(path);
+        else
+            m_RetainCPUMeshPaths.erase(path);
+    }
+    bool ShouldRetainCPUMeshData(const std::string &path) const
+    {
+        return m_RetainCPUMeshData || m_RetainCPUMeshPaths.count(path) > 0;
+    }
+
+    // CPU-side mesh memory kept vs. released after upload
+    void RecordMeshCPUData(size_t retainedBytes, size_t releasedBytes)
+    {
+        m_MeshCPUBytesRetained += retainedBytes;
+        m_MeshCPUBytesReleased += releasedBytes;
+    }
+    size_t GetMeshCPUBytesRetained() const { return m_MeshCPUBytesRetained; }
+    size_t GetMeshCPUBytesReleased() const { return m_MeshCPUBytesReleased; }
+
 private:
+    VertexLayout m_VertexLayout = VertexLayout::Compact;
+    size_t m_MeshGPUBytes = 0;
+    size_t m_MeshFloat32Bytes = 0;
+
+    bool m_GPUUploadEnabled = true;
+    bool m_GenerateLODs = true;
+    bool m_BuildMeshlets = true;
+    bool m_RetainCPUMeshData = false;
+    std::unordered_set<std::string> m_RetainCPUMeshPaths;
+    size_t m_MeshCPUBytesRetained = 0;
+    size_t m_MeshCPUBytesReleased = 0;
+
     // Cache of already loaded assets: key = "type + path"
     std::unordered_map<std::string, AssetVariant> m_AssetMap;
 
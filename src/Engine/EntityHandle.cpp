@@ -0,0 +1,44 @@
+// EntityHandle.cpp
+
+#include "EntityHandle.h"
+
+EntityHandle EntityRegistry::Register(void *object)
+{
+    uint32_t index;
+    if (!m_FreeSlots.empty())
+    {
+        index = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_Slots.size());
+        m_Slots.emplace_back();
+    }
+
+    Slot &slot = m_Slots[index];
+    slot.Object = object;
+
+    EntityHandle handle;
+    handle.Index = index;
+    handle.Generation = slot.Generation;
+    return handle;
+}
+
+void EntityRegistry::Unregister(EntityHandle handle)
+{
+    if (handle.Index >= m_Slots.size())
+        return;
+
+    Slot &slot = m_Slots[handle.Index];
+    if (slot.Generation != handle.Generation)
+        return;
+
+    slot.Object = nullptr;
+
+    // Skip 0 on wrap-around so a default handle never matches a live slot
+    if (++slot.Generation == 0)
+        slot.Generation = 1;
+
+    m_FreeSlots.push_back(handle.Index);
+}
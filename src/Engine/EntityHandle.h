@@ -0,0 +1,66 @@
+// EntityHandle.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Generational reference to a GameObject or Component.
+ *
+ * Lua holds these instead of raw pointers. When the object is destroyed its
+ * slot's generation is bumped, so stale handles (e.g. kept across a
+ * LoadScene) resolve to nullptr instead of dangling.
+ */
+struct EntityHandle
+{
+    uint32_t Index = 0;
+    uint32_t Generation = 0; // 0 is never a live generation
+
+    bool IsNull() const { return Generation == 0; }
+
+    // Unique per (slot, generation); used as the key of the Lua userdata cache
+    int64_t Key() const { return (static_cast<int64_t>(Index) << 32) | Generation; }
+
+    bool operator==(const EntityHandle &other) const { return Index == other.Index && Generation == other.Generation; }
+    bool operator!=(const EntityHandle &other) const { return !(*this == other); }
+};
+
+// Slot table behind EntityHandle. Objects register on construction and unregister on destruction.
+class EntityRegistry
+{
+public:
+    static EntityRegistry &Get()
+    {
+        static EntityRegistry instance;
+        return instance;
+    }
+
+    EntityHandle Register(void *object);
+    void Unregister(EntityHandle handle);
+
+    // The object the handle refers to, or nullptr if it has been destroyed
+    void *Resolve(EntityHandle handle) const
+    {
+        if (handle.Index >= m_Slots.size())
+            return nullptr;
+        const Slot &slot = m_Slots[handle.Index];
+        return slot.Generation == handle.Generation ? slot.Object : nullptr;
+    }
+
+    size_t LiveCount() const { return m_Slots.size() - m_FreeSlots.size(); }
+
+private:
+    EntityRegistry() {}
+    EntityRegistry(const EntityRegistry &) = delete;
+    EntityRegistry &operator=(const EntityRegistry &) = delete;
+
+    struct Slot
+    {
+        void *Object = nullptr;
+        uint32_t Generation = 1;
+    };
+
+    std::vector<Slot> m_Slots;
+    std::vector<uint32_t> m_FreeSlots;
+};
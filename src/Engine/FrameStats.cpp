@@ -0,0 +1,181 @@
+// FrameStats.cpp
+
+#include "FrameStats.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+
+FrameStats::FrameStats()
+    : m_Histogram(static_cast<size_t>(HistogramMaxMs / HistogramBinMs) + 1, 0)
+{
+    m_Sorted.reserve(Capacity);
+}
+
+void FrameStats::EndFrame()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (m_HasLastFrame)
+        AddFrame(std::chrono::duration<double, std::milli>(now - m_LastFrameTime).count());
+    m_LastFrameTime = now;
+    m_HasLastFrame = true;
+}
+
+void FrameStats::AddFrame(double frameMs)
+{
+    m_Frames[m_Head] = static_cast<float>(frameMs);
+    m_Head = (m_Head + 1) % Capacity;
+    m_Count = std::min(m_Count + 1, Capacity);
+    m_TotalFrames++;
+
+    size_t bin = std::min(static_cast<size_t>(std::max(0.0, frameMs) / HistogramBinMs), m_Histogram.size() - 1);
+    m_Histogram[bin]++;
+    m_SessionSumMs += frameMs;
+    m_SessionMaxMs = std::max(m_SessionMaxMs, frameMs);
+
+    if (m_HitchThresholdMs > 0.0 && frameMs > m_HitchThresholdMs)
+        RecordHitch(frameMs);
+}
+
+void FrameStats::RecordHitch(double frameMs)
+{
+    FrameHitch hitch;
+    hitch.Frame = m_TotalFrames - 1;
+    hitch.TimeMs = frameMs;
+
+    // Main thread zones in depth-first order, so the list reads like the call tree
+    const std::vector<ProfileNode> &tree = Profiler::Get().GetLastFrameTree();
+    std::vector<uint32_t> stack;
+    for (uint32_t i = static_cast<uint32_t>(tree.size()); i-- > 0;)
+    {
+        if (tree[i].Parent == ProfileNode::NoParent && tree[i].MainThread)
+            stack.push_back(i);
+    }
+    while (!stack.empty())
+    {
+        const ProfileNode &node = tree[stack.back()];
+        stack.pop_back();
+        hitch.Zones.push_back({node.Name, node.Depth, node.InclusiveTime, node.SelfTime});
+        for (auto child = node.Children.rbegin(); child != node.Children.rend(); ++child)
+            stack.push_back(*child);
+    }
+
+    m_Hitches.push_back(std::move(hitch));
+    if (m_Hitches.size() > MaxHitches)
+        m_Hitches.pop_front();
+    m_TotalHitches++;
+}
+
+// Nearest-rank percentile of an ascending array
+static double Percentile(const std::vector<float> &sorted, double fraction)
+{
+    size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+FrameTimeSummary FrameStats::ComputeWindow(size_t frames) const
+{
+    FrameTimeSummary summary;
+    GetRecentFrames(frames, m_Sorted);
+    if (m_Sorted.empty())
+        return summary;
+
+    double sum = 0.0;
+    for (float frame : m_Sorted)
+        sum += frame;
+    std::sort(m_Sorted.begin(), m_Sorted.end());
+
+    summary.Frames = static_cast<int>(m_Sorted.size());
+    summary.AverageMs = sum / m_Sorted.size();
+    summary.P50Ms = Percentile(m_Sorted, 0.50);
+    summary.P95Ms = Percentile(m_Sorted, 0.95);
+    summary.P99Ms = Percentile(m_Sorted, 0.99);
+    summary.MaxMs = m_Sorted.back();
+    return summary;
+}
+
+FrameTimeSummary FrameStats::ComputeSession() const
+{
+    FrameTimeSummary summary;
+    if (m_TotalFrames == 0)
+        return summary;
+
+    summary.Frames = static_cast<int>(std::min<uint64_t>(m_TotalFrames, INT32_MAX));
+    summary.AverageMs = m_SessionSumMs / m_TotalFrames;
+    summary.MaxMs = m_SessionMaxMs;
+
+    // Upper edge of the bin holding each rank; the overflow bin reports the max
+    const double fractions[3] = {0.50, 0.95, 0.99};
+    double *results[3] = {&summary.P50Ms, &summary.P95Ms, &summary.P99Ms};
+    uint64_t seen = 0;
+    size_t next = 0;
+    for (size_t bin = 0; bin < m_Histogram.size() && next < 3; ++bin)
+    {
+        seen += m_Histogram[bin];
+        while (next < 3 && seen >= static_cast<uint64_t>(std::ceil(fractions[next] * m_TotalFrames)))
+        {
+            double upper = bin + 1 < m_Histogram.size() ? (bin + 1) * HistogramBinMs : m_SessionMaxMs;
+            *results[next++] = std::min(upper, m_SessionMaxMs);
+        }
+    }
+    return summary;
+}
+
+void FrameStats::GetRecentFrames(size_t count, std::vector<float> &out) const
+{
+    count = std::min(count, m_Count);
+    out.resize(count);
+    size_t start = (m_Head + Capacity - count) % Capacity;
+    for (size_t i = 0; i < count; ++i)
+        out[i] = m_Frames[(start + i) % Capacity];
+}
+
+void FrameStats::SetWindowFrames(size_t frames)
+{
+    m_WindowFrames = std::max<size_t>(1, std::min(frames, Capacity));
+}
+
+bool FrameStats::ExportCSV(const std::string &path) const
+{
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty())
+        std::filesystem::create_directories(parent, ec);
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+        return false;
+
+    out << "frame,ms,hitch\n";
+    uint64_t firstFrame = m_TotalFrames - m_Count;
+    size_t start = (m_Head + Capacity - m_Count) % Capacity;
+    for (size_t i = 0; i < m_Count; ++i)
+    {
+        float frameMs = m_Frames[(start + i) % Capacity];
+        out << firstFrame + i << ',' << frameMs << ',' << (m_HitchThresholdMs > 0.0 && frameMs > m_HitchThresholdMs ? 1 : 0) << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+std::string FrameStats::DefaultExportPath()
+{
+    std::time_t now = std::time(nullptr);
+    char name[64];
+    std::strftime(name, sizeof(name), "frame_stats_%Y%m%d_%H%M%S.csv", std::localtime(&now));
+    return (std::filesystem::path("stats") / name).string();
+}
+
+void FrameStats::Reset()
+{
+    m_Head = 0;
+    m_Count = 0;
+    m_TotalFrames = 0;
+    std::fill(m_Histogram.begin(), m_Histogram.end(), 0);
+    m_SessionSumMs = 0.0;
+    m_SessionMaxMs = 0.0;
+    m_Hitches.clear();
+    m_TotalHitches = 0;
+}
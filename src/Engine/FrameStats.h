@@ -0,0 +1,127 @@
+// FrameStats.h
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Percentiles of frame time over some set of frames, in milliseconds
+struct FrameTimeSummary
+{
+    int Frames = 0;
+    double AverageMs = 0.0;
+    double P50Ms = 0.0;
+    double P95Ms = 0.0;
+    double P99Ms = 0.0;
+    double MaxMs = 0.0;
+};
+
+// One zone of a hitch frame's call tree, flattened in tree order
+struct HitchZone
+{
+    const char *Name;
+    uint32_t Depth;
+    double InclusiveUs;
+    double SelfUs;
+};
+
+// A frame that took longer than the hitch threshold, with the main thread's zones for that frame
+struct FrameHitch
+{
+    uint64_t Frame;
+    double TimeMs;
+    std::vector<HitchZone> Zones;
+};
+
+/**
+ * @brief Frame time statistics: every frame goes into a fixed ring buffer and
+ * a streaming histogram.
+ *
+ * The ring answers percentiles over the last N frames; the histogram covers
+ * the whole session in constant memory (0.1 ms bins up to HistogramMaxMs,
+ * exact max beyond). Frames over the hitch threshold keep a copy of the
+ * profiler's call tree for that frame, so EndFrame must run right after
+ * Profiler::EndFrame.
+ */
+class FrameStats
+{
+public:
+    static FrameStats &Get()
+    {
+        static FrameStats instance;
+        return instance;
+    }
+
+    static const size_t Capacity = 8192;
+    static const size_t MaxHitches = 64;
+    static constexpr double HistogramBinMs = 0.1;
+    static constexpr double HistogramMaxMs = 250.0;
+
+    // Records the frame that just ended (time since the previous call)
+    void EndFrame();
+
+    // Records a frame of known duration; EndFrame's timing path uses this too
+    void AddFrame(double frameMs);
+
+    // Over the last `frames` frames (clamped to what the ring holds)
+    FrameTimeSummary ComputeWindow(size_t frames) const;
+
+    // Over every frame since startup or the last Reset, from the histogram
+    FrameTimeSummary ComputeSession() const;
+
+    // Copies the last `count` frame times, oldest first, into `out`
+    void GetRecentFrames(size_t count, std::vector<float> &out) const;
+
+    double GetLastFrameMs() const { return m_Count ? m_Frames[(m_Head + Capacity - 1) % Capacity] : 0.0; }
+    uint64_t GetFrameCount() const { return m_TotalFrames; }
+
+    // Frames above this are hitches
+    double GetHitchThresholdMs() const { return m_HitchThresholdMs; }
+    void SetHitchThresholdMs(double thresholdMs) { m_HitchThresholdMs = thresholdMs > 0.0 ? thresholdMs : 0.0; }
+
+    // Most recent last
+    const std::deque<FrameHitch> &GetHitches() const { return m_Hitches; }
+    uint64_t GetHitchCount() const { return m_TotalHitches; }
+
+    // Default window the UI reports percentiles over
+    size_t GetWindowFrames() const { return m_WindowFrames; }
+    void SetWindowFrames(size_t frames);
+
+    // Frame index, milliseconds and hitch flag for every frame in the ring; false if the file can't be written
+    bool ExportCSV(const std::string &path) const;
+
+    // stats/frame_stats_<date>_<time>.csv under the working directory
+    static std::string DefaultExportPath();
+
+    void Reset();
+
+private:
+    FrameStats();
+    FrameStats(const FrameStats &) = delete;
+    FrameStats &operator=(const FrameStats &) = delete;
+
+    void RecordHitch(double frameMs);
+
+    float m_Frames[Capacity];
+    size_t m_Head = 0;  // Next slot to write
+    size_t m_Count = 0; // Valid entries, up to Capacity
+    uint64_t m_TotalFrames = 0;
+
+    std::vector<uint32_t> m_Histogram; // Last bin counts everything at or above HistogramMaxMs
+    double m_SessionSumMs = 0.0;
+    double m_SessionMaxMs = 0.0;
+
+    double m_HitchThresholdMs = 50.0;
+    std::deque<FrameHitch> m_Hitches;
+    uint64_t m_TotalHitches = 0;
+
+    size_t m_WindowFrames = 600;
+
+    std::chrono::steady_clock::time_point m_LastFrameTime;
+    bool m_HasLastFrame = false;
+
+    // Scratch for percentile selection
+    mutable std::vector<float> m_Sorted;
+};
@@ -0,0 +1,103 @@
+// JobSystem.cpp
+
+#include "JobSystem.h"
+
+#include <algorithm>
+
+JobSystem::JobSystem()
+{
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    size_t workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+
+    m_Workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+        m_Workers.emplace_back(&JobSystem::WorkerLoop, this);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stopping = true;
+    }
+    m_WakeCondition.notify_all();
+
+    for (std::thread &worker : m_Workers)
+        worker.join();
+}
+
+void JobSystem::ParallelFor(size_t count, const std::function<void(size_t)> &job)
+{
+    if (count == 0)
+        return;
+
+    // Not worth waking anyone for
+    if (count == 1 || m_Workers.empty())
+    {
+        for (size_t i = 0; i < count; ++i)
+            job(i);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Job = &job;
+        m_Count = count;
+        m_Next = 0;
+        m_Remaining = count;
+        m_Batch++;
+    }
+    m_WakeCondition.notify_all();
+
+    RunJobs(job, count);
+
+    // Wait for the last index and for every worker to stop claiming, so the next loop starts clean
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_DoneCondition.wait(lock, [this]()
+                         { return m_Remaining == 0 && m_ActiveWorkers == 0; });
+    m_Job = nullptr;
+}
+
+void JobSystem::RunJobs(const std::function<void(size_t)> &job, size_t count)
+{
+    size_t index;
+    while ((index = m_Next.fetch_add(1)) < count)
+    {
+        job(index);
+        if (m_Remaining.fetch_sub(1) == 1)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_DoneCondition.notify_all();
+        }
+    }
+}
+
+void JobSystem::WorkerLoop()
+{
+    uint64_t seenBatch = 0;
+    while (true)
+    {
+        const std::function<void(size_t)> *job;
+        size_t count;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_WakeCondition.wait(lock, [this, seenBatch]()
+                                 { return m_Stopping || (m_Job && m_Batch != seenBatch); });
+            if (m_Stopping)
+                return;
+
+            seenBatch = m_Batch;
+            job = m_Job;
+            count = m_Count;
+            m_ActiveWorkers++;
+        }
+
+        RunJobs(*job, count);
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_ActiveWorkers--;
+        }
+        m_DoneCondition.notify_all();
+    }
+}
@@ -0,0 +1,61 @@
+// JobSystem.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed pool of worker threads for data-parallel loops.
+ *
+ * ParallelFor hands out indices one at a time, so uneven jobs (scripts of
+ * different cost) balance themselves. The calling thread works on the loop
+ * too and the call returns once every index has run.
+ */
+class JobSystem
+{
+public:
+    static JobSystem &Get()
+    {
+        static JobSystem instance;
+        return instance;
+    }
+
+    // Runs job(0) ... job(count - 1) across the workers and the calling thread
+    void ParallelFor(size_t count, const std::function<void(size_t)> &job);
+
+    // Worker threads, not counting the thread calling ParallelFor
+    size_t GetWorkerCount() const { return m_Workers.size(); }
+
+private:
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    void WorkerLoop();
+
+    // Claims and runs indices of the current loop until none are left
+    void RunJobs(const std::function<void(size_t)> &job, size_t count);
+
+    std::vector<std::thread> m_Workers;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_WakeCondition;
+    std::condition_variable m_DoneCondition;
+
+    // Current loop; only replaced once every worker has left the previous one
+    const std::function<void(size_t)> *m_Job = nullptr;
+    size_t m_Count = 0;
+    uint64_t m_Batch = 0;
+    size_t m_ActiveWorkers = 0;
+    bool m_Stopping = false;
+
+    std::atomic<size_t> m_Next{0};
+    std::atomic<size_t> m_Remaining{0};
+};
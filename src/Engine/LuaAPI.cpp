@@ -2,6 +2,7 @@
 
 #include "LuaAPI.h"
 #include "LuaMacros.h" // Include the macros for binding
+#include "LuaBytecodeCache.h"
 #include "gcml.h"      // Include gcml.h for DEBUG_PRINT macros
 #include "Componenets/Component.h"
 #include "Componenets/Transform.h"
@@ -9,44 +10,1331 @@
 #include "Componenets/ScriptComponent.h"
 #include "Componenets/GameObject.h"
 #include "Windows/LoggerWindow.h"
+#include "Engine/SceneIndex.h"
+#include "Engine/Profiler.h"
+#include "Engine/AssetManager.h"
+#include "Engine/JobSystem.h"
+#include "Engine/MemoryTracker.h"
 
 #include <yaml-cpp/yaml.h>
 #include <cstring>
 #include <memory>
 #include <vector>
 #include <filesystem> // C++17 or later
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <mutex>
 
 // TODO: Add camera component Meta Table
 
 // External LoggerWindow instance for logging
 extern LoggerWindow *g_LoggerWindow;
 
+extern AssetManager g_AssetManager;
+
 // External GameObjects list
-extern std::vector<std::unique_ptr<GameObject>> g_GameObjects;
+extern std::vector<std::shared_ptr<GameObject>> g_GameObjects;
+
+lua_State *LuaManager::s_SharedState = nullptr;
+bool LuaManager::s_SharedStateEnabled = true;
+thread_local LuaManager *LuaManager::s_ActiveManager = nullptr;
+bool LuaManager::s_ParallelUpdates = false;
+int LuaManager::s_SchedulerRef = LUA_NOREF;
+long long LuaManager::s_InstructionBudget = 1000000;
+size_t LuaManager::s_MemoryLimit = 64 * 1024 * 1024;
+LuaGCMode LuaManager::s_GCMode = LuaGCMode::Generational;
+bool LuaManager::s_EngineDrivenGC = true;
+double LuaManager::s_GCTargetFrameMs = 1000.0 / 60.0;
+LuaGCStats LuaManager::s_GCStats;
+
+// Instructions between two calls of the budget hook
+static const int s_HookInterval = 1000;
+
+// Non-yieldable code gets this many budgets before it is aborted
+static const long long s_NonYieldableBudgetFactor = 10;
+
+// Lua heap charged to one script. Account 0 collects allocations made while no script runs.
+struct LuaMemoryAccount
+{
+    size_t Bytes = 0;
+    size_t PeakBytes = 0;
+    size_t Limit = 0;
+    int LimitHits = 0;
+    bool Released = false; // Owner is gone; reusable once its remaining blocks are freed
+};
+
+// Prepended to every Lua block; 16 bytes keeps malloc's alignment for the block itself
+struct alignas(16) LuaBlockHeader
+{
+    uint32_t Account;
+};
+
+// Deliberately leaked: Lua states owned by other globals may still free blocks during static destruction
+static std::vector<LuaMemoryAccount> &MemoryAccounts()
+{
+    static std::vector<LuaMemoryAccount> *accounts = new std::vector<LuaMemoryAccount>(1);
+    return *accounts;
+}
+
+static std::vector<uint32_t> &FreeMemoryAccounts()
+{
+    static std::vector<uint32_t> *freeAccounts = new std::vector<uint32_t>();
+    return *freeAccounts;
+}
+
+// Every live LuaManager, for GetScriptStats
+static std::vector<LuaManager *> &LiveManagers()
+{
+    static std::vector<LuaManager *> *managers = new std::vector<LuaManager *>();
+    return *managers;
+}
+
+// Guards the account list and free list. The counters of one account are only touched by the thread
+// running the account's Lua state, and accounts are never acquired while scripts run in parallel.
+static std::mutex &AccountMutex()
+{
+    static std::mutex *mutex = new std::mutex();
+    return *mutex;
+}
+
+static uint32_t AcquireMemoryAccount(size_t limit)
+{
+    std::lock_guard<std::mutex> lock(AccountMutex());
+    std::vector<LuaMemoryAccount> &accounts = MemoryAccounts();
+    uint32_t id;
+    if (!FreeMemoryAccounts().empty())
+    {
+        id = FreeMemoryAccounts().back();
+        FreeMemoryAccounts().pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(accounts.size());
+        accounts.emplace_back();
+    }
+    accounts[id] = LuaMemoryAccount();
+    accounts[id].Limit = limit;
+    return id;
+}
+
+static void ReleaseMemoryAccount(uint32_t id)
+{
+    if (id == 0)
+        return;
+    std::lock_guard<std::mutex> lock(AccountMutex());
+    LuaMemoryAccount &account = MemoryAccounts()[id];
+    account.Released = true;
+    if (account.Bytes == 0)
+        FreeMemoryAccounts().push_back(id);
+}
+
+// Lua heap in bytes
+static size_t LuaHeapBytes(lua_State *L)
+{
+    return static_cast<size_t>(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 + static_cast<size_t>(lua_gc(L, LUA_GCCOUNTB, 0));
+}
+
+// Engine-driven GC bookkeeping of one Lua state
+struct LuaGCState
+{
+    size_t BaselineBytes = 0; // Heap after the last completed collection
+    double StepMs = 0.0;      // Moving average cost of one step
+    bool InCycle = false;     // Incremental mode: a cycle has been started and not finished
+};
+
+static std::unordered_map<lua_State *, LuaGCState> &GCStates()
+{
+    static std::unordered_map<lua_State *, LuaGCState> *states = new std::unordered_map<lua_State *, LuaGCState>();
+    return *states;
+}
+
+// Generational mode: a young collection is due once the heap grew this much since the last one
+static const size_t s_GCMinorGrowthPercent = 20;
+
+// Incremental mode: a new cycle starts once the heap grew this much (Lua's default pause is 200%)
+static const size_t s_GCCycleGrowthPercent = 100;
+
+// Budget limits, so collection always progresses and never eats a whole frame
+static const double s_GCMinBudgetMs = 0.05;
+static const double s_GCMaxBudgetMs = 2.0;
+
+// When the active script started running (CPU time per script)
+static thread_local std::chrono::high_resolution_clock::time_point s_ActiveStart;
+
+// Coroutine the engine resumed for the active script (update runner or task); the only one the budget hook may yield
+static thread_local lua_State *s_ActiveThread = nullptr;
+
+// Transform write made by a script during UpdateParallel
+struct LuaTransformCommand
+{
+    EntityHandle Transform;
+    bool Rotation; // Position otherwise
+    glm::vec3 Value;
+};
+
+// Set while a script runs in UpdateParallel: its transform writes go here instead of to the scene
+static thread_local std::vector<LuaTransformCommand> *s_TransformCommands = nullptr;
+int LuaManager::s_SchedulerUpdateRef = LUA_NOREF;
+
+// Update loop of the shared state. Scripts are kept in registration order; removal leaves a
+// hole that is compacted before the next update so slots stay stable while iterating.
+// Each script's OnUpdate runs in its own coroutine so the instruction hook can suspend an
+// over-budget script and the loop resumes it next frame.
+static const char *s_SchedulerSource = R"(
+local setActive, reportError = ...
+local pcall, create, resume, yield = pcall, coroutine.create, coroutine.resume, coroutine.yield
+
+local DONE = {}
+
+-- Reused across frames: yields DONE after every completed OnUpdate
+local function Runner(fn)
+    return create(function(dt)
+        while true do
+            local ok, err = pcall(fn, dt)
+            dt = yield(DONE, ok, err)
+        end
+    end)
+end
+
+local functions, runners, suspended, owners, slots = {}, {}, {}, {}, {}
+local count, holes, updating = 0, 0, false
+
+local function Compact()
+    local n = 0
+    for i = 1, count do
+        local fn = functions[i]
+        if fn then
+            n = n + 1
+            local owner = owners[i]
+            functions[n], runners[n], suspended[n], owners[n] = fn, runners[i], suspended[i], owner
+            slots[owner] = n
+        end
+    end
+    for i = n + 1, count do
+        functions[i], runners[i], suspended[i], owners[i] = nil, nil, nil, nil
+    end
+    count, holes = n, 0
+end
+
+local Scheduler = {}
+
+function Scheduler.Add(owner, fn)
+    local slot = slots[owner]
+    if not slot then
+        count = count + 1
+        slot = count
+        owners[slot] = owner
+        slots[owner] = slot
+    end
+    functions[slot], runners[slot], suspended[slot] = fn, Runner(fn), false
+end
+
+function Scheduler.Remove(owner)
+    local slot = slots[owner]
+    if not slot then
+        return
+    end
+    functions[slot], runners[slot], suspended[slot], owners[slot] = false, false, false, false
+    slots[owner] = nil
+    holes = holes + 1
+    if not updating and holes * 2 > count then
+        Compact()
+    end
+end
+
+function Scheduler.Count()
+    return count - holes
+end
+
+function Scheduler.Update(dt)
+    if holes > 0 then
+        Compact()
+    end
+    updating = true
+    for i = 1, count do
+        local runner = runners[i]
+        if runner then
+            local owner = owners[i]
+            setActive(owner, false, runner)
+            local resumed, marker, ok, err = resume(runner, dt)
+            if not resumed then
+                -- Died outside the pcall (e.g. out of memory); start over next frame
+                suspended[i] = false
+                setActive(nil, false)
+                reportError(owner, marker)
+                runners[i] = Runner(functions[i])
+            elseif marker == DONE then
+                suspended[i] = false
+                setActive(nil, false)
+                if not ok then
+                    reportError(owner, err)
+                end
+            else
+                -- Yielded by the budget hook (or the script itself); continues next frame
+                suspended[i] = true
+                setActive(nil, true)
+            end
+        end
+    end
+    updating = false
+end
+
+return Scheduler
+)";
+
+// Constructor
+LuaManager::LuaManager()
+    : ScriptPath(""), m_ScriptName("LUA_UNDEFINED"), m_LuaState(nullptr),
+      m_EnvironmentRef(LUA_NOREF), m_UsesSharedState(false),
+      m_OnInitRef(LUA_NOREF), m_OnUpdateRef(LUA_NOREF), m_UpdateThreadRef(LUA_NOREF), m_ThreadSafe(false), m_MemoryAccount(0),
+      m_InstructionsThisFrame(0), m_InstructionsLastFrame(0), m_CpuMsThisFrame(0.0), m_CpuMsLastFrame(0.0),
+      m_Suspended(false), m_BudgetYields(0), m_LastErrorMessage("")
+{
+    LiveManagers().push_back(this);
+}
+
+// Destructor
+LuaManager::~LuaManager()
+{
+    Shutdown();
+
+    std::vector<LuaManager *> &managers = LiveManagers();
+    managers.erase(std::remove(managers.begin(), managers.end(), this), managers.end());
+    if (s_ActiveManager == this)
+        s_ActiveManager = nullptr;
+}
+
+void *LuaManager::Allocate(void *userData, void *ptr, size_t oldSize, size_t newSize)
+{
+    std::vector<LuaMemoryAccount> &accounts = MemoryAccounts();
+    LuaBlockHeader *header = ptr ? static_cast<LuaBlockHeader *>(ptr) - 1 : nullptr;
+
+    if (newSize == 0)
+    {
+        if (header)
+        {
+            LuaMemoryAccount &account = accounts[header->Account];
+            account.Bytes -= std::min(account.Bytes, oldSize);
+            if (account.Released && account.Bytes == 0)
+            {
+                std::lock_guard<std::mutex> lock(AccountMutex());
+                FreeMemoryAccounts().push_back(header->Account);
+            }
+            MemoryTracker::RecordFree(MemoryTag::Lua, oldSize);
+            std::free(header);
+        }
+        return nullptr;
+    }
+
+    // Resized blocks stay with their owner; new ones go to the running script (or the state's default account)
+    uint32_t id;
+    if (header)
+        id = header->Account;
+    else if (s_ActiveManager && s_ActiveManager->m_LuaState)
+        id = s_ActiveManager->m_MemoryAccount;
+    else
+        id = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(userData));
+
+    size_t previous = header ? oldSize : 0; // For new blocks oldSize is the object type
+    LuaMemoryAccount &account = accounts[id];
+    if (newSize > previous && account.Limit > 0 && account.Bytes + (newSize - previous) > account.Limit)
+    {
+        // Lua turns this into a "not enough memory" error in the script
+        account.LimitHits++;
+        return nullptr;
+    }
+
+    LuaBlockHeader *block = static_cast<LuaBlockHeader *>(std::realloc(header, newSize + sizeof(LuaBlockHeader)));
+    if (!block)
+        return nullptr;
+
+    block->Account = id;
+    if (header)
+        MemoryTracker::RecordResize(MemoryTag::Lua, previous, newSize);
+    else
+        MemoryTracker::RecordAllocation(MemoryTag::Lua, newSize);
+    account.Bytes = account.Bytes - previous + newSize;
+    account.PeakBytes = std::max(account.PeakBytes, account.Bytes);
+    return block + 1;
+}
+
+static int LuaPanic(lua_State *L)
+{
+    const char *message = lua_tostring(L, -1);
+    (void)message; // Only read by DEBUG_PRINT
+    DEBUG_PRINT("LuaManager: PANIC: unprotected error in call to Lua API (%s)", message ? message : "error object is not a string");
+    return 0; // Return to Lua to abort
+}
+
+lua_State *LuaManager::NewState(uint32_t memoryAccount)
+{
+    lua_State *L = lua_newstate(Allocate, reinterpret_cast<void *>(static_cast<uintptr_t>(memoryAccount)));
+    if (!L)
+        return nullptr;
+
+    lua_atpanic(L, LuaPanic);
+
+    // Coroutines created later inherit the hook
+    lua_sethook(L, InstructionHook, LUA_MASKCOUNT, s_HookInterval);
+
+    ConfigureGC(L);
+    return L;
+}
+
+void LuaManager::ConfigureGC(lua_State *L)
+{
+    if (s_GCMode == LuaGCMode::Generational)
+        lua_gc(L, LUA_GCGEN, 0, 0);
+    else
+        lua_gc(L, LUA_GCINC, 0, 0, 0);
+
+    // Stopping only disables the allocation-driven steps; explicit steps and emergency collections still run
+    if (s_EngineDrivenGC)
+        lua_gc(L, LUA_GCSTOP, 0);
+    else
+        lua_gc(L, LUA_GCRESTART, 0);
+
+    LuaGCState &state = GCStates()[L];
+    state.BaselineBytes = LuaHeapBytes(L);
+    state.InCycle = false;
+}
+
+void LuaManager::SetGCMode(LuaGCMode mode)
+{
+    s_GCMode = mode;
+    for (auto &entry : GCStates())
+        ConfigureGC(entry.first);
+}
+
+void LuaManager::SetEngineDrivenGC(bool enabled)
+{
+    s_EngineDrivenGC = enabled;
+    for (auto &entry : GCStates())
+        ConfigureGC(entry.first);
+}
+
+double LuaManager::ComputeGCBudget(double frameWorkMs)
+{
+    return std::clamp(s_GCTargetFrameMs - frameWorkMs, s_GCMinBudgetMs, s_GCMaxBudgetMs);
+}
+
+void LuaManager::CollectGarbage(double budgetMs)
+{
+    PROFILE_ZONE("LuaGC");
+
+    using Clock = std::chrono::high_resolution_clock;
+    Clock::time_point start = Clock::now();
+
+    LuaGCStats stats;
+    stats.BudgetMs = budgetMs;
+
+    auto elapsedMs = [&start]()
+    { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    for (auto &entry : GCStates())
+    {
+        lua_State *L = entry.first;
+        LuaGCState &state = entry.second;
+        size_t heap = LuaHeapBytes(L);
+
+        if (s_EngineDrivenGC)
+        {
+            size_t growth = heap > state.BaselineBytes ? heap - state.BaselineBytes : 0;
+            bool forced = growth > state.BaselineBytes; // Heap doubled: can't wait for a quieter frame
+
+            if (s_GCMode == LuaGCMode::Generational)
+            {
+                bool due = growth * 100 > state.BaselineBytes * s_GCMinorGrowthPercent;
+                if (forced)
+                {
+                    // A young collection may leave the doubled heap in place; do a major one regardless of budget
+                    lua_gc(L, LUA_GCCOLLECT, 0);
+                    state.BaselineBytes = LuaHeapBytes(L);
+                    stats.Steps++;
+                    stats.Cycles++;
+                    if (elapsedMs() > budgetMs)
+                        stats.ForcedSteps++;
+                }
+                else if (due && elapsedMs() + state.StepMs <= budgetMs)
+                {
+                    // Size 0 runs one basic step (a young collection) even on a stopped collector;
+                    // a positive size only adds to the debt, which a stopped 5.4.4+ collector keeps negative
+                    Clock::time_point stepStart = Clock::now();
+                    bool completed = lua_gc(L, LUA_GCSTEP, 0) != 0;
+                    double stepMs = std::chrono::duration<double, std::milli>(Clock::now() - stepStart).count();
+                    state.StepMs = state.StepMs > 0.0 ? state.StepMs * 0.8 + stepMs * 0.2 : stepMs;
+                    stats.Steps++;
+
+                    // Re-arm the trigger only from a heap the step actually reduced, so a step that
+                    // freed nothing doesn't hide the growth from the next frame or the forced check
+                    size_t after = LuaHeapBytes(L);
+                    if (completed || after < heap)
+                    {
+                        state.BaselineBytes = after;
+                        if (completed)
+                            stats.Cycles++;
+                    }
+                }
+            }
+            else
+            {
+                if (!state.InCycle && growth * 100 > state.BaselineBytes * s_GCCycleGrowthPercent)
+                    state.InCycle = true;
+
+                bool first = true;
+                while (state.InCycle && (elapsedMs() < budgetMs || (forced && first)))
+                {
+                    if (elapsedMs() >= budgetMs)
+                        stats.ForcedSteps++;
+                    first = false;
+                    stats.Steps++;
+                    if (lua_gc(L, LUA_GCSTEP, 0))
+                    {
+                        state.InCycle = false;
+                        state.BaselineBytes = LuaHeapBytes(L);
+                        stats.Cycles++;
+                    }
+                }
+            }
+        }
+
+        stats.HeapBytes += LuaHeapBytes(L);
+    }
+
+    stats.Ms = elapsedMs();
+    s_GCStats = stats;
+}
+
+void LuaManager::InstructionHook(lua_State *L, lua_Debug *ar)
+{
+    LuaManager *manager = s_ActiveManager;
+    if (!manager || ar->event != LUA_HOOKCOUNT)
+        return;
+
+    manager->m_InstructionsThisFrame += s_HookInterval;
+    if (s_InstructionBudget <= 0 || manager->m_InstructionsThisFrame <= s_InstructionBudget)
+        return;
+
+    // Coroutines the script created itself are resumed by the script, not by the engine; yielding
+    // one would hand its resumer a spurious result, so those only count towards the hard limit
+    if (L == s_ActiveThread && lua_isyieldable(L))
+    {
+        manager->m_Suspended = true;
+        manager->m_BudgetYields++;
+        lua_yield(L, 0);
+        return;
+    }
+
+    if (manager->m_InstructionsThisFrame > s_InstructionBudget * s_NonYieldableBudgetFactor)
+        luaL_error(L, "instruction budget exceeded (%lld instructions)", manager->m_InstructionsThisFrame);
+}
+
+void LuaManager::RollFrameStats()
+{
+    m_InstructionsLastFrame = m_InstructionsThisFrame;
+    m_CpuMsLastFrame = m_CpuMsThisFrame;
+    m_InstructionsThisFrame = 0;
+    m_CpuMsThisFrame = 0.0;
+}
+
+void LuaManager::SetMemoryLimit(size_t bytes)
+{
+    s_MemoryLimit = bytes;
+    for (LuaManager *manager : LiveManagers())
+    {
+        if (manager->m_MemoryAccount != 0)
+            MemoryAccounts()[manager->m_MemoryAccount].Limit = bytes;
+    }
+}
+
+std::vector<LuaScriptStats> LuaManager::GetScriptStats()
+{
+    std::vector<LuaScriptStats> stats;
+    for (const LuaManager *manager : LiveManagers())
+    {
+        if (!manager->m_LuaState)
+            continue;
+
+        const LuaMemoryAccount &account = MemoryAccounts()[manager->m_MemoryAccount];
+        LuaScriptStats entry;
+        entry.Name = manager->m_ScriptName;
+        entry.Path = manager->ScriptPath;
+        entry.Shared = manager->m_UsesSharedState;
+        entry.MemoryBytes = account.Bytes;
+        entry.PeakMemoryBytes = account.PeakBytes;
+        entry.MemoryLimit = account.Limit;
+        entry.MemoryLimitHits = account.LimitHits;
+        entry.Instructions = manager->m_InstructionsLastFrame;
+        entry.CpuMs = manager->m_CpuMsLastFrame;
+        entry.Suspended = manager->m_Suspended;
+        entry.BudgetYields = manager->m_BudgetYields;
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+size_t LuaManager::GetEngineMemoryBytes()
+{
+    return MemoryAccounts()[0].Bytes;
+}
+
+void LuaManager::Shutdown()
+{
+    if (!m_LuaState)
+    {
+        ReleaseMemoryAccount(m_MemoryAccount);
+        m_MemoryAccount = 0;
+        return;
+    }
+
+    StopTasks();
+    ReleaseLifecycleFunctions();
+
+    if (m_UsesSharedState)
+    {
+        // The environment (and everything the script defined) becomes garbage
+        luaL_unref(m_LuaState, LUA_REGISTRYINDEX, m_EnvironmentRef);
+    }
+    else
+    {
+        GCStates().erase(m_LuaState);
+        lua_close(m_LuaState);
+    }
+
+    m_LuaState = nullptr;
+    m_EnvironmentRef = LUA_NOREF;
+    m_UpdateThreadRef = LUA_NOREF;
+    m_UsesSharedState = false;
+    m_Suspended = false;
+
+    // In shared mode the script's blocks stay charged until the GC collects them
+    ReleaseMemoryAccount(m_MemoryAccount);
+    m_MemoryAccount = 0;
+}
+
+void LuaManager::PushEnvironment(lua_State *L)
+{
+    if (m_UsesSharedState)
+        lua_rawgeti(L, LUA_REGISTRYINDEX, m_EnvironmentRef);
+    else
+        lua_pushglobaltable(L);
+}
+
+void LuaManager::SetupState()
+{
+    // Open Lua standard libraries
+    luaL_openlibs(m_LuaState);
+
+    // Register all necessary metatables
+    RegisterAllMetatables();
+
+    // Create the Engine table
+    RegisterEngineTable();
+
+    CreateHandleCache(m_LuaState);
+
+    // Metatable shared by every per-script environment: unknown names resolve through _G
+    luaL_newmetatable(m_LuaState, "ScriptEnvironmentMetaTable");
+    lua_pushglobaltable(m_LuaState);
+    lua_setfield(m_LuaState, -2, "__index");
+    lua_pop(m_LuaState, 1);
+}
+
+lua_State *LuaManager::GetSharedState()
+{
+    if (!s_SharedState)
+    {
+        LuaManager setup;
+        setup.m_LuaState = NewState(0);
+        if (!setup.m_LuaState)
+            return nullptr;
+        setup.SetupState();
+        CreateScheduler(setup.m_LuaState);
+
+        s_SharedState = setup.m_LuaState;
+        setup.m_LuaState = nullptr; // Owned by s_SharedState now
+    }
+    return s_SharedState;
+}
+
+void LuaManager::ShutdownSharedState()
+{
+    if (s_SharedState)
+    {
+        GCStates().erase(s_SharedState);
+        lua_close(s_SharedState);
+        s_SharedState = nullptr;
+        s_SchedulerRef = LUA_NOREF;
+        s_SchedulerUpdateRef = LUA_NOREF;
+    }
+}
+
+bool LuaManager::CreateScheduler(lua_State *L)
+{
+    if (luaL_loadbuffer(L, s_SchedulerSource, std::strlen(s_SchedulerSource), "=Scheduler") != LUA_OK)
+    {
+        DEBUG_PRINT("LuaManager: Failed to load scheduler: %s", lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return false;
+    }
+
+    lua_pushcfunction(L, Lua_Scheduler_SetActive);
+    lua_pushcfunction(L, Lua_Scheduler_ReportError);
+    if (lua_pcall(L, 2, 1, 0) != LUA_OK)
+    {
+        DEBUG_PRINT("LuaManager: Failed to create scheduler: %s", lua_tostring(L, -1));
+        lua_pop(L, 1);
+        return false;
+    }
+
+    lua_getfield(L, -1, "Update");
+    s_SchedulerUpdateRef = luaL_ref(L, LUA_REGISTRYINDEX);
+    s_SchedulerRef = luaL_ref(L, LUA_REGISTRYINDEX);
+    return true;
+}
+
+void LuaManager::CallScheduler(const char *method, bool passUpdate)
+{
+    if (!m_UsesSharedState || s_SchedulerRef == LUA_NOREF)
+        return;
+
+    lua_rawgeti(m_LuaState, LUA_REGISTRYINDEX, s_SchedulerRef);
+    lua_getfield(m_LuaState, -1, method);
+    lua_remove(m_LuaState, -2);
+    lua_pushlightuserdata(m_LuaState, this);
+    int args = 1;
+    if (passUpdate)
+    {
+        lua_rawgeti(m_LuaState, LUA_REGISTRYINDEX, m_OnUpdateRef);
+        args++;
+    }
+    if (lua_pcall(m_LuaState, args, 0, 0) != LUA_OK)
+    {
+        ReportError(std::string("Scheduler.") + method, lua_tostring(m_LuaState, -1));
+        lua_pop(m_LuaState, 1);
+    }
+}
+
+void LuaManager::RefreshLifecycleFunctions()
+{
+    ReleaseLifecycleFunctions();
+
+    // Only the script's own definitions count, not whatever _G happens to hold
+    PushEnvironment(m_LuaState);
+
+    lua_pushstring(m_LuaState, "OnInit");
+    lua_rawget(m_LuaState, -2);
+    if (lua_isfunction(m_LuaState, -1))
+        m_OnInitRef = luaL_ref(m_LuaState, LUA_REGISTRYINDEX);
+    else
+        lua_pop(m_LuaState, 1);
+
+    lua_pushstring(m_LuaState, "OnUpdate");
+    lua_rawget(m_LuaState, -2);
+    if (lua_isfunction(m_LuaState, -1))
+        m_OnUpdateRef = luaL_ref(m_LuaState, LUA_REGISTRYINDEX);
+    else
+        lua_pop(m_LuaState, 1);
+
+    lua_pop(m_LuaState, 1); // Environment
+
+    if (HasUpdate())
+        CallScheduler("Add", true);
+}
+
+void LuaManager::ReleaseLifecycleFunctions()
+{
+    if (HasUpdate())
+        CallScheduler("Remove", false);
+
+    luaL_unref(m_LuaState, LUA_REGISTRYINDEX, m_OnInitRef);
+    luaL_unref(m_LuaState, LUA_REGISTRYINDEX, m_OnUpdateRef);
+    luaL_unref(m_LuaState, LUA_REGISTRYINDEX, m_UpdateThreadRef);
+    m_OnInitRef = LUA_NOREF;
+    m_OnUpdateRef = LUA_NOREF;
+    m_UpdateThreadRef = LUA_NOREF;
+    m_Suspended = false;
+}
+
+void LuaManager::ReportError(const std::string &context, const char *message)
+{
+    std::string errorMsg = message ? message : "Unknown error";
+
+    // Prevent duplicate error logs
+    if (errorMsg == m_LastErrorMessage)
+        return;
+
+    if (g_LoggerWindow)
+    {
+        std::string formattedError = "LuaManager Error in " + context + ": " + errorMsg;
+        g_LoggerWindow->AddLog(formattedError.c_str(), std::optional<ImVec4>(ImVec4(1.0f, 0.0f, 0.0f, 1.0f)));
+    }
+    else
+    {
+        DEBUG_PRINT("LuaManager Error in %s: %s", context.c_str(), errorMsg.c_str());
+    }
+    m_LastErrorMessage = errorMsg;
+}
+
+// setActive(owner, false, runner) before a script runs, setActive(nil, suspended) after it
+int LuaManager::Lua_Scheduler_SetActive(lua_State *L)
+{
+    auto now = std::chrono::high_resolution_clock::now();
+    if (s_ActiveManager)
+    {
+        s_ActiveManager->m_CpuMsThisFrame += std::chrono::duration<double, std::milli>(now - s_ActiveStart).count();
+        s_ActiveManager->m_Suspended = lua_toboolean(L, 2);
+    }
+
+    s_ActiveManager = static_cast<LuaManager *>(lua_touserdata(L, 1));
+    s_ActiveThread = lua_tothread(L, 3);
+    s_ActiveStart = now;
+    return 0;
+}
+
+int LuaManager::Lua_Scheduler_ReportError(lua_State *L)
+{
+    LuaManager *manager = static_cast<LuaManager *>(lua_touserdata(L, 1));
+    if (manager)
+        manager->ReportError("OnUpdate", lua_tostring(L, 2));
+    return 0;
+}
+
+void LuaManager::UpdateAll(float deltaTime)
+{
+    if (!s_SharedState || s_SchedulerUpdateRef == LUA_NOREF)
+    {
+        UpdateTasks(deltaTime);
+        return;
+    }
+
+    for (LuaManager *manager : LiveManagers())
+    {
+        if (manager->m_UsesSharedState)
+            manager->RollFrameStats();
+    }
+
+    ActiveScope scope(nullptr);
+
+    lua_rawgeti(s_SharedState, LUA_REGISTRYINDEX, s_SchedulerUpdateRef);
+    lua_pushnumber(s_SharedState, deltaTime);
+    if (lua_pcall(s_SharedState, 1, 0, 0) != LUA_OK)
+    {
+        // Script errors are caught per script; this only fails on e.g. out of memory
+        DEBUG_PRINT("LuaManager: Scheduler update failed: %s", lua_tostring(s_SharedState, -1));
+        lua_pop(s_SharedState, 1);
+    }
+
+    UpdateTasks(deltaTime);
+}
+
+void LuaManager::UpdateParallel(float deltaTime)
+{
+    static std::vector<LuaManager *> scripts;
+    static std::vector<std::vector<LuaTransformCommand>> commands;
+
+    scripts.clear();
+    for (LuaManager *manager : LiveManagers())
+    {
+        if (manager->RunsInParallel() && manager->HasUpdate())
+            scripts.push_back(manager);
+    }
+    if (scripts.empty())
+        return;
+
+    if (commands.size() < scripts.size())
+        commands.resize(scripts.size());
+
+    // The scene is not modified while the jobs run, so every script reads the same snapshot
+    JobSystem::Get().ParallelFor(scripts.size(), [deltaTime](size_t i)
+                                 {
+        commands[i].clear();
+        s_TransformCommands = &commands[i];
+        scripts[i]->Update(deltaTime);
+        s_TransformCommands = nullptr; });
+
+    // Apply in script order, not completion order
+    for (size_t i = 0; i < scripts.size(); ++i)
+    {
+        for (const LuaTransformCommand &command : commands[i])
+        {
+            Component *component = static_cast<Component *>(EntityRegistry::Get().Resolve(command.Transform));
+            if (!component)
+                continue;
+
+            TransformComponent *transform = static_cast<TransformComponent *>(component);
+            if (command.Rotation)
+                transform->SetRotation(command.Value.x, command.Value.y, command.Value.z);
+            else
+                transform->SetPosition(command.Value.x, command.Value.y, command.Value.z);
+        }
+    }
+}
+
+// What a coroutine task is waiting for
+enum class LuaTaskWait
+{
+    None,
+    Time,
+    Frames,
+    Load
+};
+
+// Engine.LoadAsync request of a task
+struct LuaAsyncLoad
+{
+    std::string Path;
+    EntityHandle Mesh;                             // MeshComponent that receives the model, if any
+    std::future<std::unique_ptr<ParsedModel>> Parsed; // ParseModel on a worker thread; nullptr if the file can't be opened
+};
+
+// Coroutine started with Engine.StartCoroutine
+struct LuaTask
+{
+    lua_State *Thread = nullptr; // nullptr: free slot
+    int ThreadRef = LUA_NOREF;   // Keeps the coroutine alive; in the owner state's registry
+    LuaManager *Owner = nullptr;
+    uint32_t Generation = 1;
+    LuaTaskWait Wait = LuaTaskWait::None;
+    bool Running = false;   // On the C stack (resumed, possibly resuming another task)
+    bool Cancelled = false; // Stopped while running; freed once it yields or returns
+    std::unique_ptr<LuaAsyncLoad> Load;
+};
+
+// Timer heap entry. Stopping a task bumps its generation, which turns its entries stale instead of searching the heap.
+struct LuaTaskTimer
+{
+    double Due; // Game time in seconds, or frame number
+    uint64_t Sequence;
+    uint32_t Task;
+    uint32_t Generation;
+
+    // Earliest first; equal due times resume in the order they were scheduled
+    bool operator>(const LuaTaskTimer &other) const
+    {
+        return Due != other.Due ? Due > other.Due : Sequence > other.Sequence;
+    }
+};
+
+using LuaTaskHeap = std::vector<LuaTaskTimer>;
+
+// Deliberately leaked like the memory accounts
+static std::vector<LuaTask> &Tasks()
+{
+    static std::vector<LuaTask> *tasks = new std::vector<LuaTask>();
+    return *tasks;
+}
+
+static std::vector<uint32_t> &FreeTasks()
+{
+    static std::vector<uint32_t> *freeTasks = new std::vector<uint32_t>();
+    return *freeTasks;
+}
+
+static LuaTaskHeap s_TimeHeap;
+static LuaTaskHeap s_FrameHeap;
+static std::vector<std::pair<uint32_t, uint32_t>> s_LoadingTasks; // (task, generation)
+static double s_TaskClock = 0.0;
+static uint64_t s_TaskFrame = 0;
+static uint64_t s_TaskSequence = 0;
+static size_t s_TaskCount = 0;
+
+static const uint32_t s_NoTask = UINT32_MAX;
+static uint32_t s_RunningTask = s_NoTask;
+
+// Finished loads handed to scripts per frame; each one uploads its textures and buffers on the main thread
+static const int s_MaxLoadsPerFrame = 1;
+
+// Value Lua scripts get for a task: slot in the high half, generation in the low half
+static lua_Integer TaskHandle(uint32_t id)
+{
+    return static_cast<lua_Integer>((static_cast<uint64_t>(id) << 32) | Tasks()[id].Generation);
+}
+
+static bool IsTaskLive(uint32_t id, uint32_t generation)
+{
+    return id < Tasks().size() && Tasks()[id].Thread && Tasks()[id].Generation == generation;
+}
+
+static uint32_t AllocateTask(LuaManager *owner, lua_State *thread, int threadRef)
+{
+    uint32_t id;
+    if (!FreeTasks().empty())
+    {
+        id = FreeTasks().back();
+        FreeTasks().pop_back();
+    }
+    else
+    {
+        id = static_cast<uint32_t>(Tasks().size());
+        Tasks().emplace_back();
+    }
+
+    LuaTask &task = Tasks()[id];
+    task.Thread = thread;
+    task.ThreadRef = threadRef;
+    task.Owner = owner;
+    task.Wait = LuaTaskWait::None;
+    task.Running = false;
+    task.Cancelled = false;
+    s_TaskCount++;
+    return id;
+}
+
+// `state` is the state the thread reference lives in, or nullptr if it is already closed
+static void FreeTask(uint32_t id, lua_State *state)
+{
+    LuaTask &task = Tasks()[id];
+    if (!task.Thread)
+        return;
+
+    if (state)
+        luaL_unref(state, LUA_REGISTRYINDEX, task.ThreadRef);
+
+    task.Thread = nullptr;
+    task.ThreadRef = LUA_NOREF;
+    task.Owner = nullptr;
+    task.Wait = LuaTaskWait::None;
+    task.Running = false;
+    task.Cancelled = false;
+    task.Load.reset(); // Waits for the file read if it is still going
+
+    if (++task.Generation == 0)
+        task.Generation = 1;
+
+    FreeTasks().push_back(id);
+    s_TaskCount--;
+}
+
+static void Schedule(LuaTaskHeap &heap, double due, uint32_t id)
+{
+    heap.push_back({due, s_TaskSequence++, id, Tasks()[id].Generation});
+    std::push_heap(heap.begin(), heap.end(), std::greater<LuaTaskTimer>());
+}
+
+// Pops every entry due by `now` that still belongs to a task waiting on `wait`
+static void PopDue(LuaTaskHeap &heap, double now, LuaTaskWait wait, std::vector<std::pair<uint32_t, uint32_t>> &due)
+{
+    while (!heap.empty() && heap.front().Due <= now)
+    {
+        LuaTaskTimer timer = heap.front();
+        std::pop_heap(heap.begin(), heap.end(), std::greater<LuaTaskTimer>());
+        heap.pop_back();
+
+        if (IsTaskLive(timer.Task, timer.Generation) && Tasks()[timer.Task].Wait == wait)
+            due.emplace_back(timer.Task, timer.Generation);
+    }
+}
+
+// The task whose coroutine is `L`; raises a Lua error when called from anywhere else
+static uint32_t CheckRunningTask(lua_State *L, const char *function)
+{
+    if (s_TransformCommands)
+        luaL_error(L, "%s is not available in a thread-safe script's OnUpdate", function);
+    if (s_RunningTask == s_NoTask || Tasks()[s_RunningTask].Thread != L)
+        luaL_error(L, "%s can only be called from a coroutine started with Engine.StartCoroutine", function);
+    return s_RunningTask;
+}
+
+size_t LuaManager::GetTaskCount()
+{
+    return s_TaskCount;
+}
+
+void LuaManager::ResumeTask(uint32_t id, int nargs)
+{
+    lua_State *thread = Tasks()[id].Thread;
+    LuaManager *owner = Tasks()[id].Owner;
+    Tasks()[id].Wait = LuaTaskWait::None;
+    Tasks()[id].Running = true;
+
+    // Started from inside a running script: that script's timing already covers this
+    bool outermost = s_ActiveManager == nullptr;
+
+    uint32_t previousTask = s_RunningTask;
+    s_RunningTask = id;
+    lua_State *previousThread = s_ActiveThread;
+    s_ActiveThread = thread;
+
+    int results = 0;
+    int status;
+    {
+        ActiveScope scope(owner);
+        auto start = std::chrono::high_resolution_clock::now();
+        status = lua_resume(thread, nullptr, nargs, &results);
+        if (outermost && Tasks()[id].Owner)
+            owner->m_CpuMsThisFrame += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    s_RunningTask = previousTask;
+    s_ActiveThread = previousThread;
+
+    // The vector may have grown while the coroutine ran, so look the task up again
+    LuaTask &task = Tasks()[id];
+    task.Running = false;
+    lua_State *state = task.Owner ? task.Owner->m_LuaState : nullptr;
+
+    if (status == LUA_YIELD && !task.Cancelled)
+    {
+        lua_pop(thread, results);
+
+        // A plain coroutine.yield() or a budget suspension continues next frame
+        if (task.Wait == LuaTaskWait::None)
+        {
+            task.Wait = LuaTaskWait::Frames;
+            Schedule(s_FrameHeap, static_cast<double>(s_TaskFrame + 1), id);
+        }
+        return;
+    }
+
+    if (status != LUA_OK && status != LUA_YIELD && task.Owner)
+        task.Owner->ReportError("coroutine", lua_tostring(thread, -1));
+
+    FreeTask(id, state);
+}
+
+void LuaManager::StopTasks()
+{
+    std::vector<LuaTask> &tasks = Tasks();
+    for (uint32_t id = 0; id < tasks.size(); ++id)
+    {
+        if (tasks[id].Owner != this || !tasks[id].Thread)
+            continue;
 
-std::string LuaManager::m_ScriptName = "LUA_UNDEFINED";
-std::unordered_map<std::string, LuaManager::LuaExposedVariant> LuaManager::m_ExposedVariables;
+        if (tasks[id].Running)
+        {
+            // Can't free a coroutine that is on the C stack; ResumeTask does it when it returns
+            tasks[id].Cancelled = true;
+            tasks[id].Owner = nullptr;
+            luaL_unref(m_LuaState, LUA_REGISTRYINDEX, tasks[id].ThreadRef);
+            tasks[id].ThreadRef = LUA_NOREF;
+            continue;
+        }
+        FreeTask(id, m_LuaState);
+    }
+}
 
+void LuaManager::CompleteLoad(uint32_t id)
+{
+    LuaTask &task = Tasks()[id];
+    std::unique_ptr<LuaAsyncLoad> load = std::move(task.Load);
+    lua_State *thread = task.Thread;
 
-// Constructor
-LuaManager::LuaManager()
-    : ScriptPath(""), m_LuaState(nullptr), m_LastErrorMessage("")
+    std::unique_ptr<ParsedModel> parsed = load->Parsed.get();
+    if (!parsed)
+    {
+        lua_pushboolean(thread, 0);
+        lua_pushfstring(thread, "cannot open %s", load->Path.c_str());
+        ResumeTask(id, 2);
+        return;
+    }
+
+    // Only the texture and buffer uploads happen here, on the main thread
+    std::shared_ptr<Model> model = g_AssetManager.FinishModelLoad(*parsed);
+
+    int submeshCount = static_cast<int>(model->submeshes.size());
+
+    // The mesh may have been destroyed while loading; the result is simply dropped then
+    Component *component = static_cast<Component *>(EntityRegistry::Get().Resolve(load->Mesh));
+    if (MeshComponent *mesh = dynamic_cast<MeshComponent *>(component))
+    {
+        mesh->ReleaseSubmeshes();
+        mesh->MeshPath = load->Path;
+        mesh->submeshes = std::move(model->submeshes);
+        mesh->CurrentLOD = 0;
+    }
+
+    lua_pushboolean(thread, 1);
+    lua_pushinteger(thread, submeshCount);
+    ResumeTask(id, 2);
+}
+
+void LuaManager::UpdateTasks(float deltaTime)
+{
+    if (s_TaskCount == 0)
+    {
+        s_TaskClock += deltaTime;
+        s_TaskFrame++;
+        return;
+    }
+
+    PROFILE_ZONE("LuaTasks");
+
+    s_TaskClock += deltaTime;
+
+    // Collect first, so a task that waits again while being resumed isn't picked up twice this frame
+    static std::vector<std::pair<uint32_t, uint32_t>> due;
+    due.clear();
+    PopDue(s_TimeHeap, s_TaskClock, LuaTaskWait::Time, due);
+    PopDue(s_FrameHeap, static_cast<double>(s_TaskFrame), LuaTaskWait::Frames, due);
+
+    std::vector<std::pair<uint32_t, uint32_t>> loaded;
+    size_t kept = 0;
+    for (const auto &[id, generation] : s_LoadingTasks)
+    {
+        if (!IsTaskLive(id, generation) || Tasks()[id].Wait != LuaTaskWait::Load)
+            continue;
+
+        std::future<std::unique_ptr<ParsedModel>> &parsed = Tasks()[id].Load->Parsed;
+        if (static_cast<int>(loaded.size()) < s_MaxLoadsPerFrame &&
+            parsed.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            loaded.emplace_back(id, generation);
+        else
+            s_LoadingTasks[kept++] = {id, generation};
+    }
+    s_LoadingTasks.resize(kept);
+
+    for (const auto &[id, generation] : due)
+    {
+        // An earlier task may have stopped this one
+        if (IsTaskLive(id, generation) && !Tasks()[id].Cancelled)
+            ResumeTask(id, 0);
+    }
+
+    for (const auto &[id, generation] : loaded)
+    {
+        if (IsTaskLive(id, generation) && !Tasks()[id].Cancelled)
+            CompleteLoad(id);
+    }
+
+    s_TaskFrame++;
+}
+
+// Engine.StartCoroutine(fn, ...): runs fn as a coroutine until its first wait and returns a handle for StopCoroutine
+int LuaManager::Lua_Engine_StartCoroutine(lua_State *L)
 {
+    luaL_checktype(L, 1, LUA_TFUNCTION);
+
+    // The task list belongs to the main thread
+    if (s_TransformCommands)
+        return luaL_error(L, "Engine.StartCoroutine is not available in a thread-safe script's OnUpdate");
+
+    LuaManager *owner = s_ActiveManager;
+    if (!owner || !owner->m_LuaState)
+        return luaL_error(L, "Engine.StartCoroutine needs a running script");
+
+    int nargs = lua_gettop(L) - 1;
+
+    lua_State *thread = lua_newthread(L);
+    lua_pushvalue(L, -1);
+    int threadRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+    // Move the function and its arguments onto the new coroutine
+    lua_insert(L, 1);
+    lua_xmove(L, thread, nargs + 1);
+
+    uint32_t id = AllocateTask(owner, thread, threadRef);
+    lua_Integer handle = TaskHandle(id);
+    ResumeTask(id, nargs);
+
+    lua_pushinteger(L, handle);
+    return 1;
 }
 
-// Destructor
-LuaManager::~LuaManager()
+// Engine.StopCoroutine(handle)
+int LuaManager::Lua_Engine_StopCoroutine(lua_State *L)
 {
-    if (m_LuaState)
+    if (s_TransformCommands)
+        return luaL_error(L, "Engine.StopCoroutine is not available in a thread-safe script's OnUpdate");
+
+    uint64_t handle = static_cast<uint64_t>(luaL_checkinteger(L, 1));
+    uint32_t id = static_cast<uint32_t>(handle >> 32);
+    uint32_t generation = static_cast<uint32_t>(handle & 0xffffffffu);
+
+    if (!IsTaskLive(id, generation))
+        return 0;
+
+    LuaTask &task = Tasks()[id];
+    if (task.Running)
     {
-        lua_close(m_LuaState);
-        m_LuaState = nullptr;
+        // Freed by ResumeTask once the coroutine is off the C stack; a task stopping itself ends right here
+        task.Cancelled = true;
+        return task.Thread == L ? lua_yield(L, 0) : 0;
+    }
+
+    FreeTask(id, task.Owner ? task.Owner->m_LuaState : nullptr);
+    return 0;
+}
+
+// Engine.Wait(seconds): resumes after `seconds` of game time
+int LuaManager::Lua_Engine_Wait(lua_State *L)
+{
+    double seconds = luaL_checknumber(L, 1);
+    uint32_t id = CheckRunningTask(L, "Engine.Wait");
+
+    Tasks()[id].Wait = LuaTaskWait::Time;
+    Schedule(s_TimeHeap, s_TaskClock + std::max(0.0, seconds), id);
+    return lua_yield(L, 0);
+}
+
+// Engine.WaitFrames(n): resumes n frames later (at least one)
+int LuaManager::Lua_Engine_WaitFrames(lua_State *L)
+{
+    lua_Integer frames = luaL_optinteger(L, 1, 1);
+    uint32_t id = CheckRunningTask(L, "Engine.WaitFrames");
+
+    Tasks()[id].Wait = LuaTaskWait::Frames;
+    Schedule(s_FrameHeap, static_cast<double>(s_TaskFrame + std::max<lua_Integer>(1, frames)), id);
+    return lua_yield(L, 0);
+}
+
+// Engine.LoadAsync(path[, mesh]) -> true, submeshCount | false, message
+// The model is parsed and prepared (optimization, meshlets, LODs, texture decoding) on a worker
+// thread; the main thread only uploads it and, if a Mesh component was passed, assigns it.
+int LuaManager::Lua_Engine_LoadAsync(lua_State *L)
+{
+    std::string path = luaL_checkstring(L, 1);
+    EntityHandle mesh;
+    if (!lua_isnoneornil(L, 2))
+        mesh = CheckComponent<MeshComponent>(L, 2, "MeshMetaTable")->GetHandle();
+
+    uint32_t id = CheckRunningTask(L, "Engine.LoadAsync");
+
+    auto load = std::make_unique<LuaAsyncLoad>();
+    load->Path = path;
+    load->Mesh = mesh;
+    load->Parsed = std::async(std::launch::async, [path, options = g_AssetManager.GetModelParseOptions()]()
+                              {
+        MemoryTagScope memoryTag(MemoryTag::Assets);
+        return ParseModel(path, options); });
+
+    LuaTask &task = Tasks()[id];
+    task.Load = std::move(load);
+    task.Wait = LuaTaskWait::Load;
+    s_LoadingTasks.emplace_back(id, task.Generation);
+    return lua_yield(L, 0);
+}
+
+// Engine.CaptureTrace(frames[, path]) -> path | nil
+// Records the next `frames` frames of profiler zones into a Chrome trace JSON file
+int LuaManager::Lua_Engine_CaptureTrace(lua_State *L)
+{
+    lua_Integer frames = luaL_checkinteger(L, 1);
+    std::string path = luaL_optstring(L, 2, "");
+    if (frames <= 0)
+        return luaL_argerror(L, 1, "frame count must be positive");
+
+    if (path.empty())
+        path = Profiler::DefaultCapturePath();
+    if (!Profiler::Get().BeginCapture(static_cast<int>(std::min<lua_Integer>(frames, INT32_MAX)), path))
+    {
+        lua_pushnil(L);
+        return 1;
     }
+
+    lua_pushstring(L, path.c_str());
+    return 1;
 }
 
 // Initialize the LuaManager with the given script path
 bool LuaManager::Initialize(const std::string &scriptPath)
 {
+    MemoryTagScope memoryTag(MemoryTag::Lua);
+
     if (scriptPath.empty())
     {
         if (g_LoggerWindow)
@@ -60,12 +1348,31 @@ bool LuaManager::Initialize(const std::string &scriptPath)
         return false;
     }
 
+    // Re-initialization (e.g. Deserialize after construction) replaces the previous script
+    Shutdown();
+    m_ExposedVariables.clear();
+
     ScriptPath = scriptPath;
 
     m_ScriptName = std::filesystem::path(scriptPath).filename().string();
 
-    // Create a new Lua state
-    m_LuaState = luaL_newstate();
+    m_MemoryAccount = AcquireMemoryAccount(s_MemoryLimit);
+    m_InstructionsThisFrame = 0;
+
+    // Thread-safe scripts need a state of their own to run on a worker
+    m_UsesSharedState = s_SharedStateEnabled && !m_ThreadSafe;
+    if (m_UsesSharedState)
+    {
+        m_LuaState = GetSharedState();
+    }
+    else
+    {
+        // Create a new Lua state; everything in it is charged to the script
+        m_LuaState = NewState(m_MemoryAccount);
+        if (m_LuaState)
+            SetupState();
+    }
+
     if (!m_LuaState)
     {
         if (g_LoggerWindow)
@@ -76,39 +1383,31 @@ bool LuaManager::Initialize(const std::string &scriptPath)
         {
             DEBUG_PRINT("LuaManager: Failed to create Lua state.");
         }
+        m_UsesSharedState = false;
         return false;
     }
 
-    // Open Lua standard libraries
-    luaL_openlibs(m_LuaState);
-
-    // Register all necessary metatables
-    RegisterAllMetatables();
-
-    // Create the Engine table
-    lua_newtable(m_LuaState);
-    lua_setglobal(m_LuaState, "_T_Engine_Table");
-
-    // Bind the Log function to the Engine table
-    lua_getglobal(m_LuaState, "_T_Engine_Table");
-    lua_pushcfunction(m_LuaState, Lua_Engine_Log);
-    lua_setfield(m_LuaState, -2, "Log");
-
-    lua_pushcfunction(m_LuaState, Lua_Engine_Expose);
-    lua_setfield(m_LuaState, -2, "Expose");
-
-    // Add the ScriptName binding
-    lua_pushcfunction(m_LuaState, Lua_Engine_ScriptName);
-    lua_setfield(m_LuaState, -2, "ScriptName");
+    ActiveScope scope(this);
 
-    // Bind the GetGameObjectByTag function to the Engine table
-    lua_pushcfunction(m_LuaState, Lua_Engine_GetGameObjectByTag);
-    lua_setfield(m_LuaState, -2, "GetGameObjectByTag");
+    if (m_UsesSharedState)
+    {
+        // Private _ENV for the script
+        lua_newtable(m_LuaState);
+        luaL_setmetatable(m_LuaState, "ScriptEnvironmentMetaTable");
+        m_EnvironmentRef = luaL_ref(m_LuaState, LUA_REGISTRYINDEX);
+    }
 
-    lua_pop(m_LuaState, 1); // Pop the Engine table from the stack
+    // Load the Lua script (bytecode when the source is unchanged), bind its _ENV (the main chunk's first upvalue) and run it
+    int status = LuaBytecodeCache::Get().Load(m_LuaState, ScriptPath);
+    if (status == LUA_OK)
+    {
+        PushEnvironment(m_LuaState);
+        if (!lua_setupvalue(m_LuaState, -2, 1))
+            lua_pop(m_LuaState, 1);
+        status = lua_pcall(m_LuaState, 0, 0, 0);
+    }
 
-    // Execute the Lua script
-    if (luaL_dofile(m_LuaState, ScriptPath.c_str()) != LUA_OK)
+    if (status != LUA_OK)
     {
         const char *luaError = lua_tostring(m_LuaState, -1);
         if (luaError)
@@ -149,12 +1448,83 @@ bool LuaManager::Initialize(const std::string &scriptPath)
     // Reset last error message on successful script execution
     m_LastErrorMessage.clear();
 
+    RefreshLifecycleFunctions();
+
     // Log successful initialization
     DEBUG_PRINT("LuaManager initialized successfully with script: %s", ScriptPath.c_str());
 
     return true;
 }
 
+LuaInitBenchmark LuaManager::BenchmarkInitialization(const std::string &scriptPath, int count, bool shared)
+{
+    LuaInitBenchmark result;
+    result.Scripts = count;
+    result.Shared = shared;
+
+    bool previousMode = s_SharedStateEnabled;
+    s_SharedStateEnabled = shared;
+
+    size_t baseBytes = 0;
+    if (shared)
+    {
+        lua_State *L = GetSharedState();
+        if (L)
+        {
+            lua_gc(L, LUA_GCCOLLECT, 0);
+            baseBytes = LuaHeapBytes(L);
+        }
+        result.SharedBaseBytes = baseBytes;
+    }
+
+    std::vector<std::unique_ptr<LuaManager>> managers;
+    managers.reserve(count);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < count; ++i)
+    {
+        managers.push_back(std::make_unique<LuaManager>());
+        if (!managers.back()->Initialize(scriptPath))
+            result.Failures++;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    if (shared)
+    {
+        lua_State *L = GetSharedState();
+        if (L)
+        {
+            lua_gc(L, LUA_GCCOLLECT, 0);
+            result.TotalBytes = LuaHeapBytes(L) - std::min(baseBytes, LuaHeapBytes(L));
+        }
+    }
+    else
+    {
+        for (const auto &manager : managers)
+        {
+            if (manager->m_LuaState)
+            {
+                lua_gc(manager->m_LuaState, LUA_GCCOLLECT, 0);
+                result.TotalBytes += LuaHeapBytes(manager->m_LuaState);
+            }
+        }
+    }
+
+    result.TotalMs = std::chrono::duration<double, std::milli>(end - start).count();
+    if (count > 0)
+    {
+        result.PerScriptUs = result.TotalMs * 1000.0 / count;
+        result.BytesPerScript = static_cast<double>(result.TotalBytes) / count;
+    }
+
+    managers.clear();
+    if (shared && GetSharedState())
+        lua_gc(GetSharedState(), LUA_GCCOLLECT, 0);
+
+    s_SharedStateEnabled = previousMode;
+    return result;
+}
+
 std::unordered_map<std::string, LuaManager::LuaExposedVariant> LuaManager::GetExposedVariables() {
     return m_ExposedVariables;
 }
@@ -168,8 +1538,8 @@ void LuaManager::UpdateVariable(const std::string &name, const LuaManager::LuaEx
     // Update the variable in the map
     m_ExposedVariables[name] = value;
 
-    // Push the variable to the Lua global environment
-    lua_pushglobaltable(m_LuaState); // Push the global table
+    // Push the variable to the script's environment
+    PushEnvironment(m_LuaState);
 
     // Push the variable name
     lua_pushstring(m_LuaState, name.c_str());
@@ -239,11 +1609,17 @@ int LuaManager::Lua_Engine_Expose(lua_State* L) {
             return 0;
     }
 
-    // Store the variable in the static m_ExposedVariables map
-    m_ExposedVariables[varName] = varValue;
-
-    // Push the variable to the Lua global environment
-    lua_pushglobaltable(L);
+    // Store the variable in the calling script's exposed variables
+    LuaManager *manager = s_ActiveManager;
+    if (manager)
+    {
+        manager->m_ExposedVariables[varName] = varValue;
+        manager->PushEnvironment(L); // L may be a coroutine of m_LuaState
+    }
+    else
+    {
+        lua_pushglobaltable(L);
+    }
 
     lua_pushstring(L, varName); // Push the variable name
 
@@ -289,68 +1665,82 @@ void LuaManager::Update(float deltaTime)
         return;
     }
 
-    // Push the 'OnUpdate' function onto the stack
-    lua_getglobal(m_LuaState, "OnUpdate");
-    if (!lua_isfunction(m_LuaState, -1))
-    {
-        if (g_LoggerWindow)
-        {
-            g_LoggerWindow->AddLog("LuaManager: 'OnUpdate' is not a function.", std::optional<ImVec4>(ImVec4(1.0f, 0.0f, 0.0f, 1.0f)));
-        }
-        else
-        {
-            DEBUG_PRINT("LuaManager: 'OnUpdate' is not a function.");
-        }
-        lua_pop(m_LuaState, 1); // Remove non-function value from stack
+    // Shared-state scripts are driven by UpdateAll; scripts without OnUpdate have nothing to do
+    if (m_UsesSharedState || !HasUpdate())
         return;
-    }
 
-    // Push the deltaTime argument
-    lua_pushnumber(m_LuaState, deltaTime);
+    RollFrameStats();
 
-    // Call the 'OnUpdate' function with 1 argument and 0 return values
-    if (lua_pcall(m_LuaState, 1, 0, 0) != LUA_OK)
+    ActiveScope scope(this);
+
+    // OnUpdate runs in a coroutine so the budget hook can suspend it
+    if (m_UpdateThreadRef == LUA_NOREF)
     {
-        const char *luaError = lua_tostring(m_LuaState, -1);
-        if (luaError)
-        {
-            std::string errorMsg(luaError);
-            // Prevent duplicate error logs
-            if (errorMsg != m_LastErrorMessage)
-            {
-                if (g_LoggerWindow)
-                {
-                    std::string formattedError = "LuaManager Error in OnUpdate: " + errorMsg;
-                    ImVec4 redColor = ImVec4(1.0f, 0.0f, 0.0f, 1.0f);
-                    g_LoggerWindow->AddLog(formattedError.c_str(), std::optional<ImVec4>(redColor));
-                }
-                else
-                {
-                    DEBUG_PRINT("LuaManager Error in OnUpdate: %s", errorMsg.c_str());
-                }
-                m_LastErrorMessage = errorMsg;
-            }
-        }
-        else
-        {
-            if (g_LoggerWindow)
-            {
-                g_LoggerWindow->AddLog("LuaManager: Unknown error in OnUpdate.", std::optional<ImVec4>(ImVec4(1.0f, 0.0f, 0.0f, 1.0f)));
-            }
-            else
-            {
-                DEBUG_PRINT("LuaManager: Unknown error in OnUpdate.");
-            }
-        }
+        lua_newthread(m_LuaState);
+        m_UpdateThreadRef = luaL_ref(m_LuaState, LUA_REGISTRYINDEX);
+    }
+    lua_rawgeti(m_LuaState, LUA_REGISTRYINDEX, m_UpdateThreadRef);
+    lua_State *thread = lua_tothread(m_LuaState, -1);
+    lua_pop(m_LuaState, 1); // Still anchored by the registry
 
-        lua_pop(m_LuaState, 1); // Remove error message from stack
-        return;
+    // A suspended update continues where it stopped; otherwise start a new one
+    int argumentCount = 0;
+    if (lua_status(thread) != LUA_YIELD)
+    {
+        lua_rawgeti(thread, LUA_REGISTRYINDEX, m_OnUpdateRef);
+        lua_pushnumber(thread, deltaTime);
+        argumentCount = 1;
     }
-    else
+
+    lua_State *previousThread = s_ActiveThread;
+    s_ActiveThread = thread;
+    auto start = std::chrono::high_resolution_clock::now();
+    int resultCount = 0;
+    int status = lua_resume(thread, m_LuaState, argumentCount, &resultCount);
+    s_ActiveThread = previousThread;
+    m_CpuMsThisFrame += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    if (status == LUA_YIELD)
+    {
+        // Over budget (or the script yielded itself); continues next frame
+        lua_pop(thread, resultCount);
+        m_Suspended = true;
+    }
+    else if (status == LUA_OK)
     {
+        lua_settop(thread, 0);
+        m_Suspended = false;
+
         // Reset last error message on successful call
         m_LastErrorMessage.clear();
     }
+    else
+    {
+        ReportError("OnUpdate", lua_tostring(thread, -1));
+        lua_resetthread(thread); // Make the coroutine reusable
+        m_Suspended = false;
+    }
+}
+
+void LuaManager::Init()
+{
+    if (!m_LuaState)
+        return;
+
+    if (m_OnInitRef != LUA_NOREF)
+    {
+        ActiveScope scope(this);
+
+        lua_rawgeti(m_LuaState, LUA_REGISTRYINDEX, m_OnInitRef);
+        if (lua_pcall(m_LuaState, 0, 0, 0) != LUA_OK)
+        {
+            ReportError("OnInit", lua_tostring(m_LuaState, -1));
+            lua_pop(m_LuaState, 1);
+        }
+    }
+
+    // OnInit may (re)define OnUpdate
+    RefreshLifecycleFunctions();
 }
 
 // Update function called every frame
@@ -370,11 +1760,16 @@ void LuaManager::CallLuaFunction(std::string functionName)
         return;
     }
 
-    // Push the 'OnUpdate' function onto the stack
-    lua_getglobal(m_LuaState, functionName.c_str());
+    ActiveScope scope(this);
+
+    // Push the function onto the stack
+    PushEnvironment(m_LuaState);
+    lua_getfield(m_LuaState, -1, functionName.c_str());
+    lua_remove(m_LuaState, -2);
     if (!lua_isfunction(m_LuaState, -1))
     {
-        DEBUG_PRINT("LuaManager: 'OnUpdate' is not a function.");
+        DEBUG_PRINT("LuaManager: '%s' is not a function.", functionName.c_str());
+        lua_pop(m_LuaState, 1);
         return;
     }
 
@@ -427,7 +1822,7 @@ int LuaManager::Lua_Engine_ScriptName(lua_State *L)
 {
 
     // Push the script name onto the Lua stack
-    lua_pushstring(L, m_ScriptName.c_str());
+    lua_pushstring(L, s_ActiveManager ? s_ActiveManager->m_ScriptName.c_str() : "LUA_UNDEFINED");
 
     // Return 1 value (the string)
     return 1;
@@ -447,7 +1842,8 @@ int LuaManager::Lua_Engine_Log(lua_State *L)
     const char *message = lua_tostring(L, 1);
 
     // Prepend the script name
-    std::string formattedMessage = "[" + m_ScriptName + "]: " + message;
+    std::string scriptName = s_ActiveManager ? s_ActiveManager->m_ScriptName : "LUA_UNDEFINED";
+    std::string formattedMessage = "[" + scriptName + "]: " + message;
 
     // Default color: white
     ImVec4 color(1.0f, 1.0f, 1.0f, 1.0f);
@@ -511,53 +1907,110 @@ int LuaManager::Lua_GetGameObjectByTag(lua_State *L)
 
     std::string tag = lua_tostring(L, 1);
 
-    // Search for the GameObject with the matching tag
-    GameObject *foundObject = nullptr;
-    for (auto &obj : g_GameObjects)
+    // Names have always doubled as tags, so fall back to them
+    GameObject *foundObject = g_SceneIndex.FindByTag(tag);
+    if (foundObject == nullptr)
+        foundObject = g_SceneIndex.FindByName(tag);
+
+    PushGameObject(L, foundObject);
+    return 1; // Return the GameObject userdata (or nil)
+}
+
+int LuaManager::Lua_Engine_GetGameObjectByName(lua_State *L)
+{
+    const char *name = luaL_checkstring(L, 1);
+    PushGameObject(L, g_SceneIndex.FindByName(name));
+    return 1;
+}
+
+int LuaManager::Lua_Engine_GetGameObjectsByTag(lua_State *L)
+{
+    const char *tag = luaL_checkstring(L, 1);
+    const std::vector<GameObject *> &found = g_SceneIndex.FindAllByTag(tag);
+
+    lua_createtable(L, static_cast<int>(found.size()), 0);
+    for (size_t i = 0; i < found.size(); ++i)
     {
-        if (obj->name == tag)
-        {
-            foundObject = obj.get();
-            break;
-        }
+        PushGameObject(L, found[i]);
+        lua_rawseti(L, -2, static_cast<lua_Integer>(i + 1));
     }
+    return 1;
+}
 
-    if (foundObject == nullptr)
+void LuaManager::PushGameObject(lua_State *L, GameObject *gameObject)
+{
+    if (gameObject == nullptr)
     {
         lua_pushnil(L); // Push nil to the stack if not found
-        return 1;       // Return 1 (nil on Lua stack)
+        return;
     }
 
-    // Create userdata to hold the GameObject pointer
-    GameObject **udata = (GameObject **)lua_newuserdata(L, sizeof(GameObject *));
-    *udata = foundObject;
+    PushHandle(L, gameObject->GetHandle(), "GameObjectMetaTable");
+}
+
+// Registry key of each state's weak-valued table: handle key -> userdata
+static char s_HandleCacheKey;
+
+void LuaManager::CreateHandleCache(lua_State *L)
+{
+    lua_newtable(L);
+    lua_createtable(L, 0, 1);
+    lua_pushstring(L, "v");
+    lua_setfield(L, -2, "__mode");
+    lua_setmetatable(L, -2);
+    lua_rawsetp(L, LUA_REGISTRYINDEX, &s_HandleCacheKey);
+}
 
-    // Set the metatable
-    luaL_getmetatable(L, "GameObjectMetaTable");
-    if (!lua_istable(L, -1)) // Check if the metatable was successfully found
+void LuaManager::PushHandle(lua_State *L, EntityHandle handle, const char *metatable)
+{
+    // Reuse the userdata while any script still references it, so repeated lookups don't allocate
+    lua_rawgetp(L, LUA_REGISTRYINDEX, &s_HandleCacheKey);
+    lua_rawgeti(L, -1, handle.Key());
+    if (!lua_isnil(L, -1))
     {
-        DEBUG_PRINT("LuaManager: Metatable 'GameObjectMetaTable' not found.");
-        lua_pop(L, 1);  // Remove the invalid metatable from the stack
-        lua_pushnil(L); // Return nil to indicate failure
-        return 1;       // Return 1 (nil on Lua stack)
+        lua_remove(L, -2);
+        return;
     }
+    lua_pop(L, 1);
 
-    lua_setmetatable(L, -2); // Set the metatable for the userdata
+    EntityHandle *udata = static_cast<EntityHandle *>(lua_newuserdatauv(L, sizeof(EntityHandle), 0));
+    *udata = handle;
+    luaL_setmetatable(L, metatable);
 
-    return 1; // Return the GameObject userdata
+    lua_pushvalue(L, -1);
+    lua_rawseti(L, -3, handle.Key());
+    lua_remove(L, -2); // Cache table
 }
 
-// Binding function to retrieve a Component by name from a GameObject
-int LuaManager::Lua_GameObject_GetComponent(lua_State *L)
+void *LuaManager::CheckHandle(lua_State *L, int index, const char *metatable)
 {
-    // Ensure the first argument is a userdata with the correct metatable
-    GameObject **udata = (GameObject **)luaL_checkudata(L, 1, "GameObjectMetaTable");
-    if (udata == nullptr || *udata == nullptr)
+    EntityHandle *udata = static_cast<EntityHandle *>(luaL_checkudata(L, index, metatable));
+    void *object = EntityRegistry::Get().Resolve(*udata);
+    if (object == nullptr)
     {
-        lua_pushstring(L, "Invalid GameObject.");
-        lua_error(L);
-        return 0;
+        // Destroyed, e.g. by removing it in the editor or a scene (re)load
+        luaL_error(L, "Attempt to use a destroyed object (%s).", metatable);
     }
+    return object;
+}
+
+GameObject *LuaManager::CheckGameObject(lua_State *L, int index)
+{
+    return static_cast<GameObject *>(CheckHandle(L, index, "GameObjectMetaTable"));
+}
+
+int LuaManager::Lua_GameObject_IsValid(lua_State *L)
+{
+    EntityHandle *udata = static_cast<EntityHandle *>(luaL_testudata(L, 1, "GameObjectMetaTable"));
+    lua_pushboolean(L, udata != nullptr && EntityRegistry::Get().Resolve(*udata) != nullptr);
+    return 1;
+}
+
+// Binding function to retrieve a Component by name from a GameObject
+int LuaManager::Lua_GameObject_GetComponent(lua_State *L)
+{
+    // Ensure the first argument is a userdata with the correct metatable
+    GameObject *gameObject = CheckGameObject(L, 1);
 
     // Ensure the second argument is a string representing the component name
     if (!lua_isstring(L, 2))
@@ -570,7 +2023,7 @@ int LuaManager::Lua_GameObject_GetComponent(lua_State *L)
     const char *componentNameStr = lua_tostring(L, 2);
 
     // Retrieve the component by name
-    Component *component = (*udata)->GetComponentByName(componentNameStr).get();
+    Component *component = gameObject->GetComponentByName(componentNameStr).get();
 
     if (component == nullptr)
     {
@@ -579,17 +2032,18 @@ int LuaManager::Lua_GameObject_GetComponent(lua_State *L)
     }
 
     // Determine which metatable to use based on the component type
+    const char *metatableName = nullptr;
     if (strcmp(componentNameStr, "Transform") == 0)
     {
-        luaL_getmetatable(L, "TransformMetaTable");
+        metatableName = "TransformMetaTable";
     }
     else if (strcmp(componentNameStr, "Mesh") == 0)
     {
-        luaL_getmetatable(L, "MeshMetaTable");
+        metatableName = "MeshMetaTable";
     }
     else if (strcmp(componentNameStr, "Script") == 0)
     {
-        luaL_getmetatable(L, "ScriptMetaTable");
+        metatableName = "ScriptMetaTable";
     }
     else
     {
@@ -598,30 +2052,8 @@ int LuaManager::Lua_GameObject_GetComponent(lua_State *L)
         return 0;
     }
 
-    // Check if the metatable was successfully retrieved
-    std::string metatableName = std::string(componentNameStr) + "MetaTable";
-
-    if (!lua_istable(L, -1))
-    {
-        DEBUG_PRINT("LuaManager: Metatable '%s' not found.", std::string(metatableName).c_str());
-        lua_pop(L, 1);  // Remove the invalid metatable from the stack
-        lua_pushnil(L); // Return nil to indicate failure
-        return 1;
-    }
-
-    // Create userdata for the Component
-    Component **compUdata = (Component **)lua_newuserdata(L, sizeof(Component *));
-    *compUdata = component;
-
-    // Retrieve and push the metatable onto the stack
-    luaL_getmetatable(L, std::string(metatableName).c_str());
-    if (lua_isnil(L, -1))
-    {
-        luaL_error(L, "Metatable '%s' not found", std::string(metatableName).c_str());
-    }
-
-    // Set the metatable for the userdata
-    lua_setmetatable(L, -2);
+    // Push a (cached) handle userdata for the Component
+    PushHandle(L, component->GetHandle(), metatableName);
 
     return 1; // Return the Component userdata
 }
@@ -630,172 +2062,397 @@ int LuaManager::Lua_GameObject_GetComponent(lua_State *L)
 int LuaManager::Lua_Component_GetName(lua_State *L)
 {
     // Ensure the first argument is a userdata with ComponentMetaTable
-    Component **udata = (Component **)luaL_checkudata(L, 1, "ComponentMetaTable");
-    if (udata == nullptr || *udata == nullptr)
-    {
-        lua_pushstring(L, "Invalid Component.");
-        lua_error(L);
-        return 0;
-    }
+    Component *component = CheckComponent<Component>(L, 1, "ComponentMetaTable");
 
     // Push the name of the Component
-    lua_pushstring(L, (*udata)->GetName().c_str());
+    lua_pushstring(L, component->GetName().c_str());
 
     return 1; // Return the name
 }
 
-// Binding function to retrieve a TransformComponent's position
-int LuaManager::Lua_TransformComponent_GetPosition(lua_State *L)
+// Vec3 userdata layout
+struct LuaVec3
+{
+    float x, y, z;
+};
+
+static LuaVec3 *CheckVec3(lua_State *L, int index)
+{
+    return static_cast<LuaVec3 *>(luaL_checkudata(L, index, "Vec3MetaTable"));
+}
+
+static LuaVec3 *NewVec3(lua_State *L, float x, float y, float z)
+{
+    LuaVec3 *v = static_cast<LuaVec3 *>(lua_newuserdatauv(L, sizeof(LuaVec3), 0));
+    v->x = x;
+    v->y = y;
+    v->z = z;
+    luaL_setmetatable(L, "Vec3MetaTable");
+    return v;
+}
+
+// Reads a Vec3 or an {x, y, z} table
+static glm::vec3 CheckVec3Argument(lua_State *L, int index, const char *functionName)
+{
+    if (LuaVec3 *v = static_cast<LuaVec3 *>(luaL_testudata(L, index, "Vec3MetaTable")))
+        return glm::vec3(v->x, v->y, v->z);
+
+    if (!lua_istable(L, index))
+        luaL_error(L, "%s expects a Vec3 or a table with x, y, z fields.", functionName);
+
+    lua_getfield(L, index, "x");
+    lua_getfield(L, index, "y");
+    lua_getfield(L, index, "z");
+    if (!lua_isnumber(L, -3) || !lua_isnumber(L, -2) || !lua_isnumber(L, -1))
+        luaL_error(L, "%s expects numerical x, y, z fields.", functionName);
+
+    glm::vec3 value(static_cast<float>(lua_tonumber(L, -3)),
+                    static_cast<float>(lua_tonumber(L, -2)),
+                    static_cast<float>(lua_tonumber(L, -1)));
+    lua_pop(L, 3); // Remove x, y, z from stack
+    return value;
+}
+
+// Fills a Vec3 passed as argument 2 (no allocation), otherwise returns a new {x, y, z} table
+static int ReturnVec3(lua_State *L, const glm::vec3 &value)
 {
-    // Ensure the first argument is a userdata with TransformMetaTable
-    TransformComponent **udata = (TransformComponent **)luaL_checkudata(L, 1, "TransformMetaTable");
-    if (udata == nullptr || *udata == nullptr)
+    if (LuaVec3 *out = static_cast<LuaVec3 *>(luaL_testudata(L, 2, "Vec3MetaTable")))
     {
-        lua_pushstring(L, "Invalid TransformComponent.");
-        lua_error(L);
-        return 0;
+        out->x = value.x;
+        out->y = value.y;
+        out->z = value.z;
+        lua_settop(L, 2);
+        return 1;
     }
 
-    // Assuming TransformComponent has a GetPosition method returning a glm::vec3
-    glm::vec3 position = (*udata)->GetPosition(); // Example using glm::vec3
-
-    // Push position as a Lua table
-    lua_newtable(L);
-    lua_pushnumber(L, position.x);
+    lua_createtable(L, 0, 3);
+    lua_pushnumber(L, value.x);
     lua_setfield(L, -2, "x");
-    lua_pushnumber(L, position.y);
+    lua_pushnumber(L, value.y);
     lua_setfield(L, -2, "y");
-    lua_pushnumber(L, position.z);
+    lua_pushnumber(L, value.z);
     lua_setfield(L, -2, "z");
+    return 1;
+}
 
-    return 1; // Return the position table
+// Binding function to retrieve a TransformComponent's position
+int LuaManager::Lua_TransformComponent_GetPosition(lua_State *L)
+{
+    TransformComponent *transform = CheckComponent<TransformComponent>(L, 1, "TransformMetaTable");
+    return ReturnVec3(L, transform->GetPosition());
 }
 
 // Binding function to set a TransformComponent's position
-int LuaManager::Lua_TransformComponent_SetPosition(lua_State *L)
+static void WriteTransform(TransformComponent *transform, bool rotation, const glm::vec3 &value)
 {
-    // Ensure the first argument is a userdata with TransformMetaTable
-    TransformComponent **udata = (TransformComponent **)luaL_checkudata(L, 1, "TransformMetaTable");
-    if (udata == nullptr || *udata == nullptr)
+    if (s_TransformCommands)
     {
-        lua_pushstring(L, "Invalid TransformComponent.");
-        lua_error(L);
-        return 0;
+        s_TransformCommands->push_back({transform->GetHandle(), rotation, value});
+        return;
     }
 
-    // Ensure the second argument is a table with x, y, z
-    if (!lua_istable(L, 2))
+    if (rotation)
+        transform->SetRotation(value.x, value.y, value.z);
+    else
+        transform->SetPosition(value.x, value.y, value.z);
+}
+
+int LuaManager::Lua_TransformComponent_SetPosition(lua_State *L)
+{
+    TransformComponent *transform = CheckComponent<TransformComponent>(L, 1, "TransformMetaTable");
+    WriteTransform(transform, false, CheckVec3Argument(L, 2, "SetPosition"));
+    return 0; // No return values
+}
+
+// Binding function to retrieve a TransformComponent's rotation
+int LuaManager::Lua_TransformComponent_GetRotation(lua_State *L)
+{
+    TransformComponent *transform = CheckComponent<TransformComponent>(L, 1, "TransformMetaTable");
+    return ReturnVec3(L, transform->GetRotation());
+}
+
+// Binding function to set a TransformComponent's rotation
+int LuaManager::Lua_TransformComponent_SetRotation(lua_State *L)
+{
+    TransformComponent *transform = CheckComponent<TransformComponent>(L, 1, "TransformMetaTable");
+    WriteTransform(transform, true, CheckVec3Argument(L, 2, "SetRotation"));
+    return 0; // No return values
+}
+
+// Bulk accessors: plain numbers in and out, nothing for the GC
+int LuaManager::Lua_TransformComponent_GetPositionXYZ(lua_State *L)
+{
+    TransformComponent *transform = CheckComponent<TransformComponent>(L, 1, "TransformMetaTable");
+    glm::vec3 position = transform->GetPosition();
+    lua_pushnumber(L, position.x);
+    lua_pushnumber(L, position.y);
+    lua_pushnumber(L, position.z);
+    return 3;
+}
+
+int LuaManager::Lua_TransformComponent_SetPositionXYZ(lua_State *L)
+{
+    TransformComponent *transform = CheckComponent<TransformComponent>(L, 1, "TransformMetaTable");
+    WriteTransform(transform, false, glm::vec3(static_cast<float>(luaL_checknumber(L, 2)),
+                                               static_cast<float>(luaL_checknumber(L, 3)),
+                                               static_cast<float>(luaL_checknumber(L, 4))));
+    return 0;
+}
+
+int LuaManager::Lua_TransformComponent_GetRotationXYZ(lua_State *L)
+{
+    TransformComponent *transform = CheckComponent<TransformComponent>(L, 1, "TransformMetaTable");
+    glm::vec3 rotation = transform->GetRotation();
+    lua_pushnumber(L, rotation.x);
+    lua_pushnumber(L, rotation.y);
+    lua_pushnumber(L, rotation.z);
+    return 3;
+}
+
+int LuaManager::Lua_TransformComponent_SetRotationXYZ(lua_State *L)
+{
+    TransformComponent *transform = CheckComponent<TransformComponent>(L, 1, "TransformMetaTable");
+    WriteTransform(transform, true, glm::vec3(static_cast<float>(luaL_checknumber(L, 2)),
+                                              static_cast<float>(luaL_checknumber(L, 3)),
+                                              static_cast<float>(luaL_checknumber(L, 4))));
+    return 0;
+}
+
+// Engine.Vec3(x, y, z); missing components default to 0
+int LuaManager::Lua_Vec3_New(lua_State *L)
+{
+    NewVec3(L, static_cast<float>(luaL_optnumber(L, 1, 0.0)),
+            static_cast<float>(luaL_optnumber(L, 2, 0.0)),
+            static_cast<float>(luaL_optnumber(L, 3, 0.0)));
+    return 1;
+}
+
+// Component access by single-letter key, everything else from the method table (upvalue 1)
+int LuaManager::Lua_Vec3_Index(lua_State *L)
+{
+    LuaVec3 *v = CheckVec3(L, 1);
+    size_t length = 0;
+    const char *key = lua_tolstring(L, 2, &length);
+    if (key && length == 1)
     {
-        lua_pushstring(L, "SetPosition expects a table with x, y, z fields.");
-        lua_error(L);
-        return 0;
+        switch (key[0])
+        {
+        case 'x':
+            lua_pushnumber(L, v->x);
+            return 1;
+        case 'y':
+            lua_pushnumber(L, v->y);
+            return 1;
+        case 'z':
+            lua_pushnumber(L, v->z);
+            return 1;
+        }
     }
 
-    lua_getfield(L, 2, "x");
-    lua_getfield(L, 2, "y");
-    lua_getfield(L, 2, "z");
+    lua_pushvalue(L, 2);
+    lua_rawget(L, lua_upvalueindex(1));
+    return 1;
+}
 
-    if (!lua_isnumber(L, -3) || !lua_isnumber(L, -2) || !lua_isnumber(L, -1))
+int LuaManager::Lua_Vec3_NewIndex(lua_State *L)
+{
+    LuaVec3 *v = CheckVec3(L, 1);
+    size_t length = 0;
+    const char *key = luaL_checklstring(L, 2, &length);
+    float value = static_cast<float>(luaL_checknumber(L, 3));
+    if (length == 1 && key[0] == 'x')
+        v->x = value;
+    else if (length == 1 && key[0] == 'y')
+        v->y = value;
+    else if (length == 1 && key[0] == 'z')
+        v->z = value;
+    else
+        return luaL_error(L, "Vec3 has no field '%s'.", key);
+    return 0;
+}
+
+// Either operand may be a number for * and /
+static LuaVec3 OperandVec3(lua_State *L, int index)
+{
+    if (lua_type(L, index) == LUA_TNUMBER)
     {
-        lua_pushstring(L, "SetPosition expects numerical x, y, z fields.");
-        lua_error(L);
-        return 0;
+        float s = static_cast<float>(lua_tonumber(L, index));
+        return LuaVec3{s, s, s};
     }
+    return *CheckVec3(L, index);
+}
 
-    float x = lua_tonumber(L, -3);
-    float y = lua_tonumber(L, -2);
-    float z = lua_tonumber(L, -1);
-
-    lua_pop(L, 3); // Remove x, y, z from stack
+int LuaManager::Lua_Vec3_Add(lua_State *L)
+{
+    LuaVec3 a = *CheckVec3(L, 1);
+    LuaVec3 b = *CheckVec3(L, 2);
+    NewVec3(L, a.x + b.x, a.y + b.y, a.z + b.z);
+    return 1;
+}
 
-    (*udata)->SetPosition(x, y, z); // Corrected to match the method signature
+int LuaManager::Lua_Vec3_Sub(lua_State *L)
+{
+    LuaVec3 a = *CheckVec3(L, 1);
+    LuaVec3 b = *CheckVec3(L, 2);
+    NewVec3(L, a.x - b.x, a.y - b.y, a.z - b.z);
+    return 1;
+}
 
-    return 0; // No return values
+int LuaManager::Lua_Vec3_Mul(lua_State *L)
+{
+    LuaVec3 a = OperandVec3(L, 1);
+    LuaVec3 b = OperandVec3(L, 2);
+    NewVec3(L, a.x * b.x, a.y * b.y, a.z * b.z);
+    return 1;
 }
 
-// Binding function to retrieve a TransformComponent's position
-int LuaManager::Lua_TransformComponent_GetRotation(lua_State *L)
+int LuaManager::Lua_Vec3_Div(lua_State *L)
 {
-    // Ensure the first argument is a userdata with TransformMetaTable
-    TransformComponent **udata = (TransformComponent **)luaL_checkudata(L, 1, "TransformMetaTable");
-    if (udata == nullptr || *udata == nullptr)
-    {
-        lua_pushstring(L, "Invalid TransformComponent.");
-        lua_error(L);
-        return 0;
-    }
+    LuaVec3 a = OperandVec3(L, 1);
+    LuaVec3 b = OperandVec3(L, 2);
+    NewVec3(L, a.x / b.x, a.y / b.y, a.z / b.z);
+    return 1;
+}
 
-    // Assuming TransformComponent has a GetPosition method returning a glm::vec3
-    glm::vec3 rotation = (*udata)->GetRotation(); // Example using glm::vec3
+int LuaManager::Lua_Vec3_Unm(lua_State *L)
+{
+    LuaVec3 *v = CheckVec3(L, 1);
+    NewVec3(L, -v->x, -v->y, -v->z);
+    return 1;
+}
 
-    // Push position as a Lua table
-    lua_newtable(L);
-    lua_pushnumber(L, rotation.x);
-    lua_setfield(L, -2, "x");
-    lua_pushnumber(L, rotation.y);
-    lua_setfield(L, -2, "y");
-    lua_pushnumber(L, rotation.z);
-    lua_setfield(L, -2, "z");
+int LuaManager::Lua_Vec3_Eq(lua_State *L)
+{
+    LuaVec3 *a = CheckVec3(L, 1);
+    LuaVec3 *b = CheckVec3(L, 2);
+    lua_pushboolean(L, a->x == b->x && a->y == b->y && a->z == b->z);
+    return 1;
+}
 
-    return 1; // Return the position table
+int LuaManager::Lua_Vec3_ToString(lua_State *L)
+{
+    LuaVec3 *v = CheckVec3(L, 1);
+    lua_pushfstring(L, "Vec3(%f, %f, %f)", static_cast<lua_Number>(v->x), static_cast<lua_Number>(v->y), static_cast<lua_Number>(v->z));
+    return 1;
 }
 
-// Binding function to set a TransformComponent's position
-int LuaManager::Lua_TransformComponent_SetRotation(lua_State *L)
+// v:Set(x, y, z) or v:Set(other); returns v
+int LuaManager::Lua_Vec3_Set(lua_State *L)
 {
-    // Ensure the first argument is a userdata with TransformMetaTable
-    TransformComponent **udata = (TransformComponent **)luaL_checkudata(L, 1, "TransformMetaTable");
-    if (udata == nullptr || *udata == nullptr)
+    LuaVec3 *v = CheckVec3(L, 1);
+    if (LuaVec3 *other = static_cast<LuaVec3 *>(luaL_testudata(L, 2, "Vec3MetaTable")))
     {
-        lua_pushstring(L, "Invalid TransformComponent.");
-        lua_error(L);
-        return 0;
+        *v = *other;
     }
-
-    // Ensure the second argument is a table with x, y, z
-    if (!lua_istable(L, 2))
+    else
     {
-        lua_pushstring(L, "SetRotation expects a table with x, y, z fields.");
-        lua_error(L);
-        return 0;
+        v->x = static_cast<float>(luaL_checknumber(L, 2));
+        v->y = static_cast<float>(luaL_checknumber(L, 3));
+        v->z = static_cast<float>(luaL_checknumber(L, 4));
     }
+    lua_settop(L, 1);
+    return 1;
+}
 
-    lua_getfield(L, 2, "x");
-    lua_getfield(L, 2, "y");
-    lua_getfield(L, 2, "z");
+// In-place v:Add(other), returns v
+int LuaManager::Lua_Vec3_AddInPlace(lua_State *L)
+{
+    LuaVec3 *v = CheckVec3(L, 1);
+    LuaVec3 *other = CheckVec3(L, 2);
+    v->x += other->x;
+    v->y += other->y;
+    v->z += other->z;
+    lua_settop(L, 1);
+    return 1;
+}
 
-    if (!lua_isnumber(L, -3) || !lua_isnumber(L, -2) || !lua_isnumber(L, -1))
+// In-place v:Sub(other), returns v
+int LuaManager::Lua_Vec3_SubInPlace(lua_State *L)
+{
+    LuaVec3 *v = CheckVec3(L, 1);
+    LuaVec3 *other = CheckVec3(L, 2);
+    v->x -= other->x;
+    v->y -= other->y;
+    v->z -= other->z;
+    lua_settop(L, 1);
+    return 1;
+}
+
+// In-place v:Scale(s), returns v
+int LuaManager::Lua_Vec3_Scale(lua_State *L)
+{
+    LuaVec3 *v = CheckVec3(L, 1);
+    float s = static_cast<float>(luaL_checknumber(L, 2));
+    v->x *= s;
+    v->y *= s;
+    v->z *= s;
+    lua_settop(L, 1);
+    return 1;
+}
+
+// In-place v:Normalize(), returns v (zero vectors stay zero)
+int LuaManager::Lua_Vec3_Normalize(lua_State *L)
+{
+    LuaVec3 *v = CheckVec3(L, 1);
+    float length = std::sqrt(v->x * v->x + v->y * v->y + v->z * v->z);
+    if (length > 0.0f)
     {
-        lua_pushstring(L, "SetRotation expects numerical x, y, z fields.");
-        lua_error(L);
-        return 0;
+        v->x /= length;
+        v->y /= length;
+        v->z /= length;
     }
+    lua_settop(L, 1);
+    return 1;
+}
 
-    float x = lua_tonumber(L, -3);
-    float y = lua_tonumber(L, -2);
-    float z = lua_tonumber(L, -1);
+int LuaManager::Lua_Vec3_Length(lua_State *L)
+{
+    LuaVec3 *v = CheckVec3(L, 1);
+    lua_pushnumber(L, std::sqrt(v->x * v->x + v->y * v->y + v->z * v->z));
+    return 1;
+}
 
-    lua_pop(L, 3); // Remove x, y, z from stack
+int LuaManager::Lua_Vec3_Dot(lua_State *L)
+{
+    LuaVec3 *a = CheckVec3(L, 1);
+    LuaVec3 *b = CheckVec3(L, 2);
+    lua_pushnumber(L, a->x * b->x + a->y * b->y + a->z * b->z);
+    return 1;
+}
 
-    (*udata)->SetRotation(x, y, z); // Corrected to match the method signature
+int LuaManager::Lua_Vec3_Cross(lua_State *L)
+{
+    LuaVec3 a = *CheckVec3(L, 1);
+    LuaVec3 b = *CheckVec3(L, 2);
+    NewVec3(L, a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    return 1;
+}
 
-    return 0; // No return values
+int LuaManager::Lua_Vec3_Clone(lua_State *L)
+{
+    LuaVec3 v = *CheckVec3(L, 1);
+    NewVec3(L, v.x, v.y, v.z);
+    return 1;
+}
+
+// Returns x, y, z
+int LuaManager::Lua_Vec3_Unpack(lua_State *L)
+{
+    LuaVec3 *v = CheckVec3(L, 1);
+    lua_pushnumber(L, v->x);
+    lua_pushnumber(L, v->y);
+    lua_pushnumber(L, v->z);
+    return 3;
 }
 
 // Binding function to retrieve a ScriptComponent's script path
 int LuaManager::Lua_ScriptComponent_GetScriptPath(lua_State *L)
 {
     // Ensure the first argument is a userdata with ScriptComponentMetaTable
-    ScriptComponent **udata = (ScriptComponent **)luaL_checkudata(L, 1, "ScriptComponentMetaTable");
-    if (udata == nullptr || *udata == nullptr)
-    {
-        lua_pushstring(L, "Invalid ScriptComponent.");
-        lua_error(L);
-        return 0;
-    }
+    ScriptComponent *script = CheckComponent<ScriptComponent>(L, 1, "ScriptMetaTable");
 
     // Push the script path
-    lua_pushstring(L, (*udata)->ScriptPath.c_str());
+    lua_pushstring(L, script->ScriptPath.c_str());
 
     return 1; // Return the script path
 }
@@ -804,16 +2461,10 @@ int LuaManager::Lua_ScriptComponent_GetScriptPath(lua_State *L)
 int LuaManager::Lua_GameObject_GetName(lua_State *L)
 {
     // Ensure the first argument is a userdata with GameObjectMetaTable
-    GameObject **udata = (GameObject **)luaL_checkudata(L, 1, "GameObjectMetaTable");
-    if (udata == nullptr || *udata == nullptr)
-    {
-        lua_pushstring(L, "Invalid GameObject.");
-        lua_error(L);
-        return 0;
-    }
+    GameObject *gameObject = CheckGameObject(L, 1);
 
     // Push the name of the GameObject
-    lua_pushstring(L, (*udata)->GetName().c_str());
+    lua_pushstring(L, gameObject->GetName().c_str());
 
     return 1; // Return the name
 }
@@ -821,6 +2472,7 @@ int LuaManager::Lua_GameObject_GetName(lua_State *L)
 // Function to register all metatables
 void LuaManager::RegisterAllMetatables()
 {
+    RegisterVec3MetaTable();
     RegisterComponentMetaTable();
     RegisterTransformComponentMetaTable();
     RegisterMeshComponentMetaTable();
@@ -828,6 +2480,57 @@ void LuaManager::RegisterAllMetatables()
     RegisterGameObjectMetatable();
 }
 
+// Function to create the Engine table and bind its functions
+void LuaManager::RegisterEngineTable()
+{
+    lua_newtable(m_LuaState);
+
+    // Bind the Log function to the Engine table
+    lua_pushcfunction(m_LuaState, Lua_Engine_Log);
+    lua_setfield(m_LuaState, -2, "Log");
+
+    lua_pushcfunction(m_LuaState, Lua_Engine_Expose);
+    lua_setfield(m_LuaState, -2, "Expose");
+
+    // Add the ScriptName binding
+    lua_pushcfunction(m_LuaState, Lua_Engine_ScriptName);
+    lua_setfield(m_LuaState, -2, "ScriptName");
+
+    // Bind the GetGameObjectByTag function to the Engine table
+    lua_pushcfunction(m_LuaState, Lua_Engine_GetGameObjectByTag);
+    lua_setfield(m_LuaState, -2, "GetGameObjectByTag");
+
+    lua_pushcfunction(m_LuaState, Lua_Engine_GetGameObjectByName);
+    lua_setfield(m_LuaState, -2, "GetGameObjectByName");
+
+    lua_pushcfunction(m_LuaState, Lua_Engine_GetGameObjectsByTag);
+    lua_setfield(m_LuaState, -2, "GetGameObjectsByTag");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_New);
+    lua_setfield(m_LuaState, -2, "Vec3");
+
+    // Coroutines
+    lua_pushcfunction(m_LuaState, Lua_Engine_StartCoroutine);
+    lua_setfield(m_LuaState, -2, "StartCoroutine");
+
+    lua_pushcfunction(m_LuaState, Lua_Engine_StopCoroutine);
+    lua_setfield(m_LuaState, -2, "StopCoroutine");
+
+    lua_pushcfunction(m_LuaState, Lua_Engine_Wait);
+    lua_setfield(m_LuaState, -2, "Wait");
+
+    lua_pushcfunction(m_LuaState, Lua_Engine_WaitFrames);
+    lua_setfield(m_LuaState, -2, "WaitFrames");
+
+    lua_pushcfunction(m_LuaState, Lua_Engine_LoadAsync);
+    lua_setfield(m_LuaState, -2, "LoadAsync");
+
+    lua_pushcfunction(m_LuaState, Lua_Engine_CaptureTrace);
+    lua_setfield(m_LuaState, -2, "CaptureTrace");
+
+    lua_setglobal(m_LuaState, "_T_Engine_Table");
+}
+
 // Function to register the base ComponentMetaTable
 void LuaManager::RegisterComponentMetaTable()
 {
@@ -848,6 +2551,74 @@ void LuaManager::RegisterComponentMetaTable()
     lua_pop(m_LuaState, 1); // Pop the metatable
 }
 
+// Function to register the Vec3MetaTable
+void LuaManager::RegisterVec3MetaTable()
+{
+    luaL_newmetatable(m_LuaState, "Vec3MetaTable");
+
+    // Methods, looked up by __index after the x/y/z fast path
+    lua_newtable(m_LuaState);
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Set);
+    lua_setfield(m_LuaState, -2, "Set");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_AddInPlace);
+    lua_setfield(m_LuaState, -2, "Add");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_SubInPlace);
+    lua_setfield(m_LuaState, -2, "Sub");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Scale);
+    lua_setfield(m_LuaState, -2, "Scale");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Normalize);
+    lua_setfield(m_LuaState, -2, "Normalize");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Length);
+    lua_setfield(m_LuaState, -2, "Length");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Dot);
+    lua_setfield(m_LuaState, -2, "Dot");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Cross);
+    lua_setfield(m_LuaState, -2, "Cross");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Clone);
+    lua_setfield(m_LuaState, -2, "Clone");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Unpack);
+    lua_setfield(m_LuaState, -2, "Unpack");
+
+    lua_pushcclosure(m_LuaState, Lua_Vec3_Index, 1);
+    lua_setfield(m_LuaState, -2, "__index");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_NewIndex);
+    lua_setfield(m_LuaState, -2, "__newindex");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Add);
+    lua_setfield(m_LuaState, -2, "__add");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Sub);
+    lua_setfield(m_LuaState, -2, "__sub");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Mul);
+    lua_setfield(m_LuaState, -2, "__mul");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Div);
+    lua_setfield(m_LuaState, -2, "__div");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Unm);
+    lua_setfield(m_LuaState, -2, "__unm");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_Eq);
+    lua_setfield(m_LuaState, -2, "__eq");
+
+    lua_pushcfunction(m_LuaState, Lua_Vec3_ToString);
+    lua_setfield(m_LuaState, -2, "__tostring");
+
+    lua_pop(m_LuaState, 1); // Pop the metatable
+}
+
 // Function to register the TransformMetaTable
 void LuaManager::RegisterTransformComponentMetaTable()
 {
@@ -875,6 +2646,19 @@ void LuaManager::RegisterTransformComponentMetaTable()
     lua_pushcfunction(m_LuaState, Lua_TransformComponent_SetRotation);
     lua_setfield(m_LuaState, -2, "SetRotation");
 
+    // Garbage-free variants
+    lua_pushcfunction(m_LuaState, Lua_TransformComponent_GetPositionXYZ);
+    lua_setfield(m_LuaState, -2, "GetPositionXYZ");
+
+    lua_pushcfunction(m_LuaState, Lua_TransformComponent_SetPositionXYZ);
+    lua_setfield(m_LuaState, -2, "SetPositionXYZ");
+
+    lua_pushcfunction(m_LuaState, Lua_TransformComponent_GetRotationXYZ);
+    lua_setfield(m_LuaState, -2, "GetRotationXYZ");
+
+    lua_pushcfunction(m_LuaState, Lua_TransformComponent_SetRotationXYZ);
+    lua_setfield(m_LuaState, -2, "SetRotationXYZ");
+
     // Add more Transform-specific methods as needed
 
     lua_settable(m_LuaState, -3); // Set __index to the table with methods
@@ -942,6 +2726,9 @@ void LuaManager::RegisterGameObjectMetatable()
     lua_pushcfunction(m_LuaState, Lua_GameObject_GetComponent);
     lua_setfield(m_LuaState, -2, "GetComponent");
 
+    lua_pushcfunction(m_LuaState, Lua_GameObject_IsValid);
+    lua_setfield(m_LuaState, -2, "IsValid");
+
     // Add more methods as needed
 
     lua_settable(m_LuaState, -3); // Set __index to the table with methods
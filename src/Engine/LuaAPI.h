@@ -16,6 +16,9 @@ extern "C"
 #include <variant>
 #include <unordered_map>
 #include <vector>
+#include <cstdint>
+
+#include "Engine/EntityHandle.h"
 
 // Forward declarations to avoid circular dependencies
 class Component;
@@ -25,6 +28,53 @@ class ScriptComponent;
 class GameObject;
 class LoggerWindow;
 
+// Result of LuaManager::BenchmarkInitialization
+struct LuaInitBenchmark
+{
+    int Scripts = 0;
+    bool Shared = false;
+    int Failures = 0;
+    double TotalMs = 0.0;
+    double PerScriptUs = 0.0;
+    size_t TotalBytes = 0;    // Lua heap attributable to the scripts
+    double BytesPerScript = 0.0;
+    size_t SharedBaseBytes = 0; // Shared VM heap before any script was loaded (libs, metatables)
+};
+
+// Per-script resource usage, see LuaManager::GetScriptStats
+struct LuaScriptStats
+{
+    std::string Name;
+    std::string Path;
+    bool Shared = false;
+    size_t MemoryBytes = 0;     // Live Lua heap allocated while the script was running
+    size_t PeakMemoryBytes = 0;
+    size_t MemoryLimit = 0;     // 0 = unlimited
+    int MemoryLimitHits = 0;    // Allocations refused because of the limit
+    long long Instructions = 0; // VM instructions in the last completed frame (hook granularity)
+    double CpuMs = 0.0;         // Time spent in the script in the last completed frame
+    bool Suspended = false;     // Ran out of instruction budget and continues next frame
+    int BudgetYields = 0;       // Times the script was suspended for exceeding its budget
+};
+
+// Collector mode used for every Lua state
+enum class LuaGCMode
+{
+    Generational,
+    Incremental
+};
+
+// What LuaManager::CollectGarbage did in the last frame
+struct LuaGCStats
+{
+    double Ms = 0.0;       // Time spent collecting
+    double BudgetMs = 0.0; // Time the frame could spare
+    int Steps = 0;         // lua_gc(LUA_GCSTEP) calls
+    int Cycles = 0;        // Completed incremental cycles and major collections
+    int ForcedSteps = 0;   // Steps taken over budget because a heap grew too far
+    size_t HeapBytes = 0;  // Total heap of all states afterwards
+};
+
 // LuaManager class definition
 class LuaManager
 {
@@ -38,15 +88,34 @@ public:
     /**
      * @brief Initializes the LuaManager with the specified Lua script.
      *
-     * This function creates a new Lua state, opens standard libraries,
-     * registers all necessary metatables, binds essential functions to Lua,
-     * and executes the provided Lua script.
+     * In shared mode the script runs inside the engine-wide Lua state with its
+     * own _ENV table (falling back to _G for reads), so standard libraries,
+     * metatables and the Engine table are only set up once. In isolated mode
+     * a new Lua state is created for the script.
      *
      * @param scriptPath The file path to the Lua script to execute.
      * @return true if initialization is successful; false otherwise.
      */
     bool Initialize(const std::string &scriptPath);
 
+    /**
+     * @brief Selects whether scripts initialized from now on share one Lua state.
+     */
+    static void SetSharedStateEnabled(bool enabled) { s_SharedStateEnabled = enabled; }
+    static bool IsSharedStateEnabled() { return s_SharedStateEnabled; }
+
+    // The engine-wide Lua state, created on first use
+    static lua_State *GetSharedState();
+
+    // Closes the shared state; every LuaManager using it must be destroyed first
+    static void ShutdownSharedState();
+
+    /**
+     * @brief Initializes `count` managers with the same script and measures
+     * time and Lua heap usage per script.
+     */
+    static LuaInitBenchmark BenchmarkInitialization(const std::string &scriptPath, int count, bool shared);
+
     /**
      * @brief Updates the LuaManager each frame.
      *
@@ -58,6 +127,115 @@ public:
      */
     void Update(float deltaTime);
 
+    /**
+     * @brief Runs every shared-state script's `OnUpdate` from one Lua-side loop.
+     *
+     * Scripts in the shared state are not updated through Update(); they are
+     * registered with a Lua scheduler when they define `OnUpdate` and this
+     * single call from the engine iterates them inside the VM.
+     */
+    static void UpdateAll(float deltaTime);
+
+    /**
+     * @brief Resumes coroutines started with `Engine.StartCoroutine` whose wait is over.
+     *
+     * Waiting coroutines sit in timer heaps (game time for `Engine.Wait`,
+     * frame numbers for `Engine.WaitFrames`) or on a pending asset load, so
+     * only the ones that are due are touched; a script that is only waiting
+     * costs nothing per frame. Called from UpdateAll.
+     */
+    static void UpdateTasks(float deltaTime);
+
+    /**
+     * @brief Thread-safe scripts always get a private Lua state and, with
+     * parallel updates enabled, run `OnUpdate` on the job system.
+     *
+     * Set before Initialize. Such a script must not rely on seeing other
+     * scripts' writes from the same frame: transforms read during the parallel
+     * pass are the state from before it, and its own transform writes are
+     * applied after every parallel script has finished.
+     */
+    void SetThreadSafe(bool threadSafe) { m_ThreadSafe = threadSafe; }
+    bool IsThreadSafe() const { return m_ThreadSafe; }
+
+    // Opt-in: run thread-safe scripts concurrently in UpdateParallel instead of one by one in Update
+    static void SetParallelUpdatesEnabled(bool enabled) { s_ParallelUpdates = enabled; }
+    static bool IsParallelUpdatesEnabled() { return s_ParallelUpdates; }
+
+    // Whether this script's OnUpdate is run by UpdateParallel (callers then skip Update)
+    bool RunsInParallel() const { return s_ParallelUpdates && m_ThreadSafe && m_LuaState && !m_UsesSharedState; }
+
+    /**
+     * @brief Runs `OnUpdate` of every thread-safe script on worker threads.
+     *
+     * Transform writes made by the scripts are buffered per script and
+     * applied afterwards on the calling thread, script by script in creation
+     * order, so the result doesn't depend on thread timing.
+     */
+    static void UpdateParallel(float deltaTime);
+
+    // Coroutines currently started and not finished, over all scripts
+    static size_t GetTaskCount();
+
+    // Calls the script's cached `OnInit`, then re-reads the lifecycle functions it may have defined
+    void Init();
+
+    // Whether the script has an `OnUpdate` to run each frame
+    bool HasUpdate() const { return m_OnUpdateRef != LUA_NOREF; }
+
+    /**
+     * @brief Instructions a script may execute per frame before its `OnUpdate`
+     * is suspended (as a coroutine) and resumed on the next frame. 0 disables.
+     *
+     * Code that can't yield (the main chunk, OnInit, C callbacks) is aborted
+     * with an error once it exceeds ten times the budget instead.
+     */
+    static void SetInstructionBudget(long long instructions) { s_InstructionBudget = instructions; }
+    static long long GetInstructionBudget() { return s_InstructionBudget; }
+
+    // Lua heap cap per script in bytes (0 = unlimited); allocations past it fail with "not enough memory"
+    static void SetMemoryLimit(size_t bytes);
+    static size_t GetMemoryLimit() { return s_MemoryLimit; }
+
+    // CPU, instruction and memory usage of every live script
+    static std::vector<LuaScriptStats> GetScriptStats();
+
+    // Lua heap not attributed to any script (shared libraries, metatables, scheduler)
+    static size_t GetEngineMemoryBytes();
+
+    /**
+     * @brief Runs the Lua garbage collector within a time budget.
+     *
+     * With engine-driven GC enabled the collector of every Lua state is
+     * stopped and only advances here, once per frame, so collection work no
+     * longer lands in the middle of a script's OnUpdate. In generational mode
+     * a state gets one young (or, when due, major) collection once its heap
+     * has grown enough; in incremental mode steps are taken until the budget
+     * is spent. A state whose heap has doubled is stepped even over budget.
+     *
+     * @param budgetMs Time the current frame can spare, see ComputeGCBudget.
+     */
+    static void CollectGarbage(double budgetMs);
+
+    // GC budget for a frame whose work so far took `frameWorkMs`: the headroom left to the target frame time, clamped
+    static double ComputeGCBudget(double frameWorkMs);
+
+    static void SetGCMode(LuaGCMode mode);
+    static LuaGCMode GetGCMode() { return s_GCMode; }
+
+    // Off restores Lua's own allocation-driven collection
+    static void SetEngineDrivenGC(bool enabled);
+    static bool IsEngineDrivenGC() { return s_EngineDrivenGC; }
+
+    // Frame time the GC budget is derived from (default 60 fps)
+    static void SetGCTargetFrameMs(double ms) { s_GCTargetFrameMs = ms; }
+    static double GetGCTargetFrameMs() { return s_GCTargetFrameMs; }
+
+    static const LuaGCStats &GetGCStats() { return s_GCStats; }
+
+    // Allocator used for every Lua state; tags each block with the script that allocated it
+    static void *Allocate(void *userData, void *ptr, size_t oldSize, size_t newSize);
+
     void CallLuaFunction(std::string functionName);
 
     using LuaExposedVariant = std::variant<int, float, std::string, bool>;
@@ -73,18 +251,116 @@ private:
     // Lua state
     std::string ScriptPath;
 
-    static std::string m_ScriptName;
+    std::string m_ScriptName;
 
     lua_State *m_LuaState;
 
-    static std::unordered_map<std::string, LuaExposedVariant> m_ExposedVariables;
+    // Registry reference to the script's _ENV table (shared mode only)
+    int m_EnvironmentRef;
+    bool m_UsesSharedState;
+
+    // Registry references to the lifecycle functions, looked up once instead of by name every call
+    int m_OnInitRef;
+    int m_OnUpdateRef;
+
+    // Coroutine OnUpdate runs in (isolated mode; the shared scheduler keeps its own)
+    int m_UpdateThreadRef;
+
+    // Runs OnUpdate on the job system when parallel updates are enabled
+    bool m_ThreadSafe;
+
+    // Memory account blocks allocated by this script are charged to
+    uint32_t m_MemoryAccount;
+
+    // Budget bookkeeping for the frame in progress and the last completed one
+    long long m_InstructionsThisFrame;
+    long long m_InstructionsLastFrame;
+    double m_CpuMsThisFrame;
+    double m_CpuMsLastFrame;
+    bool m_Suspended;
+    int m_BudgetYields;
+
+    std::unordered_map<std::string, LuaExposedVariant> m_ExposedVariables;
+
+    static lua_State *s_SharedState;
+    static bool s_SharedStateEnabled;
+
+    // Script whose code is currently running on this thread; bindings use it to find "their" script
+    static thread_local LuaManager *s_ActiveManager;
+
+    static bool s_ParallelUpdates;
+
+    static long long s_InstructionBudget;
+    static size_t s_MemoryLimit;
+
+    static LuaGCMode s_GCMode;
+    static bool s_EngineDrivenGC;
+    static double s_GCTargetFrameMs;
+    static LuaGCStats s_GCStats;
+
+    // Applies the GC mode and stop/restart to one state
+    static void ConfigureGC(lua_State *L);
+
+    // Count hook: charges instructions to the active script and suspends it when over budget
+    static void InstructionHook(lua_State *L, lua_Debug *ar);
+
+    // Moves this frame's counters to "last frame"
+    void RollFrameStats();
+
+    // Creates a Lua state using Allocate and the instruction hook
+    static lua_State *NewState(uint32_t memoryAccount);
+
+    // Registry references to the shared state's update scheduler table and its Update function
+    static int s_SchedulerRef;
+    static int s_SchedulerUpdateRef;
+
+    // Sets s_ActiveManager for the lifetime of the scope
+    struct ActiveScope
+    {
+        LuaManager *Previous;
+        explicit ActiveScope(LuaManager *manager) : Previous(s_ActiveManager) { s_ActiveManager = manager; }
+        ~ActiveScope() { s_ActiveManager = Previous; }
+    };
+
+    // Releases the script's environment or private state
+    void Shutdown();
+
+    // Pushes the table the script's globals live in onto L (m_LuaState or one of its threads)
+    void PushEnvironment(lua_State *L);
+
+    // Opens libraries and registers metatables/Engine table on m_LuaState
+    void SetupState();
+
+    // Creates the Lua-side update loop in the shared state
+    static bool CreateScheduler(lua_State *L);
+
+    // Caches OnInit/OnUpdate as registry refs and (un)registers the script with the scheduler
+    void RefreshLifecycleFunctions();
+    void ReleaseLifecycleFunctions();
+
+    // Calls Scheduler.<method>(this[, OnUpdate])
+    void CallScheduler(const char *method, bool passUpdate);
+
+    // Runs a coroutine task until it waits or ends; `nargs` values are on its stack
+    static void ResumeTask(uint32_t task, int nargs);
+
+    // Hands a finished asset load to its task and resumes it
+    static void CompleteLoad(uint32_t task);
+
+    // Ends every coroutine this script started
+    void StopTasks();
+
+    // Logs a Lua error once until a different one occurs
+    void ReportError(const std::string &context, const char *message);
 
 
     // Last error message to prevent duplicate logging
     std::string m_LastErrorMessage;
     void RegisterAllMetatables();
+    void RegisterEngineTable();
     void RegisterComponentMetaTable();
 
+    void RegisterVec3MetaTable();
     void RegisterTransformComponentMetaTable();
     void RegisterMeshComponentMetaTable();
     void RegisterScriptComponentMetaTable();
@@ -100,6 +376,33 @@ private:
     static int Lua_TransformComponent_GetRotation(lua_State *L);
     static int Lua_TransformComponent_SetRotation(lua_State *L);
 
+    static int Lua_TransformComponent_GetPositionXYZ(lua_State *L);
+    static int Lua_TransformComponent_SetPositionXYZ(lua_State *L);
+    static int Lua_TransformComponent_GetRotationXYZ(lua_State *L);
+    static int Lua_TransformComponent_SetRotationXYZ(lua_State *L);
+
+    // Binding functions for Vec3
+    static int Lua_Vec3_New(lua_State *L);
+    static int Lua_Vec3_Index(lua_State *L);
+    static int Lua_Vec3_NewIndex(lua_State *L);
+    static int Lua_Vec3_Add(lua_State *L);
+    static int Lua_Vec3_Sub(lua_State *L);
+    static int Lua_Vec3_Mul(lua_State *L);
+    static int Lua_Vec3_Div(lua_State *L);
+    static int Lua_Vec3_Unm(lua_State *L);
+    static int Lua_Vec3_Eq(lua_State *L);
+    static int Lua_Vec3_ToString(lua_State *L);
+    static int Lua_Vec3_Set(lua_State *L);
+    static int Lua_Vec3_AddInPlace(lua_State *L);
+    static int Lua_Vec3_SubInPlace(lua_State *L);
+    static int Lua_Vec3_Scale(lua_State *L);
+    static int Lua_Vec3_Normalize(lua_State *L);
+    static int Lua_Vec3_Length(lua_State *L);
+    static int Lua_Vec3_Dot(lua_State *L);
+    static int Lua_Vec3_Cross(lua_State *L);
+    static int Lua_Vec3_Clone(lua_State *L);
+    static int Lua_Vec3_Unpack(lua_State *L);
+
     // Binding functions for MeshComponent
     static int Lua_MeshComponent_GetMeshData(lua_State *L);
 
@@ -109,14 +412,44 @@ private:
     // Binding functions for GameObject
     static int Lua_GameObject_GetName(lua_State *L);
     static int Lua_GameObject_GetComponent(lua_State *L);
+    static int Lua_GameObject_IsValid(lua_State *L);
     static int Lua_GetGameObjectByTag(lua_State *L);
 
     // Binding functions for Engine table
     static int Lua_Engine_Log(lua_State *L);
     static int Lua_Engine_ScriptName(lua_State *L);
     static int Lua_Engine_GetGameObjectByTag(lua_State *L);
+    static int Lua_Engine_GetGameObjectByName(lua_State *L);
+    static int Lua_Engine_GetGameObjectsByTag(lua_State *L);
+    static int Lua_Engine_StartCoroutine(lua_State *L);
+    static int Lua_Engine_StopCoroutine(lua_State *L);
+    static int Lua_Engine_Wait(lua_State *L);
+    static int Lua_Engine_WaitFrames(lua_State *L);
+    static int Lua_Engine_LoadAsync(lua_State *L);
+    static int Lua_Engine_CaptureTrace(lua_State *L);
+
+    // Pushes a GameObject userdata, or nil for nullptr
+    static void PushGameObject(lua_State *L, GameObject *gameObject);
+
+    // Handle userdata: created once per live object and state, cached in a weak table
+    static void CreateHandleCache(lua_State *L);
+    static void PushHandle(lua_State *L, EntityHandle handle, const char *metatable);
+
+    // Resolves a handle argument; raises a Lua error if the object has been destroyed
+    static void *CheckHandle(lua_State *L, int index, const char *metatable);
+    static GameObject *CheckGameObject(lua_State *L, int index);
+
+    template <typename T>
+    static T *CheckComponent(lua_State *L, int index, const char *metatable)
+    {
+        return static_cast<T *>(static_cast<Component *>(CheckHandle(L, index, metatable)));
+    }
     static int Lua_Engine_Expose(lua_State* L);
 
+    // Called by the scheduler's update loop
+    static int Lua_Scheduler_SetActive(lua_State *L);
+    static int Lua_Scheduler_ReportError(lua_State *L);
+
     
 
 };
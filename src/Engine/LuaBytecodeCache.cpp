@@ -0,0 +1,264 @@
+// LuaBytecodeCache.cpp
+
+#include "LuaBytecodeCache.h"
+#include "Engine/Utilitys.h"
+#include "gcml.h"
+
+extern "C"
+{
+#include <lauxlib.h>
+}
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+// FNV-1a 64 bit
+static uint64_t HashBytes(const char *data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static std::string ToHex(uint64_t value)
+{
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(value));
+    return buffer;
+}
+
+static bool ReadFile(const fs::path &path, std::string &contents)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    contents = stream.str();
+    return true;
+}
+
+static int DumpWriter(lua_State *, const void *p, size_t size, void *userData)
+{
+    static_cast<std::string *>(userData)->append(static_cast<const char *>(p), size);
+    return 0;
+}
+
+// Same preprocessing luaL_loadfile does: skip a UTF-8 BOM and a leading '#' line (keeping line numbers)
+static void StripSourcePrefix(std::string &source)
+{
+    if (source.compare(0, 3, "\xEF\xBB\xBF") == 0)
+        source.erase(0, 3);
+    if (!source.empty() && source[0] == '#')
+    {
+        size_t lineEnd = source.find('\n');
+        source.erase(0, lineEnd == std::string::npos ? source.size() : lineEnd);
+    }
+}
+
+int LuaBytecodeCache::Load(lua_State *L, const std::string &path)
+{
+    std::string chunkName = "@" + path;
+
+    std::string source;
+    if (!ReadFile(path, source))
+    {
+        lua_pushfstring(L, "cannot open %s", path.c_str());
+        return LUA_ERRFILE;
+    }
+
+    StripSourcePrefix(source);
+
+    // Precompiled files are loaded as they are
+    if (!source.empty() && source[0] == LUA_SIGNATURE[0])
+        return luaL_loadbufferx(L, source.data(), source.size(), chunkName.c_str(), "b");
+
+    if (!m_Enabled)
+        return luaL_loadbufferx(L, source.data(), source.size(), chunkName.c_str(), "t");
+
+    uint64_t sourceHash = HashBytes(source.data(), source.size());
+
+    bool stale = false;
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        auto it = m_Entries.find(path);
+        if (it != m_Entries.end())
+        {
+            if (it->second.SourceHash == sourceHash)
+            {
+                int status = luaL_loadbufferx(L, it->second.Bytecode.data(), it->second.Bytecode.size(), chunkName.c_str(), "b");
+                if (status == LUA_OK)
+                {
+                    m_Stats.MemoryHits++;
+                    return LUA_OK;
+                }
+                lua_pop(L, 1);
+            }
+            stale = true;
+        }
+    }
+
+    std::string bytecode;
+    if (ReadDisk(path, sourceHash, bytecode))
+    {
+        // Bytecode from another Lua build fails the header check and is simply recompiled
+        if (luaL_loadbufferx(L, bytecode.data(), bytecode.size(), chunkName.c_str(), "b") == LUA_OK)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            Entry &entry = m_Entries[path];
+            m_Stats.MemoryBytes -= entry.Bytecode.size();
+            m_Stats.MemoryBytes += bytecode.size();
+            entry.SourceHash = sourceHash;
+            entry.Bytecode = std::move(bytecode);
+            m_Stats.DiskHits++;
+            return LUA_OK;
+        }
+        lua_pop(L, 1);
+    }
+
+    if (stale)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stats.Invalidations++;
+    }
+
+    return Compile(L, path, source, sourceHash);
+}
+
+int LuaBytecodeCache::Compile(lua_State *L, const std::string &path, const std::string &source, uint64_t sourceHash)
+{
+    std::string chunkName = "@" + path;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    int status = luaL_loadbufferx(L, source.data(), source.size(), chunkName.c_str(), "t");
+    if (status != LUA_OK)
+        return status;
+
+    // Keep debug info so runtime errors still report line numbers
+    std::string bytecode;
+    if (lua_dump(L, DumpWriter, &bytecode, 0) != 0 || bytecode.empty())
+        return LUA_OK;
+    double compileMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+    WriteDisk(path, sourceHash, bytecode);
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    Entry &entry = m_Entries[path];
+    m_Stats.MemoryBytes -= entry.Bytecode.size();
+    m_Stats.MemoryBytes += bytecode.size();
+    entry.SourceHash = sourceHash;
+    entry.Bytecode = std::move(bytecode);
+    m_Stats.Compiles++;
+    m_Stats.CompileMs += compileMs;
+
+    DEBUG_PRINT("LuaBytecodeCache: compiled %s (%.3f ms)", path.c_str(), compileMs);
+    return LUA_OK;
+}
+
+void LuaBytecodeCache::SetCacheDirectory(const fs::path &directory)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_CacheDirectory = directory;
+}
+
+fs::path LuaBytecodeCache::GetCacheDirectory()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_CacheDirectory.empty())
+    {
+        // Bytecode is only valid for the VM version that produced it
+        try
+        {
+            m_CacheDirectory = createTempFolder() / ("lua_bytecode_" + std::to_string(LUA_VERSION_NUM));
+        }
+        catch (const fs::filesystem_error &e)
+        {
+            DEBUG_PRINT("LuaBytecodeCache: no cache directory: %s", e.what());
+        }
+    }
+    return m_CacheDirectory;
+}
+
+LuaBytecodeCacheStats LuaBytecodeCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Stats;
+}
+
+// <hash of path>-<hash of source>.luac, so a changed source never matches an old file
+fs::path LuaBytecodeCache::DiskPath(const std::string &path, uint64_t sourceHash)
+{
+    fs::path directory = GetCacheDirectory();
+    if (directory.empty())
+        return fs::path();
+    return directory / (ToHex(HashBytes(path.data(), path.size())) + "-" + ToHex(sourceHash) + ".luac");
+}
+
+bool LuaBytecodeCache::ReadDisk(const std::string &path, uint64_t sourceHash, std::string &bytecode)
+{
+    fs::path file = DiskPath(path, sourceHash);
+    return !file.empty() && ReadFile(file, bytecode) && !bytecode.empty();
+}
+
+void LuaBytecodeCache::WriteDisk(const std::string &path, uint64_t sourceHash, const std::string &bytecode)
+{
+    fs::path file = DiskPath(path, sourceHash);
+    if (file.empty())
+        return;
+
+    std::error_code ec;
+    fs::create_directories(file.parent_path(), ec);
+    if (ec)
+        return;
+
+    // Remove bytecode of previous versions of this script
+    std::string prefix = ToHex(HashBytes(path.data(), path.size())) + "-";
+    for (const auto &existing : fs::directory_iterator(file.parent_path(), ec))
+    {
+        std::string name = existing.path().filename().string();
+        if (name.compare(0, prefix.size(), prefix) == 0)
+            fs::remove(existing.path(), ec);
+    }
+
+    // Write to a temporary name first so a concurrent reader never sees a partial file
+    fs::path temporary = file;
+    temporary += ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out)
+            return;
+        out.write(bytecode.data(), static_cast<std::streamsize>(bytecode.size()));
+        if (!out)
+            return;
+    }
+    fs::rename(temporary, file, ec);
+    if (ec)
+        fs::remove(temporary, ec);
+}
+
+void LuaBytecodeCache::Clear(bool includeDisk)
+{
+    fs::path directory = includeDisk ? GetCacheDirectory() : fs::path();
+
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Entries.clear();
+    m_Stats.MemoryBytes = 0;
+
+    if (!directory.empty())
+    {
+        std::error_code ec;
+        for (const auto &existing : fs::directory_iterator(directory, ec))
+        {
+            if (existing.path().extension() == ".luac")
+                fs::remove(existing.path(), ec);
+        }
+    }
+}
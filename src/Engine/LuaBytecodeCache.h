@@ -0,0 +1,90 @@
+// LuaBytecodeCache.h
+#pragma once
+
+extern "C"
+{
+#include <lua.h>
+}
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Counters for LuaBytecodeCache::Load
+struct LuaBytecodeCacheStats
+{
+    int MemoryHits = 0;
+    int DiskHits = 0;
+    int Compiles = 0;         // Source had to be compiled (first use or changed file)
+    int Invalidations = 0;    // Cached bytecode found for an older version of the source
+    double CompileMs = 0.0;   // Time spent compiling source
+    size_t MemoryBytes = 0;   // Bytecode held in memory
+};
+
+/**
+ * @brief Caches compiled Lua chunks (lua_dump output) so scripts are only
+ * lexed and compiled when their source changes.
+ *
+ * Entries are keyed by script path and a hash of the source, both in memory
+ * and as files in an on-disk cache directory. The source file is still read
+ * and hashed on every load, so editing a .lua file invalidates its bytecode
+ * automatically.
+ */
+class LuaBytecodeCache
+{
+public:
+    static LuaBytecodeCache &Get()
+    {
+        static LuaBytecodeCache instance;
+        return instance;
+    }
+
+    /**
+     * @brief Drop-in replacement for luaL_loadfile.
+     *
+     * Pushes the compiled chunk (or an error message) onto the stack of `L`.
+     * The chunk name is "@path" so error messages and tracebacks still refer
+     * to the source file.
+     *
+     * @return LUA_OK on success, otherwise the luaL_loadfile style error code.
+     */
+    int Load(lua_State *L, const std::string &path);
+
+    // Drops the in-memory entries; with `includeDisk` the cache directory is emptied too
+    void Clear(bool includeDisk);
+
+    void SetEnabled(bool enabled) { m_Enabled = enabled; }
+    bool IsEnabled() const { return m_Enabled; }
+
+    // Directory the .luac files are written to (created on first write)
+    void SetCacheDirectory(const std::filesystem::path &directory);
+    std::filesystem::path GetCacheDirectory();
+
+    LuaBytecodeCacheStats GetStats();
+
+private:
+    LuaBytecodeCache() {}
+    LuaBytecodeCache(const LuaBytecodeCache &) = delete;
+    LuaBytecodeCache &operator=(const LuaBytecodeCache &) = delete;
+
+    struct Entry
+    {
+        uint64_t SourceHash = 0;
+        std::string Bytecode;
+    };
+
+    // Compiles the source and stores the dumped chunk; leaves the chunk (or error) on the stack
+    int Compile(lua_State *L, const std::string &path, const std::string &source, uint64_t sourceHash);
+
+    std::filesystem::path DiskPath(const std::string &path, uint64_t sourceHash);
+    bool ReadDisk(const std::string &path, uint64_t sourceHash, std::string &bytecode);
+    void WriteDisk(const std::string &path, uint64_t sourceHash, const std::string &bytecode);
+
+    bool m_Enabled = true;
+    std::filesystem::path m_CacheDirectory;
+    std::unordered_map<std::string, Entry> m_Entries;
+    LuaBytecodeCacheStats m_Stats;
+    std::mutex m_Mutex;
+};
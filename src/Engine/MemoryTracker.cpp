@@ -0,0 +1,230 @@
+// MemoryTracker.cpp
+
+#include "MemoryTracker.h"
+#include "Windows/LoggerWindow.h"
+
+#include <cstdlib>
+#include <new>
+
+extern LoggerWindow *g_LoggerWindow;
+
+// Live counters; constant-initialized, so allocations during static initialization are counted safely
+struct MemoryTagCounters
+{
+    std::atomic<int64_t> Current;
+    std::atomic<int64_t> Peak;
+    std::atomic<int64_t> Live;
+    std::atomic<int64_t> Total;
+};
+
+static MemoryTagCounters s_Counters[static_cast<size_t>(MemoryTag::Count)];
+
+// Precedes every block from MemoryTracker::Allocate; 16 bytes keeps the payload aligned for any fundamental type
+struct alignas(16) MemoryBlockHeader
+{
+    uint64_t Size;
+    uint32_t Tag;
+    uint32_t Reserved;
+};
+
+static_assert(sizeof(MemoryBlockHeader) == 16, "MemoryBlockHeader must preserve malloc alignment");
+
+MemoryTracker &MemoryTracker::Get()
+{
+    static MemoryTracker instance;
+    return instance;
+}
+
+MemoryTracker::MemoryTracker()
+{
+    // Defaults for the subsystems that only grow by accident; the rest are unbounded until set
+    SetBudget(MemoryTag::Logger, 16 * 1024 * 1024);
+    SetBudget(MemoryTag::Profiler, 64 * 1024 * 1024);
+    SetBudget(MemoryTag::Lua, 256 * 1024 * 1024);
+}
+
+const char *MemoryTracker::TagName(MemoryTag tag)
+{
+    switch (tag)
+    {
+    case MemoryTag::General:
+        return "General";
+    case MemoryTag::Assets:
+        return "Assets";
+    case MemoryTag::Textures:
+        return "Textures";
+    case MemoryTag::Lua:
+        return "Lua";
+    case MemoryTag::Scene:
+        return "Scene";
+    case MemoryTag::Logger:
+        return "Logger";
+    case MemoryTag::Profiler:
+        return "Profiler";
+    case MemoryTag::Editor:
+        return "Editor";
+    default:
+        return "Unknown";
+    }
+}
+
+void MemoryTracker::RecordAllocation(MemoryTag tag, size_t bytes)
+{
+    MemoryTagCounters &counters = s_Counters[static_cast<size_t>(tag)];
+    int64_t current = counters.Current.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) + static_cast<int64_t>(bytes);
+    counters.Live.fetch_add(1, std::memory_order_relaxed);
+    counters.Total.fetch_add(1, std::memory_order_relaxed);
+
+    int64_t peak = counters.Peak.load(std::memory_order_relaxed);
+    while (current > peak && !counters.Peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+    {
+    }
+}
+
+void MemoryTracker::RecordFree(MemoryTag tag, size_t bytes)
+{
+    MemoryTagCounters &counters = s_Counters[static_cast<size_t>(tag)];
+    counters.Current.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+    counters.Live.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::RecordResize(MemoryTag tag, size_t oldBytes, size_t newBytes)
+{
+    MemoryTagCounters &counters = s_Counters[static_cast<size_t>(tag)];
+    int64_t delta = static_cast<int64_t>(newBytes) - static_cast<int64_t>(oldBytes);
+    int64_t current = counters.Current.fetch_add(delta, std::memory_order_relaxed) + delta;
+
+    int64_t peak = counters.Peak.load(std::memory_order_relaxed);
+    while (current > peak && !counters.Peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+    {
+    }
+}
+
+void *MemoryTracker::Allocate(size_t size, MemoryTag tag)
+{
+    MemoryBlockHeader *header = static_cast<MemoryBlockHeader *>(std::malloc(size + sizeof(MemoryBlockHeader)));
+    if (!header)
+        return nullptr;
+
+    header->Size = size;
+    header->Tag = static_cast<uint32_t>(tag);
+    RecordAllocation(tag, size);
+    return header + 1;
+}
+
+void *MemoryTracker::Reallocate(void *ptr, size_t size, MemoryTag tag)
+{
+    if (!ptr)
+        return Allocate(size, tag);
+
+    MemoryBlockHeader *header = static_cast<MemoryBlockHeader *>(ptr) - 1;
+    uint64_t oldSize = header->Size;
+    MemoryTag oldTag = static_cast<MemoryTag>(header->Tag);
+
+    MemoryBlockHeader *resized = static_cast<MemoryBlockHeader *>(std::realloc(header, size + sizeof(MemoryBlockHeader)));
+    if (!resized)
+        return nullptr;
+
+    // The block stays with the tag that allocated it
+    resized->Size = size;
+    RecordResize(oldTag, oldSize, size);
+    return resized + 1;
+}
+
+void MemoryTracker::Free(void *ptr)
+{
+    if (!ptr)
+        return;
+
+    MemoryBlockHeader *header = static_cast<MemoryBlockHeader *>(ptr) - 1;
+    RecordFree(static_cast<MemoryTag>(header->Tag), header->Size);
+    std::free(header);
+}
+
+void MemoryTracker::EndFrame()
+{
+    m_TotalBytes = 0;
+    m_TotalFrameAllocations = 0;
+
+    for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i)
+    {
+        const MemoryTagCounters &counters = s_Counters[i];
+        MemoryTagStats &stats = m_Snapshot[i];
+
+        stats.CurrentBytes = counters.Current.load(std::memory_order_relaxed);
+        stats.PeakBytes = counters.Peak.load(std::memory_order_relaxed);
+        stats.LiveAllocations = counters.Live.load(std::memory_order_relaxed);
+        stats.TotalAllocations = counters.Total.load(std::memory_order_relaxed);
+        stats.FrameAllocations = stats.TotalAllocations - m_LastTotalAllocations[i];
+        m_LastTotalAllocations[i] = stats.TotalAllocations;
+
+        m_TotalBytes += stats.CurrentBytes;
+        m_TotalFrameAllocations += stats.FrameAllocations;
+
+        // Warn once per crossing, not every frame
+        stats.BudgetBytes = m_Budgets[i];
+        bool overBudget = stats.BudgetBytes > 0 && stats.CurrentBytes > static_cast<int64_t>(stats.BudgetBytes);
+        if (overBudget && !stats.OverBudget && g_LoggerWindow)
+        {
+            g_LoggerWindow->AddLog("[Memory] %s is over budget: %.2f MB of %.2f MB", ImVec4(1.0f, 0.6f, 0.0f, 1.0f),
+                                   TagName(static_cast<MemoryTag>(i)), stats.CurrentBytes / (1024.0 * 1024.0),
+                                   stats.BudgetBytes / (1024.0 * 1024.0));
+        }
+        stats.OverBudget = overBudget;
+    }
+}
+
+// Global allocation hooks: every operator new in the program goes through the tracker
+
+void *operator new(size_t size)
+{
+    void *ptr = MemoryTracker::Allocate(size ? size : 1, MemoryTracker::CurrentTag());
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+void *operator new[](size_t size)
+{
+    return ::operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return MemoryTracker::Allocate(size ? size : 1, MemoryTracker::CurrentTag());
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return MemoryTracker::Allocate(size ? size : 1, MemoryTracker::CurrentTag());
+}
+
+void operator delete(void *ptr) noexcept
+{
+    MemoryTracker::Free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    MemoryTracker::Free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    MemoryTracker::Free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    MemoryTracker::Free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    MemoryTracker::Free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    MemoryTracker::Free(ptr);
+}
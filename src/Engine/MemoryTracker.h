@@ -0,0 +1,102 @@
+// MemoryTracker.h
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Subsystem an allocation is charged to
+enum class MemoryTag : uint8_t
+{
+    General,
+    Assets,
+    Textures,
+    Lua,
+    Scene,
+    Logger,
+    Profiler,
+    Editor,
+    Count
+};
+
+// Snapshot of one tag, taken at the last EndFrame
+struct MemoryTagStats
+{
+    int64_t CurrentBytes = 0;
+    int64_t PeakBytes = 0;
+    int64_t LiveAllocations = 0;
+    int64_t TotalAllocations = 0;
+    int64_t FrameAllocations = 0; // Allocations made during the last frame
+    size_t BudgetBytes = 0;       // 0 = no budget
+    bool OverBudget = false;
+};
+
+/**
+ * @brief Byte and allocation counts per subsystem.
+ *
+ * Global operator new/delete, the Lua allocator, stb_image and ImGui all
+ * report here. Heap blocks carry a small header with their size and tag, so
+ * a block is always credited back to the tag that allocated it. The tag for
+ * operator new comes from the innermost MemoryTagScope on the calling thread.
+ * Counters are relaxed atomics; EndFrame takes a snapshot for display and
+ * logs tags that went over budget.
+ */
+class MemoryTracker
+{
+public:
+    static MemoryTracker &Get();
+
+    static const char *TagName(MemoryTag tag);
+
+    // Tag of new allocations on this thread
+    static MemoryTag CurrentTag() { return t_CurrentTag; }
+
+    // Tracked heap with a header; usable as a malloc/realloc/free replacement
+    static void *Allocate(size_t size, MemoryTag tag);
+    static void *Reallocate(void *ptr, size_t size, MemoryTag tag);
+    static void Free(void *ptr);
+
+    // For allocators that keep their own headers (Lua): only adjusts the counters
+    static void RecordAllocation(MemoryTag tag, size_t bytes);
+    static void RecordFree(MemoryTag tag, size_t bytes);
+    static void RecordResize(MemoryTag tag, size_t oldBytes, size_t newBytes);
+
+    // Snapshots every tag and checks budgets; call once per frame
+    void EndFrame();
+
+    const MemoryTagStats &GetStats(MemoryTag tag) const { return m_Snapshot[static_cast<size_t>(tag)]; }
+    int64_t GetTotalBytes() const { return m_TotalBytes; }
+    int64_t GetTotalFrameAllocations() const { return m_TotalFrameAllocations; }
+
+    size_t GetBudget(MemoryTag tag) const { return m_Budgets[static_cast<size_t>(tag)]; }
+    void SetBudget(MemoryTag tag, size_t bytes) { m_Budgets[static_cast<size_t>(tag)] = bytes; }
+
+private:
+    MemoryTracker();
+    MemoryTracker(const MemoryTracker &) = delete;
+    MemoryTracker &operator=(const MemoryTracker &) = delete;
+
+    static inline thread_local MemoryTag t_CurrentTag = MemoryTag::General;
+
+    MemoryTagStats m_Snapshot[static_cast<size_t>(MemoryTag::Count)];
+    int64_t m_LastTotalAllocations[static_cast<size_t>(MemoryTag::Count)] = {};
+    size_t m_Budgets[static_cast<size_t>(MemoryTag::Count)] = {};
+    int64_t m_TotalBytes = 0;
+    int64_t m_TotalFrameAllocations = 0;
+
+    friend class MemoryTagScope;
+};
+
+// Charges operator new on this thread to `tag` until the scope ends
+class MemoryTagScope
+{
+public:
+    explicit MemoryTagScope(MemoryTag tag) : m_Previous(MemoryTracker::t_CurrentTag) { MemoryTracker::t_CurrentTag = tag; }
+    ~MemoryTagScope() { MemoryTracker::t_CurrentTag = m_Previous; }
+
+    MemoryTagScope(const MemoryTagScope &) = delete;
+    MemoryTagScope &operator=(const MemoryTagScope &) = delete;
+
+private:
+    MemoryTag m_Previous;
+};
@@ -0,0 +1,429 @@
+// MeshOptimizer.cpp
+
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <glm/glm.hpp>
+
+// ------------------------------------------------------------
+// Forsyth "Linear-Speed Vertex Cache Optimisation" tuning values
+// ------------------------------------------------------------
+static const int ForsythCacheSize = 32;
+static const float ForsythCacheDecayPower = 1.5f;
+static const float ForsythLastTriScore = 0.75f;
+static const float ForsythValenceBoostScale = 2.0f;
+static const float ForsythValenceBoostPower = 0.5f;
+
+static float ForsythVertexScore(int cachePosition, unsigned int liveTriangles)
+{
+    if (liveTriangles == 0)
+    {
+        // No triangles left that use this vertex
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        if (cachePosition < 3)
+        {
+            // Vertices of the last triangle get a fixed score so we don't favour strips too much
+            score = ForsythLastTriScore;
+        }
+        else
+        {
+            const float scaler = 1.0f / (ForsythCacheSize - 3);
+            score = 1.0f - (cachePosition - 3) * scaler;
+            score = std::pow(score, ForsythCacheDecayPower);
+        }
+    }
+
+    // Boost vertices with few remaining triangles so lone triangles get cleared out early
+    float valenceBoost = std::pow(static_cast<float>(liveTriangles), -ForsythValenceBoostPower);
+    score += ForsythValenceBoostScale * valenceBoost;
+
+    return score;
+}
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount, unsigned int cacheSize)
+{
+    VertexCacheStats stats;
+
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0)
+        return stats;
+
+    // FIFO emulation using timestamps: a vertex is cached if it was inserted less than cacheSize misses ago
+    std::vector<unsigned int> timestamps(vertexCount, 0);
+    unsigned int time = cacheSize + 1;
+    size_t misses = 0;
+
+    for (unsigned int index : indices)
+    {
+        if (index >= vertexCount)
+            continue;
+
+        if (time - timestamps[index] > cacheSize)
+        {
+            timestamps[index] = time++;
+            misses++;
+        }
+    }
+
+    stats.ACMR = static_cast<float>(misses) / static_cast<float>(triangleCount);
+    stats.ATVR = static_cast<float>(misses) / static_cast<float>(vertexCount);
+    return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int> &indices, size_t vertexCount)
+{
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0)
+        return;
+
+    // Build vertex -> triangle adjacency (CSR layout)
+    std::vector<unsigned int> liveTriangles(vertexCount, 0);
+    for (unsigned int index : indices)
+        liveTriangles[index]++;
+
+    std::vector<unsigned int> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v)
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+
+    std::vector<unsigned int> adjacency(indices.size());
+    {
+        std::vector<unsigned int> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned int v = indices[t * 3 + k];
+                adjacency[fill[v]++] = static_cast<unsigned int>(t);
+            }
+        }
+    }
+
+    // Initial scores
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+        vertexScores[v] = ForsythVertexScore(-1, liveTriangles[v]);
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<char> emitted(triangleCount, 0);
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        triangleScores[t] = vertexScores[indices[t * 3 + 0]] +
+                            vertexScores[indices[t * 3 + 1]] +
+                            vertexScores[indices[t * 3 + 2]];
+    }
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+
+    unsigned int cache[ForsythCacheSize + 3];
+    unsigned int newCache[ForsythCacheSize + 3];
+    int cacheCount = 0;
+
+    size_t bestTriangle = static_cast<size_t>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+    size_t deadEndCursor = 0;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+    {
+        // Fallback when no cached vertex has live triangles: take the next unemitted triangle in input order
+        if (bestTriangle == static_cast<size_t>(-1))
+        {
+            while (deadEndCursor < triangleCount && emitted[deadEndCursor])
+                deadEndCursor++;
+            bestTriangle = deadEndCursor;
+        }
+
+        const unsigned int a = indices[bestTriangle * 3 + 0];
+        const unsigned int b = indices[bestTriangle * 3 + 1];
+        const unsigned int c = indices[bestTriangle * 3 + 2];
+
+        result.push_back(a);
+        result.push_back(b);
+        result.push_back(c);
+        emitted[bestTriangle] = 1;
+
+        // Remove the triangle from the live adjacency of its vertices
+        const unsigned int triangleVertices[3] = {a, b, c};
+        for (unsigned int v : triangleVertices)
+        {
+            unsigned int begin = adjacencyOffsets[v];
+            unsigned int end = begin + liveTriangles[v];
+            for (unsigned int i = begin; i < end; ++i)
+            {
+                if (adjacency[i] == bestTriangle)
+                {
+                    std::swap(adjacency[i], adjacency[end - 1]);
+                    liveTriangles[v]--;
+                    break;
+                }
+            }
+        }
+
+        // Move the triangle's vertices to the front of the LRU cache
+        int newCount = 0;
+        newCache[newCount++] = a;
+        newCache[newCount++] = b;
+        newCache[newCount++] = c;
+        for (int i = 0; i < cacheCount; ++i)
+        {
+            unsigned int v = cache[i];
+            if (v != a && v != b && v != c)
+                newCache[newCount++] = v;
+        }
+
+        // Vertices pushed out of the cache lose their position bonus
+        for (int i = ForsythCacheSize; i < newCount; ++i)
+        {
+            cachePosition[newCache[i]] = -1;
+            vertexScores[newCache[i]] = ForsythVertexScore(-1, liveTriangles[newCache[i]]);
+        }
+
+        cacheCount = std::min(newCount, ForsythCacheSize);
+        std::copy(newCache, newCache + cacheCount, cache);
+
+        for (int i = 0; i < cacheCount; ++i)
+        {
+            cachePosition[cache[i]] = i;
+            vertexScores[cache[i]] = ForsythVertexScore(i, liveTriangles[cache[i]]);
+        }
+
+        // Rescore the live triangles touching the cache and pick the best one
+        bestTriangle = static_cast<size_t>(-1);
+        float bestScore = 0.0f;
+        for (int i = 0; i < cacheCount; ++i)
+        {
+            unsigned int v = cache[i];
+            unsigned int begin = adjacencyOffsets[v];
+            unsigned int end = begin + liveTriangles[v];
+            for (unsigned int j = begin; j < end; ++j)
+            {
+                unsigned int t = adjacency[j];
+                float score = vertexScores[indices[t * 3 + 0]] +
+                              vertexScores[indices[t * 3 + 1]] +
+                              vertexScores[indices[t * 3 + 2]];
+                triangleScores[t] = score;
+
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    bestTriangle = t;
+                }
+            }
+        }
+    }
+
+    indices.swap(result);
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices, float threshold)
+{
+    size_t triangleCount = indices.size() / 3;
+    size_t vertexCount = vertices.size();
+    if (triangleCount == 0 || vertexCount == 0)
+        return;
+
+    const unsigned int cacheSize = StatsCacheSize;
+    const size_t MinClusterTriangles = 16;
+
+    std::vector<unsigned int> timestamps(vertexCount, 0);
+    unsigned int time = cacheSize + 1;
+
+    auto simulateTriangle = [&](size_t t) -> unsigned int
+    {
+        unsigned int misses = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+            unsigned int v = indices[t * 3 + k];
+            if (time - timestamps[v] > cacheSize)
+            {
+                timestamps[v] = time++;
+                misses++;
+            }
+        }
+        return misses;
+    };
+
+    auto flushCache = [&]()
+    {
+        time += cacheSize + 1;
+    };
+
+    // 1) Hard boundaries: triangles where the whole cache missed (the optimizer restarted somewhere else)
+    std::vector<size_t> hardClusters;
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        unsigned int misses = simulateTriangle(t);
+        if (t == 0 || misses == 3)
+            hardClusters.push_back(t);
+    }
+    hardClusters.push_back(triangleCount);
+
+    // 2) Soft boundaries: split hard clusters further as long as the cache efficiency stays within threshold
+    std::vector<size_t> clusters;
+    for (size_t h = 0; h + 1 < hardClusters.size(); ++h)
+    {
+        size_t start = hardClusters[h];
+        size_t end = hardClusters[h + 1];
+
+        flushCache();
+        size_t clusterMisses = 0;
+        for (size_t t = start; t < end; ++t)
+            clusterMisses += simulateTriangle(t);
+        float clusterACMR = static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+        flushCache();
+        size_t subStart = start;
+        size_t subMisses = 0;
+        clusters.push_back(start);
+        for (size_t t = start; t < end; ++t)
+        {
+            subMisses += simulateTriangle(t);
+            size_t subCount = t + 1 - subStart;
+
+            if (t + 1 < end && subCount >= MinClusterTriangles &&
+                static_cast<float>(subMisses) / static_cast<float>(subCount) <= threshold * clusterACMR)
+            {
+                subStart = t + 1;
+                subMisses = 0;
+                clusters.push_back(subStart);
+                flushCache();
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+
+    // 3) Sort clusters so outward facing geometry far from the centre is drawn first
+    auto position = [&](unsigned int v)
+    {
+        const float *p = vertices[v].position;
+        return glm::vec3(p[0], p[1], p[2]);
+    };
+
+    glm::vec3 meshCentroid(0.0f);
+    for (size_t v = 0; v < vertexCount; ++v)
+        meshCentroid += position(static_cast<unsigned int>(v));
+    meshCentroid /= static_cast<float>(vertexCount);
+
+    float orientationSign = ComputeOrientationSign(vertices, indices);
+
+    size_t clusterCount = clusters.size() - 1;
+    std::vector<float> sortKeys(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float area = 0.0f;
+
+        for (size_t t = clusters[c]; t < clusters[c + 1]; ++t)
+        {
+            glm::vec3 p0 = position(indices[t * 3 + 0]);
+            glm::vec3 p1 = position(indices[t * 3 + 1]);
+            glm::vec3 p2 = position(indices[t * 3 + 2]);
+
+            glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            float triangleArea = glm::length(n);
+
+            centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+            normal += n;
+            area += triangleArea;
+        }
+
+        float normalLength = glm::length(normal);
+        if (area <= 0.0f || normalLength <= 0.0f)
+        {
+            sortKeys[c] = 0.0f;
+            continue;
+        }
+
+        centroid /= area;
+        normal /= normalLength;
+        sortKeys[c] = glm::dot(centroid - meshCentroid, normal) * orientationSign;
+    }
+
+    std::vector<size_t> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c)
+        order[c] = c;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                     { return sortKeys[a] > sortKeys[b]; });
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+    for (size_t c : order)
+    {
+        result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+    }
+
+    indices.swap(result);
+}
+
+float MeshOptimizer::ComputeOrientationSign(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices)
+{
+    auto position = [&](unsigned int v)
+    {
+        const float *p = vertices[v].position;
+        return glm::vec3(p[0], p[1], p[2]);
+    };
+
+    float orientation = 0.0f;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3)
+    {
+        unsigned int i0 = indices[t + 0], i1 = indices[t + 1], i2 = indices[t + 2];
+        glm::vec3 n = glm::cross(position(i1) - position(i0), position(i2) - position(i0));
+        for (unsigned int i : {i0, i1, i2})
+        {
+            const float *vn = vertices[i].normal;
+            orientation += glm::dot(n, glm::vec3(vn[0], vn[1], vn[2]));
+        }
+    }
+    return (orientation < 0.0f) ? -1.0f : 1.0f;
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices)
+{
+    const unsigned int Unused = ~0u;
+    std::vector<unsigned int> remap(vertices.size(), Unused);
+
+    std::vector<Vertex> result;
+    result.reserve(vertices.size());
+
+    for (unsigned int &index : indices)
+    {
+        if (remap[index] == Unused)
+        {
+            remap[index] = static_cast<unsigned int>(result.size());
+            result.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+
+    vertices.swap(result);
+}
+
+MeshOptimizeReport MeshOptimizer::OptimizeSubmesh(Submesh &submesh)
+{
+    MeshOptimizeReport report;
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    report.Before = AnalyzeVertexCache(submesh.indices, submesh.vertices.size());
+
+    OptimizeVertexCache(submesh.indices, submesh.vertices.size());
+    OptimizeOverdraw(submesh.indices, submesh.vertices);
+    OptimizeVertexFetch(submesh.vertices, submesh.indices);
+
+    report.After = AnalyzeVertexCache(submesh.indices, submesh.vertices.size());
+    report.TriangleCount = submesh.indices.size() / 3;
+    report.VertexCount = submesh.vertices.size();
+
+    auto end = std::chrono::high_resolution_clock::now();
+    report.Milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+
+    return report;
+}
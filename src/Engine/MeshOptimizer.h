@@ -0,0 +1,69 @@
+// MeshOptimizer.h
+#pragma once
+
+#include <vector>
+#include <string>
+#include "Engine/AssetManager.h"
+
+// Post-transform vertex cache statistics for an index buffer
+struct VertexCacheStats
+{
+    float ACMR = 0.0f; // Average cache miss ratio (transformed vertices per triangle)
+    float ATVR = 0.0f; // Average transform to vertex ratio (transformed vertices per unique vertex)
+};
+
+// Before/after numbers for a single optimized submesh
+struct MeshOptimizeReport
+{
+    VertexCacheStats Before;
+    VertexCacheStats After;
+    size_t TriangleCount = 0;
+    size_t VertexCount = 0;
+    double Milliseconds = 0.0;
+};
+
+/**
+ * @brief Load-time index/vertex buffer optimizer for submeshes.
+ *
+ * Runs three passes over the raw OBJ face order:
+ *   1. Vertex cache reordering (Tom Forsyth's linear-speed algorithm).
+ *   2. Overdraw-aware clustering (Sander et al. / Tipsify-style cluster sort).
+ *   3. Vertex fetch reordering (vertices laid out in first-use order).
+ */
+class MeshOptimizer
+{
+public:
+    // Cache size used when simulating a FIFO post-transform cache for stats
+    static const unsigned int StatsCacheSize = 16;
+
+    /**
+     * @brief Runs all optimization passes on the submesh's CPU-side buffers.
+     *
+     * Must be called before Submesh::Initialize uploads the data.
+     *
+     * @return ACMR/ATVR before and after the optimization.
+     */
+    static MeshOptimizeReport OptimizeSubmesh(Submesh &submesh);
+
+    // Simulates a FIFO vertex cache and returns ACMR/ATVR for the index buffer
+    static VertexCacheStats AnalyzeVertexCache(const std::vector<unsigned int> &indices, size_t vertexCount, unsigned int cacheSize = StatsCacheSize);
+
+    // Reorders triangles for post-transform cache locality (Forsyth)
+    static void OptimizeVertexCache(std::vector<unsigned int> &indices, size_t vertexCount);
+
+    // Splits the cache-optimized order into clusters and sorts them front-to-back outward-facing first.
+    // threshold controls how much ACMR may be sacrificed to create more clusters (1.05 = 5%).
+    static void OptimizeOverdraw(std::vector<unsigned int> &indices, const std::vector<Vertex> &vertices, float threshold = 1.05f);
+
+    /**
+     * @brief +1 if the triangles wind counter-clockwise around the shading
+     * normals, -1 if clockwise.
+     *
+     * Geometric winding vs. shading normals tells which side is the outside
+     * (the OBJ loader mirrors Y, which flips the winding).
+     */
+    static float ComputeOrientationSign(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices);
+
+    // Reorders vertices by first reference and remaps the indices; drops unreferenced vertices
+    static void OptimizeVertexFetch(std::vector<Vertex> &vertices, std::vector<unsigned int> &indices);
+};
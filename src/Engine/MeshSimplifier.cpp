@@ -0,0 +1,371 @@
+// MeshSimplifier.cpp
+
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "PositionKey.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+// A LOD has to drop at least this fraction of the previous LOD's triangles to be kept
+static const float MinLODReduction = 0.1f;
+
+// Symmetric 4x4 quadric stored as its 10 unique coefficients
+struct Quadric
+{
+    double a2 = 0, ab = 0, ac = 0, ad = 0;
+    double b2 = 0, bc = 0, bd = 0;
+    double c2 = 0, cd = 0;
+    double d2 = 0;
+
+    void AddPlane(double a, double b, double c, double d)
+    {
+        a2 += a * a; ab += a * b; ac += a * c; ad += a * d;
+        b2 += b * b; bc += b * c; bd += b * d;
+        c2 += c * c; cd += c * d;
+        d2 += d * d;
+    }
+
+    void Add(const Quadric &o)
+    {
+        a2 += o.a2; ab += o.ab; ac += o.ac; ad += o.ad;
+        b2 += o.b2; bc += o.bc; bd += o.bd;
+        c2 += o.c2; cd += o.cd;
+        d2 += o.d2;
+    }
+
+    // v^T Q v for v = (x, y, z, 1)
+    double Evaluate(const float p[3]) const
+    {
+        double x = p[0], y = p[1], z = p[2];
+        double r = a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+                 + b2 * y * y + 2 * bc * y * z + 2 * bd * y
+                 + c2 * z * z + 2 * cd * z
+                 + d2;
+        return r > 0.0 ? r : 0.0;
+    }
+};
+
+struct Collapse
+{
+    double cost;
+    unsigned int from;
+    unsigned int to;
+    unsigned int fromVersion;
+    unsigned int toVersion;
+
+    bool operator>(const Collapse &o) const { return cost > o.cost; }
+};
+
+static glm::vec3 TriangleNormal(const float *p0, const float *p1, const float *p2)
+{
+    glm::vec3 a(p0[0], p0[1], p0[2]);
+    glm::vec3 b(p1[0], p1[1], p1[2]);
+    glm::vec3 c(p2[0], p2[1], p2[2]);
+    return glm::cross(b - a, c - a);
+}
+
+std::vector<SimplifiedLOD> MeshSimplifier::GenerateLODs(const std::vector<Vertex> &vertices,
+                                                        const std::vector<unsigned int> &indices,
+                                                        const std::vector<float> &ratios)
+{
+    std::vector<SimplifiedLOD> lods;
+
+    const size_t vertexCount = vertices.size();
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertexCount == 0 || ratios.empty())
+        return lods;
+
+    // Weld vertices by position; topology and quadrics live on positions, triangles keep their vertex (wedge) indices
+    std::vector<unsigned int> positionOf(vertexCount);
+    std::vector<unsigned int> positionVertex; // Representative vertex per position
+    {
+        std::unordered_map<PositionKey, unsigned int, PositionKeyHash> weld;
+        weld.reserve(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            PositionKey key{vertices[v].position[0], vertices[v].position[1], vertices[v].position[2]};
+            auto it = weld.find(key);
+            if (it == weld.end())
+            {
+                it = weld.emplace(key, static_cast<unsigned int>(positionVertex.size())).first;
+                positionVertex.push_back(static_cast<unsigned int>(v));
+            }
+            positionOf[v] = it->second;
+        }
+    }
+    const size_t positionCount = positionVertex.size();
+    auto positionData = [&](unsigned int p) { return vertices[positionVertex[p]].position; };
+
+    std::vector<unsigned int> tris(indices.begin(), indices.begin() + triangleCount * 3);
+    std::vector<bool> triAlive(triangleCount, true);
+    size_t aliveTriangles = triangleCount;
+
+    // Position -> triangle adjacency and plane quadrics
+    std::vector<std::vector<unsigned int>> adjacency(positionCount);
+    std::vector<Quadric> quadrics(positionCount);
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        unsigned int i0 = tris[t * 3 + 0], i1 = tris[t * 3 + 1], i2 = tris[t * 3 + 2];
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+        {
+            triAlive[t] = false;
+            aliveTriangles--;
+            continue;
+        }
+
+        unsigned int p0 = positionOf[i0], p1 = positionOf[i1], p2 = positionOf[i2];
+        if (p0 == p1 || p1 == p2 || p0 == p2)
+        {
+            triAlive[t] = false;
+            aliveTriangles--;
+            continue;
+        }
+
+        glm::vec3 n = TriangleNormal(positionData(p0), positionData(p1), positionData(p2));
+        float length = glm::length(n);
+        if (length > 0.0f)
+        {
+            n /= length;
+            const float *origin = positionData(p0);
+            double d = -(n.x * origin[0] + n.y * origin[1] + n.z * origin[2]);
+            quadrics[p0].AddPlane(n.x, n.y, n.z, d);
+            quadrics[p1].AddPlane(n.x, n.y, n.z, d);
+            quadrics[p2].AddPlane(n.x, n.y, n.z, d);
+        }
+
+        adjacency[p0].push_back(static_cast<unsigned int>(t));
+        adjacency[p1].push_back(static_cast<unsigned int>(t));
+        adjacency[p2].push_back(static_cast<unsigned int>(t));
+    }
+
+    // Lock positions on edges that aren't shared by exactly two triangles (open borders, non-manifold)
+    std::vector<bool> locked(positionCount, false);
+    {
+        std::unordered_map<unsigned long long, unsigned int> edgeUse;
+        edgeUse.reserve(triangleCount * 3);
+        auto edgeKey = [](unsigned int a, unsigned int b)
+        {
+            if (a > b)
+                std::swap(a, b);
+            return (static_cast<unsigned long long>(a) << 32) | b;
+        };
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            if (!triAlive[t])
+                continue;
+            for (int e = 0; e < 3; ++e)
+                edgeUse[edgeKey(positionOf[tris[t * 3 + e]], positionOf[tris[t * 3 + (e + 1) % 3]])]++;
+        }
+        for (const auto &pair : edgeUse)
+        {
+            if (pair.second != 2)
+            {
+                locked[pair.first >> 32] = true;
+                locked[pair.first & 0xFFFFFFFFull] = true;
+            }
+        }
+    }
+
+    std::vector<unsigned int> version(positionCount, 0);
+    std::vector<bool> removed(positionCount, false);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+    auto pushCollapse = [&](unsigned int from, unsigned int to)
+    {
+        if (locked[from] || removed[from] || removed[to])
+            return;
+        Quadric q = quadrics[from];
+        q.Add(quadrics[to]);
+        heap.push({q.Evaluate(positionData(to)), from, to, version[from], version[to]});
+    };
+
+    auto pushPositionEdges = [&](unsigned int p)
+    {
+        for (unsigned int t : adjacency[p])
+        {
+            if (!triAlive[t])
+                continue;
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned int other = positionOf[tris[t * 3 + k]];
+                if (other == p)
+                    continue;
+                pushCollapse(p, other);
+                pushCollapse(other, p);
+            }
+        }
+    };
+
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        if (!triAlive[t])
+            continue;
+        for (int e = 0; e < 3; ++e)
+        {
+            unsigned int a = positionOf[tris[t * 3 + e]];
+            unsigned int b = positionOf[tris[t * 3 + (e + 1) % 3]];
+            pushCollapse(a, b);
+            pushCollapse(b, a);
+        }
+    }
+
+    auto snapshot = [&](double maxCost)
+    {
+        SimplifiedLOD lod;
+        lod.indices.reserve(aliveTriangles * 3);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            if (!triAlive[t])
+                continue;
+            lod.indices.push_back(tris[t * 3 + 0]);
+            lod.indices.push_back(tris[t * 3 + 1]);
+            lod.indices.push_back(tris[t * 3 + 2]);
+        }
+        lod.error = static_cast<float>(std::sqrt(maxCost));
+        MeshOptimizer::OptimizeVertexCache(lod.indices, vertexCount);
+        lods.push_back(std::move(lod));
+    };
+
+    auto vertexAt = [&](unsigned int t, unsigned int position) -> unsigned int
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            if (positionOf[tris[t * 3 + k]] == position)
+                return tris[t * 3 + k];
+        }
+        return ~0u;
+    };
+
+    size_t nextRatio = 0;
+    size_t previousTriangles = triangleCount;
+    double maxCost = 0.0;
+    std::vector<std::pair<unsigned int, unsigned int>> wedgeMap; // Vertex of 'from' -> vertex of 'to'
+
+    while (nextRatio < ratios.size() && !heap.empty())
+    {
+        size_t target = static_cast<size_t>(triangleCount * ratios[nextRatio]);
+        if (aliveTriangles <= target)
+        {
+            if (aliveTriangles <= previousTriangles * (1.0f - MinLODReduction))
+            {
+                snapshot(maxCost);
+                previousTriangles = aliveTriangles;
+            }
+            nextRatio++;
+            continue;
+        }
+
+        Collapse c = heap.top();
+        heap.pop();
+
+        unsigned int from = c.from;
+        unsigned int to = c.to;
+        if (removed[from] || removed[to] || version[from] != c.fromVersion || version[to] != c.toVersion)
+            continue;
+
+        // Each attribute wedge of 'from' must continue into a wedge of 'to' across a shared triangle,
+        // i.e. seam vertices only slide along their seam
+        bool valid = true;
+        wedgeMap.clear();
+        for (unsigned int t : adjacency[from])
+        {
+            if (!triAlive[t])
+                continue;
+            unsigned int toVertex = vertexAt(t, to);
+            if (toVertex == ~0u)
+                continue;
+            unsigned int fromVertex = vertexAt(t, from);
+            auto it = std::find_if(wedgeMap.begin(), wedgeMap.end(),
+                                   [&](const std::pair<unsigned int, unsigned int> &w) { return w.first == fromVertex; });
+            if (it == wedgeMap.end())
+                wedgeMap.emplace_back(fromVertex, toVertex);
+            else if (it->second != toVertex)
+                valid = false; // Ambiguous: the wedge touches two different wedges of 'to'
+        }
+
+        // Reject collapses that break seams, or flip or degenerate any triangle that survives them
+        for (unsigned int t : adjacency[from])
+        {
+            if (!valid)
+                break;
+            if (!triAlive[t])
+                continue;
+            if (vertexAt(t, to) != ~0u)
+                continue;
+
+            unsigned int fromVertex = vertexAt(t, from);
+            if (std::find_if(wedgeMap.begin(), wedgeMap.end(),
+                             [&](const std::pair<unsigned int, unsigned int> &w) { return w.first == fromVertex; }) == wedgeMap.end())
+            {
+                valid = false;
+                break;
+            }
+
+            const float *p[3];
+            const float *q[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned int position = positionOf[tris[t * 3 + k]];
+                p[k] = positionData(position);
+                q[k] = (position == from) ? positionData(to) : p[k];
+            }
+            glm::vec3 before = TriangleNormal(p[0], p[1], p[2]);
+            glm::vec3 after = TriangleNormal(q[0], q[1], q[2]);
+            if (glm::dot(before, after) <= 0.0f)
+                valid = false;
+        }
+        if (!valid)
+            continue;
+
+        // Apply the collapse
+        maxCost = std::max(maxCost, c.cost);
+        for (unsigned int t : adjacency[from])
+        {
+            if (!triAlive[t])
+                continue;
+            if (vertexAt(t, to) != ~0u)
+            {
+                triAlive[t] = false;
+                aliveTriangles--;
+                continue;
+            }
+            for (int k = 0; k < 3; ++k)
+            {
+                unsigned int &vertex = tris[t * 3 + k];
+                if (positionOf[vertex] != from)
+                    continue;
+                for (const auto &w : wedgeMap)
+                {
+                    if (w.first == vertex)
+                    {
+                        vertex = w.second;
+                        break;
+                    }
+                }
+            }
+            adjacency[to].push_back(t);
+        }
+        std::vector<unsigned int>().swap(adjacency[from]);
+        removed[from] = true;
+
+        // Drop dead triangles from the target's list so it doesn't grow unbounded
+        std::vector<unsigned int> &toAdjacency = adjacency[to];
+        toAdjacency.erase(std::remove_if(toAdjacency.begin(), toAdjacency.end(),
+                                         [&](unsigned int t) { return !triAlive[t]; }),
+                          toAdjacency.end());
+
+        quadrics[to].Add(quadrics[from]);
+        version[to]++;
+        pushPositionEdges(to);
+    }
+
+    // The heap ran dry before every target was met: keep what we reached if it's a real reduction
+    if (nextRatio < ratios.size() && aliveTriangles <= previousTriangles * (1.0f - MinLODReduction))
+        snapshot(maxCost);
+
+    return lods;
+}
@@ -0,0 +1,36 @@
+// MeshSimplifier.h
+#pragma once
+
+#include <vector>
+#include "Engine/AssetManager.h"
+
+// One simplified index buffer produced by the simplifier
+struct SimplifiedLOD
+{
+    std::vector<unsigned int> indices;
+    float error = 0.0f; // Largest collapse error (object space distance) accepted to reach this LOD
+};
+
+/**
+ * @brief Quadric error metric (Garland-Heckbert) mesh simplifier.
+ *
+ * Uses half-edge collapses onto existing vertices, so every LOD indexes the
+ * original vertex buffer and can share the submesh's VBO. Topology is built
+ * on welded positions; vertices on UV/normal seams may only collapse along
+ * the seam, and vertices on open borders are locked.
+ */
+class MeshSimplifier
+{
+public:
+    /**
+     * @brief Simplifies progressively, snapshotting an index buffer every time
+     * the triangle count drops under the next target ratio.
+     *
+     * @param ratios Target fraction of the original triangle count per LOD, descending (e.g. 0.5, 0.25, 0.125).
+     * @return One LOD per ratio that could be reached; LODs that would not reduce
+     *         the previous one meaningfully are dropped.
+     */
+    static std::vector<SimplifiedLOD> GenerateLODs(const std::vector<Vertex> &vertices,
+                                                   const std::vector<unsigned int> &indices,
+                                                   const std::vector<float> &ratios);
+};
@@ -0,0 +1,167 @@
+// Meshlet.cpp
+
+#include "Meshlet.h"
+#include "Engine/AssetManager.h"
+#include "Engine/MeshOptimizer.h"
+#include "Engine/PositionKey.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+// Clusters whose normals spread wider than this (cos of the half angle) never get cone culled
+static const float MinConeDot = 0.1f;
+
+static glm::vec3 VertexPosition(const std::vector<Vertex> &vertices, unsigned int index)
+{
+    const float *p = vertices[index].position;
+    return glm::vec3(p[0], p[1], p[2]);
+}
+
+static void ComputeMeshletBounds(Meshlet &meshlet, const std::vector<Vertex> &vertices,
+                                 const std::vector<unsigned int> &indices, float orientationSign)
+{
+    // Sphere around the AABB centre
+    glm::vec3 boundsMin = VertexPosition(vertices, indices[meshlet.indexOffset]);
+    glm::vec3 boundsMax = boundsMin;
+    for (unsigned int i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.indexCount; ++i)
+    {
+        glm::vec3 p = VertexPosition(vertices, indices[i]);
+        boundsMin = glm::min(boundsMin, p);
+        boundsMax = glm::max(boundsMax, p);
+    }
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+    float radius = 0.0f;
+    for (unsigned int i = meshlet.indexOffset; i < meshlet.indexOffset + meshlet.indexCount; ++i)
+        radius = std::max(radius, glm::length(VertexPosition(vertices, indices[i]) - center));
+
+    meshlet.center[0] = center.x;
+    meshlet.center[1] = center.y;
+    meshlet.center[2] = center.z;
+    meshlet.radius = radius;
+
+    // Normal cone from the outward facing triangle normals
+    std::vector<glm::vec3> normals;
+    normals.reserve(meshlet.indexCount / 3);
+    glm::vec3 axis(0.0f);
+    for (unsigned int i = meshlet.indexOffset; i + 2 < meshlet.indexOffset + meshlet.indexCount; i += 3)
+    {
+        glm::vec3 p0 = VertexPosition(vertices, indices[i + 0]);
+        glm::vec3 p1 = VertexPosition(vertices, indices[i + 1]);
+        glm::vec3 p2 = VertexPosition(vertices, indices[i + 2]);
+        glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+        float length = glm::length(n);
+        if (length <= 0.0f)
+            continue;
+        n *= orientationSign / length;
+        normals.push_back(n);
+        axis += n;
+    }
+
+    float axisLength = glm::length(axis);
+    if (normals.empty() || axisLength <= 0.0f)
+        return;
+    axis /= axisLength;
+
+    float minDot = 1.0f;
+    for (const glm::vec3 &n : normals)
+        minDot = std::min(minDot, glm::dot(axis, n));
+
+    meshlet.coneAxis[0] = axis.x;
+    meshlet.coneAxis[1] = axis.y;
+    meshlet.coneAxis[2] = axis.z;
+    meshlet.coneCutoff = (minDot <= MinConeDot) ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+}
+
+std::vector<Meshlet> MeshletBuilder::Build(const std::vector<Vertex> &vertices,
+                                           const std::vector<unsigned int> &indices,
+                                           unsigned int maxVertices,
+                                           unsigned int maxTriangles)
+{
+    std::vector<Meshlet> meshlets;
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || vertices.empty())
+        return meshlets;
+
+    float orientationSign = MeshOptimizer::ComputeOrientationSign(vertices, indices);
+
+    // Greedy grouping: a vertex counts once per meshlet, tracked with a meshlet stamp
+    std::vector<unsigned int> stamp(vertices.size(), ~0u);
+    Meshlet current;
+    unsigned int currentVertices = 0;
+    unsigned int meshletId = 0;
+
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        unsigned int newVertices = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+            if (stamp[indices[t * 3 + k]] != meshletId)
+                newVertices++;
+        }
+
+        if (current.indexCount > 0 &&
+            (currentVertices + newVertices > maxVertices || current.indexCount / 3 + 1 > maxTriangles))
+        {
+            meshlets.push_back(current);
+            current = Meshlet();
+            current.indexOffset = static_cast<unsigned int>(t * 3);
+            currentVertices = 0;
+            meshletId++;
+        }
+
+        for (int k = 0; k < 3; ++k)
+        {
+            unsigned int index = indices[t * 3 + k];
+            if (stamp[index] != meshletId)
+            {
+                stamp[index] = meshletId;
+                currentVertices++;
+            }
+        }
+        current.indexCount += 3;
+    }
+    if (current.indexCount > 0)
+        meshlets.push_back(current);
+
+    for (Meshlet &meshlet : meshlets)
+        ComputeMeshletBounds(meshlet, vertices, indices, orientationSign);
+
+    return meshlets;
+}
+
+bool MeshletBuilder::IsClosed(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices)
+{
+    // Weld by position so attribute seams don't count as open edges
+    std::unordered_map<unsigned long long, unsigned int> edgeUse;
+    std::vector<unsigned int> positionOf(vertices.size());
+    {
+        std::unordered_map<PositionKey, unsigned int, PositionKeyHash> weld;
+        weld.reserve(vertices.size());
+        for (size_t v = 0; v < vertices.size(); ++v)
+        {
+            PositionKey key{vertices[v].position[0], vertices[v].position[1], vertices[v].position[2]};
+            positionOf[v] = weld.emplace(key, static_cast<unsigned int>(weld.size())).first->second;
+        }
+    }
+
+    for (size_t t = 0; t + 2 < indices.size(); t += 3)
+    {
+        for (int e = 0; e < 3; ++e)
+        {
+            unsigned int a = positionOf[indices[t + e]];
+            unsigned int b = positionOf[indices[t + (e + 1) % 3]];
+            if (a > b)
+                std::swap(a, b);
+            edgeUse[(static_cast<unsigned long long>(a) << 32) | b]++;
+        }
+    }
+
+    for (const auto &pair : edgeUse)
+    {
+        if (pair.second != 2)
+            return false;
+    }
+    return !edgeUse.empty();
+}
@@ -0,0 +1,46 @@
+// Meshlet.h
+#pragma once
+
+#include <vector>
+
+struct Vertex;
+
+// A small cluster of triangles: a contiguous range of the submesh's full resolution index buffer
+struct Meshlet
+{
+    unsigned int indexOffset = 0; // In indices, not bytes
+    unsigned int indexCount = 0;
+
+    // Object space bounding sphere
+    float center[3] = {0.0f, 0.0f, 0.0f};
+    float radius = 0.0f;
+
+    // Normal cone: the cluster faces away from any viewpoint where
+    // dot(normalize(center - eye), coneAxis) >= coneCutoff + radius / distance(center, eye).
+    // coneCutoff of 1 disables the test (normals spread over a hemisphere or more).
+    float coneAxis[3] = {0.0f, 0.0f, 1.0f};
+    float coneCutoff = 1.0f;
+};
+
+/**
+ * @brief Splits an index buffer into meshlets.
+ *
+ * Triangles are grouped greedily in index buffer order, which after the
+ * vertex cache and overdraw passes is already spatially coherent, so every
+ * meshlet stays a contiguous range and needs no extra GPU memory.
+ */
+class MeshletBuilder
+{
+public:
+    static const unsigned int MaxVertices = 64;
+    static const unsigned int MaxTriangles = 124;
+
+    static std::vector<Meshlet> Build(const std::vector<Vertex> &vertices,
+                                      const std::vector<unsigned int> &indices,
+                                      unsigned int maxVertices = MaxVertices,
+                                      unsigned int maxTriangles = MaxTriangles);
+
+    // True when every edge (by welded position) is shared by exactly two triangles,
+    // i.e. back faces are always hidden behind front faces and cone culling is safe
+    static bool IsClosed(const std::vector<Vertex> &vertices, const std::vector<unsigned int> &indices);
+};
@@ -0,0 +1,23 @@
+// PositionKey.h
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// Exact position key used to weld attribute seams back into one topological vertex
+struct PositionKey
+{
+    float x, y, z;
+    bool operator==(const PositionKey &o) const { return x == o.x && y == o.y && z == o.z; }
+};
+
+struct PositionKeyHash
+{
+    size_t operator()(const PositionKey &k) const
+    {
+        size_t h = std::hash<float>()(k.x);
+        h ^= std::hash<float>()(k.y) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        h ^= std::hash<float>()(k.z) + 0x9e3779b9 + (h << 6) + (h >> 2);
+        return h;
+    }
+};
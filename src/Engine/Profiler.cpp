@@ -0,0 +1,388 @@
+// Profiler.cpp
+
+#include "Profiler.h"
+#include "MemoryTracker.h"
+#include "Utilitys.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+
+ProfileZoneDesc::ProfileZoneDesc(const char *name, const char *file, int line)
+    : Name(name), File(file), Line(line), Id(Profiler::Get().RegisterZone(this))
+{
+}
+
+// Marks the thread's buffer as retired when the thread exits, so EndFrame can hand it to a new thread
+struct ProfileThreadBufferRetirer
+{
+    ProfileThreadBuffer *Buffer = nullptr;
+    ~ProfileThreadBufferRetirer()
+    {
+        if (Buffer)
+            Buffer->Retired.store(true, std::memory_order_release);
+    }
+};
+
+static thread_local ProfileThreadBufferRetirer t_Retirer;
+
+Profiler::Profiler()
+    : m_CalibrationTicks(ProfilerTimestamp()), m_CalibrationTime(std::chrono::steady_clock::now()),
+      m_LastFrameEnd(m_CalibrationTicks)
+{
+#ifndef PROFILER_USE_RDTSC
+    m_TicksPerMicrosecond = static_cast<double>(std::chrono::steady_clock::period::den) /
+                            (std::chrono::steady_clock::period::num * 1000000.0);
+#endif
+}
+
+uint32_t Profiler::RegisterZone(const ProfileZoneDesc *zone)
+{
+    std::lock_guard<std::mutex> lock(m_RegistryMutex);
+    m_Zones.push_back(zone);
+    return static_cast<uint32_t>(m_Zones.size() - 1);
+}
+
+ProfileThreadBuffer *Profiler::AcquireThreadBuffer()
+{
+    ProfileThreadBuffer *buffer;
+    {
+        std::lock_guard<std::mutex> lock(m_RegistryMutex);
+        if (!m_FreeBuffers.empty())
+        {
+            buffer = m_FreeBuffers.back();
+            m_FreeBuffers.pop_back();
+            buffer->Retired.store(false, std::memory_order_relaxed);
+        }
+        else
+        {
+            m_Buffers.push_back(std::make_unique<ProfileThreadBuffer>());
+            buffer = m_Buffers.back().get();
+        }
+    }
+    t_Retirer.Buffer = buffer;
+    return buffer;
+}
+
+void Profiler::Calibrate()
+{
+    auto now = std::chrono::steady_clock::now();
+    uint64_t ticks = ProfilerTimestamp();
+    double elapsedUs = std::chrono::duration<double, std::micro>(now - m_CalibrationTime).count();
+
+    // The first frames are too short for a stable ratio
+    if (elapsedUs > 1000.0 && ticks > m_CalibrationTicks)
+        m_TicksPerMicrosecond = (ticks - m_CalibrationTicks) / elapsedUs;
+}
+
+void Profiler::EndFrame()
+{
+    MemoryTagScope memoryTag(MemoryTag::Profiler);
+    std::unique_lock<std::mutex> lock(m_Mutex);
+
+#ifdef PROFILER_USE_RDTSC
+    Calibrate();
+#endif
+
+    {
+        std::lock_guard<std::mutex> registryLock(m_RegistryMutex);
+
+        m_ZoneTicks.assign(m_Zones.size(), 0);
+        m_ZoneCalls.assign(m_Zones.size(), 0);
+        m_Tree.clear();
+
+        for (size_t i = 0; i < m_Buffers.size(); ++i)
+        {
+            const std::unique_ptr<ProfileThreadBuffer> &buffer = m_Buffers[i];
+            bool retired = buffer->Retired.load(std::memory_order_acquire);
+            uint64_t head = buffer->Head.load(std::memory_order_acquire);
+            uint64_t tail = buffer->Tail.load(std::memory_order_relaxed);
+
+            AddToTree(*buffer, tail, head, buffer.get() == t_Buffer);
+
+            if (m_CaptureFramesLeft > 0)
+            {
+                if (buffer.get() == t_Buffer)
+                    m_CaptureMainThread = static_cast<uint32_t>(i);
+                AddToCapture(*buffer, tail, head, static_cast<uint32_t>(i));
+            }
+
+            for (; tail != head; ++tail)
+            {
+                const ProfileEvent &event = buffer->Events[tail & (ProfileThreadBuffer::Capacity - 1)];
+                if (event.Zone >= m_ZoneTicks.size())
+                    continue;
+                m_ZoneTicks[event.Zone] += event.End - event.Start;
+                m_ZoneCalls[event.Zone]++;
+            }
+            buffer->Tail.store(head, std::memory_order_release);
+
+            m_DroppedEvents += buffer->Dropped.exchange(0, std::memory_order_relaxed);
+
+            if (retired && std::find(m_FreeBuffers.begin(), m_FreeBuffers.end(), buffer.get()) == m_FreeBuffers.end())
+                m_FreeBuffers.push_back(buffer.get());
+        }
+
+        for (size_t zone = 0; zone < m_Zones.size(); ++zone)
+        {
+            if (m_ZoneCalls[zone] == 0)
+                continue;
+            ProfileResult &result = m_ProfileData[m_Zones[zone]->Name];
+            result.TotalTime += TicksToMicroseconds(m_ZoneTicks[zone]);
+            result.CallCount += m_ZoneCalls[zone];
+        }
+    }
+
+    m_LastFrameData.swap(m_ProfileData);
+    m_ProfileData.clear();
+
+    m_LastFrameTree.swap(m_Tree);
+    m_LastFrameRootTime = 0.0;
+    for (const ProfileNode &node : m_LastFrameTree)
+    {
+        if (node.Parent == ProfileNode::NoParent && node.MainThread)
+            m_LastFrameRootTime += node.InclusiveTime;
+    }
+
+    m_LastFrameEnd = ProfilerTimestamp();
+    if (m_CaptureFramesLeft > 0)
+    {
+        m_CaptureFrameEnds.push_back(m_LastFrameEnd);
+        if (--m_CaptureFramesLeft == 0)
+        {
+            // The file write is the only slow part; nothing else waits on m_Mutex per event
+            lock.unlock();
+            WriteCapture();
+        }
+    }
+}
+
+bool Profiler::BeginCapture(int frames, const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_CaptureFramesLeft > 0 || frames <= 0)
+        return false;
+
+    m_CapturePath = path.empty() ? DefaultCapturePath() : path;
+    m_CaptureEvents.clear();
+    m_CaptureFrameEnds.clear();
+    m_CaptureOrigin = m_LastFrameEnd;
+    m_CaptureDropped = 0;
+    m_CaptureFramesLeft = frames;
+    return true;
+}
+
+std::string Profiler::DefaultCapturePath()
+{
+    std::time_t now = std::time(nullptr);
+    char name[64];
+    std::strftime(name, sizeof(name), "trace_%Y%m%d_%H%M%S.json", std::localtime(&now));
+    return (std::filesystem::path("traces") / name).string();
+}
+
+void Profiler::AddToCapture(const ProfileThreadBuffer &buffer, uint64_t tail, uint64_t head, uint32_t thread)
+{
+    for (uint64_t i = tail; i != head; ++i)
+    {
+        if (m_CaptureEvents.size() >= MaxCaptureEvents)
+        {
+            m_CaptureDropped += head - i;
+            return;
+        }
+        const ProfileEvent &event = buffer.Events[i & (ProfileThreadBuffer::Capacity - 1)];
+        if (event.Zone < m_Zones.size())
+            m_CaptureEvents.push_back({event.Start, event.End, event.Zone, thread});
+    }
+}
+
+bool Profiler::WriteCapture()
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    std::lock_guard<std::mutex> registryLock(m_RegistryMutex);
+
+    m_LastCapturePath = m_CapturePath;
+    m_LastCaptureEventCount = m_CaptureEvents.size();
+    m_LastCaptureSucceeded = false;
+
+    std::error_code ec;
+    std::filesystem::path parent = std::filesystem::path(m_CapturePath).parent_path();
+    if (!parent.empty())
+        std::filesystem::create_directories(parent, ec);
+
+    std::ofstream out(m_CapturePath, std::ios::trunc);
+    if (!out)
+        return false;
+
+    // Thread 0 is the main thread, other buffers follow; frames get a track of their own
+    const uint32_t frameTrack = static_cast<uint32_t>(m_Buffers.size()) + 1;
+    auto threadId = [this](uint32_t buffer)
+    { return buffer == m_CaptureMainThread ? 0u : buffer + 1; };
+    auto microseconds = [this](uint64_t ticks)
+    { return static_cast<int64_t>(ticks - m_CaptureOrigin) / m_TicksPerMicrosecond; }; // Workers may start before the origin
+
+    out << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << m_CaptureDropped << "},\"traceEvents\":[\n";
+    out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Tesseract Engine\"}}";
+    out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Main\"}}";
+    out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << frameTrack << ",\"args\":{\"name\":\"Frames\"}}";
+    for (uint32_t buffer = 0; buffer < m_Buffers.size(); ++buffer)
+    {
+        if (buffer != m_CaptureMainThread)
+            out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId(buffer)
+                << ",\"args\":{\"name\":\"Worker " << buffer << "\"}}";
+    }
+
+    char number[32];
+    uint64_t frameStart = m_CaptureOrigin;
+    for (size_t frame = 0; frame < m_CaptureFrameEnds.size(); ++frame)
+    {
+        uint64_t frameEnd = m_CaptureFrameEnds[frame];
+        std::snprintf(number, sizeof(number), "%.3f", microseconds(frameStart));
+        out << ",\n{\"name\":\"Frame " << frame << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":" << frameTrack << ",\"ts\":" << number;
+        std::snprintf(number, sizeof(number), "%.3f", TicksToMicroseconds(frameEnd - frameStart));
+        out << ",\"dur\":" << number << "}";
+        frameStart = frameEnd;
+    }
+
+    for (const CapturedEvent &event : m_CaptureEvents)
+    {
+        const ProfileZoneDesc *zone = m_Zones[event.Zone];
+        out << ",\n{\"name\":";
+        WriteJsonString(out, zone->Name);
+        std::snprintf(number, sizeof(number), "%.3f", microseconds(event.Start));
+        out << ",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadId(event.Thread) << ",\"ts\":" << number;
+        std::snprintf(number, sizeof(number), "%.3f", TicksToMicroseconds(event.End - event.Start));
+        out << ",\"dur\":" << number << ",\"args\":{\"file\":";
+        WriteJsonString(out, zone->File);
+        out << ",\"line\":" << zone->Line << "}}";
+    }
+    out << "\n]}\n";
+
+    m_CaptureEvents.clear();
+    m_CaptureEvents.shrink_to_fit();
+    m_CaptureFrameEnds.clear();
+
+    m_LastCaptureSucceeded = static_cast<bool>(out);
+    return m_LastCaptureSucceeded;
+}
+
+void Profiler::AddToTree(const ProfileThreadBuffer &buffer, uint64_t tail, uint64_t head, bool mainThread)
+{
+    m_Instances.clear();
+    m_ChildInstances.clear();
+    for (std::vector<uint32_t> &pending : m_PendingByDepth)
+        pending.clear();
+
+    // A zone ends after all of its children, so when it arrives every pending
+    // instance one level deeper is one of its children
+    for (uint64_t i = tail; i != head; ++i)
+    {
+        const ProfileEvent &event = buffer.Events[i & (ProfileThreadBuffer::Capacity - 1)];
+        if (event.Zone >= m_Zones.size())
+            continue;
+
+        if (m_PendingByDepth.size() < event.Depth + 2)
+            m_PendingByDepth.resize(event.Depth + 2);
+
+        std::vector<uint32_t> &children = m_PendingByDepth[event.Depth + 1];
+        ZoneInstance instance;
+        instance.Zone = event.Zone;
+        instance.Ticks = event.End - event.Start;
+        instance.FirstChild = static_cast<uint32_t>(m_ChildInstances.size());
+        instance.ChildCount = static_cast<uint32_t>(children.size());
+        m_ChildInstances.insert(m_ChildInstances.end(), children.begin(), children.end());
+        children.clear();
+
+        m_PendingByDepth[event.Depth].push_back(static_cast<uint32_t>(m_Instances.size()));
+        m_Instances.push_back(instance);
+    }
+
+    // Whatever is left has no parent this frame: true roots, or zones whose parent is still open
+    for (const std::vector<uint32_t> &pending : m_PendingByDepth)
+    {
+        for (uint32_t instance : pending)
+            AddInstance(ProfileNode::NoParent, instance, mainThread);
+    }
+}
+
+uint32_t Profiler::AddInstance(uint32_t parentNode, uint32_t instanceIndex, bool mainThread)
+{
+    const ZoneInstance instance = m_Instances[instanceIndex];
+
+    // Same zone under the same parent merges into one node
+    uint32_t nodeIndex = ProfileNode::NoParent;
+    if (parentNode == ProfileNode::NoParent)
+    {
+        for (uint32_t i = 0; i < m_Tree.size(); ++i)
+        {
+            const ProfileNode &node = m_Tree[i];
+            if (node.Parent == ProfileNode::NoParent && node.Zone == instance.Zone && node.MainThread == mainThread)
+            {
+                nodeIndex = i;
+                break;
+            }
+        }
+    }
+    else
+    {
+        for (uint32_t child : m_Tree[parentNode].Children)
+        {
+            if (m_Tree[child].Zone == instance.Zone)
+            {
+                nodeIndex = child;
+                break;
+            }
+        }
+    }
+
+    if (nodeIndex == ProfileNode::NoParent)
+    {
+        ProfileNode node;
+        node.Zone = instance.Zone;
+        node.Name = m_Zones[instance.Zone]->Name;
+        node.Parent = parentNode;
+        node.Depth = parentNode == ProfileNode::NoParent ? 0 : m_Tree[parentNode].Depth + 1;
+        node.InclusiveTime = 0.0;
+        node.SelfTime = 0.0;
+        node.CallCount = 0;
+        node.MainThread = mainThread;
+
+        nodeIndex = static_cast<uint32_t>(m_Tree.size());
+        m_Tree.push_back(std::move(node));
+        if (parentNode != ProfileNode::NoParent)
+            m_Tree[parentNode].Children.push_back(nodeIndex);
+    }
+
+    uint64_t childTicks = 0;
+    for (uint32_t i = 0; i < instance.ChildCount; ++i)
+    {
+        uint32_t child = m_ChildInstances[instance.FirstChild + i];
+        childTicks += m_Instances[child].Ticks;
+        AddInstance(nodeIndex, child, mainThread);
+    }
+
+    // m_Tree may have grown; index again
+    ProfileNode &node = m_Tree[nodeIndex];
+    node.InclusiveTime += TicksToMicroseconds(instance.Ticks);
+    node.SelfTime += TicksToMicroseconds(instance.Ticks - std::min(childTicks, instance.Ticks));
+    node.CallCount++;
+    return nodeIndex;
+}
+
+double Profiler::MeasureZoneOverhead(int iterations)
+{
+    // Stay well inside one buffer so nothing is dropped
+    iterations = std::max(1, std::min(iterations, static_cast<int>(ProfileThreadBuffer::Capacity / 2)));
+    ThreadBuffer();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+        PROFILE_ZONE("Profiler Overhead Probe");
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    m_ZoneOverheadNs = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+    return m_ZoneOverheadNs;
+}
@@ -4,12 +4,114 @@
 #include <string>
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <chrono>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PROFILER_USE_RDTSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
 
 struct ProfileResult {
     double TotalTime; // Total time in microseconds
     int CallCount;
 };
 
+// Raw profiler clock: the TSC where available, calibrated to microseconds at EndFrame
+inline uint64_t ProfilerTimestamp()
+{
+#ifdef PROFILER_USE_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/**
+ * @brief Static description of one PROFILE_ZONE site.
+ *
+ * Created once per site (function-local static), which registers it and
+ * assigns the id events refer to. The name must outlive the program (a
+ * string literal).
+ */
+struct ProfileZoneDesc
+{
+    const char *Name;
+    const char *File;
+    int Line;
+    uint32_t Id;
+
+    ProfileZoneDesc(const char *name, const char *file, int line);
+};
+
+// One completed zone, in profiler clock ticks
+struct ProfileEvent
+{
+    uint64_t Start;
+    uint64_t End;
+    uint32_t Zone;
+    uint32_t Parent; // Zone that was open on the thread when this one began, or ProfileEvent::NoZone
+    uint32_t Depth;  // Number of zones open on the thread when this one began
+    static const uint32_t NoZone = UINT32_MAX;
+};
+
+// Node of the per-frame call tree: one per distinct path of nested zones
+struct ProfileNode
+{
+    static const uint32_t NoParent = UINT32_MAX;
+
+    uint32_t Zone;
+    const char *Name;
+    uint32_t Parent; // Index into the tree, or NoParent for roots
+    uint32_t Depth;
+    double InclusiveTime; // Microseconds, children included
+    double SelfTime;      // Microseconds not covered by child zones
+    int CallCount;
+    bool MainThread; // Recorded on the thread that calls EndFrame; other threads' roots overlap it in time
+    std::vector<uint32_t> Children;
+};
+
+/**
+ * @brief Single-producer/single-consumer ring of zone events.
+ *
+ * The owning thread pushes without locks; Profiler::EndFrame drains it.
+ * When full, events are dropped and counted rather than blocking.
+ */
+struct ProfileThreadBuffer
+{
+    static const size_t Capacity = 1 << 14; // Power of two
+
+    ProfileEvent Events[Capacity];
+    std::atomic<uint64_t> Head{0}; // Written by the owning thread
+    std::atomic<uint64_t> Tail{0}; // Written by EndFrame
+    std::atomic<uint64_t> Dropped{0};
+    std::atomic<bool> Retired{false}; // Owning thread exited; reused once drained
+
+    void Push(uint32_t zone, uint32_t parent, uint32_t depth, uint64_t start, uint64_t end)
+    {
+        uint64_t head = Head.load(std::memory_order_relaxed);
+        if (head - Tail.load(std::memory_order_acquire) >= Capacity)
+        {
+            Dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        ProfileEvent &event = Events[head & (Capacity - 1)];
+        event.Start = start;
+        event.End = end;
+        event.Zone = zone;
+        event.Parent = parent;
+        event.Depth = depth;
+        Head.store(head + 1, std::memory_order_release);
+    }
+};
+
 class Profiler {
 public:
     static Profiler& Get() {
@@ -17,6 +119,7 @@ public:
         return instance;
     }
 
+    // Dynamic names (e.g. built at runtime); PROFILE_ZONE is the cheap path for fixed names
     void AddProfileResult(const std::string& name, double time) {
         std::lock_guard<std::mutex> lock(m_Mutex);
         auto& result = m_ProfileData[name];
@@ -24,24 +127,184 @@ public:
         result.CallCount += 1;
     }
 
-    // Call this at the end of each frame to prepare data for display
-    void EndFrame() {
-        std::lock_guard<std::mutex> lock(m_Mutex);
-        m_LastFrameData = m_ProfileData;
-        m_ProfileData.clear();
-    }
+    // Call this at the end of each frame: drains every thread's zone events and prepares data for display
+    void EndFrame();
 
     const std::unordered_map<std::string, ProfileResult>& GetLastFrameData() const {
         return m_LastFrameData;
     }
 
+    // Call tree of the last frame; roots have Parent == ProfileNode::NoParent
+    const std::vector<ProfileNode> &GetLastFrameTree() const { return m_LastFrameTree; }
+
+    // Sum of the main thread's root zones: the frame's instrumented time without nested zones counted twice
+    double GetLastFrameRootTime() const { return m_LastFrameRootTime; }
+
+    // Called by ProfileZoneDesc; returns the zone's id
+    uint32_t RegisterZone(const ProfileZoneDesc *zone);
+
+    // This thread's event buffer, created on first use
+    static ProfileThreadBuffer *ThreadBuffer()
+    {
+        if (!t_Buffer)
+            t_Buffer = Get().AcquireThreadBuffer();
+        return t_Buffer;
+    }
+
+    double TicksToMicroseconds(uint64_t ticks) const { return ticks / m_TicksPerMicrosecond; }
+
+    // Times `iterations` empty zones on this thread; the result is kept for GetZoneOverheadNs
+    double MeasureZoneOverhead(int iterations = 4096);
+    double GetZoneOverheadNs() const { return m_ZoneOverheadNs; }
+
+    // Events lost because a thread's buffer was full, since startup
+    uint64_t GetDroppedEvents() const { return m_DroppedEvents; }
+
+    /**
+     * @brief Records every zone event of the next `frames` frames, from all threads.
+     *
+     * The frame in progress is the first one captured. When the last frame
+     * ends, the events are written to `path` in Chrome Trace Event JSON,
+     * which chrome://tracing and ui.perfetto.dev open directly. An empty path
+     * picks DefaultCapturePath(). Returns false if a capture is already running.
+     */
+    bool BeginCapture(int frames, const std::string &path = std::string());
+    bool IsCapturing() const { return m_CaptureFramesLeft > 0; }
+    int GetCaptureFramesLeft() const { return m_CaptureFramesLeft; }
+
+    // traces/trace_<date>_<time>.json under the working directory
+    static std::string DefaultCapturePath();
+
+    // Outcome of the last finished capture, for display
+    const std::string &GetLastCapturePath() const { return m_LastCapturePath; }
+    bool GetLastCaptureSucceeded() const { return m_LastCaptureSucceeded; }
+    size_t GetLastCaptureEventCount() const { return m_LastCaptureEventCount; }
+
 private:
-    Profiler() {}
+    Profiler();
     ~Profiler() {}
     Profiler(const Profiler&) = delete;
     Profiler& operator=(const Profiler&) = delete;
 
+    ProfileThreadBuffer *AcquireThreadBuffer();
+
+    // Re-derives ticks per microsecond from the time since startup
+    void Calibrate();
+
+    // Rebuilds one thread's zone nesting from its events (which arrive children first) and merges it into m_Tree
+    void AddToTree(const ProfileThreadBuffer &buffer, uint64_t tail, uint64_t head, bool mainThread);
+    uint32_t AddInstance(uint32_t parentNode, uint32_t instance, bool mainThread);
+
+    // Copies a drained range of one thread's events into the capture
+    void AddToCapture(const ProfileThreadBuffer &buffer, uint64_t tail, uint64_t head, uint32_t thread);
+    bool WriteCapture();
+
     std::unordered_map<std::string, ProfileResult> m_ProfileData;
     std::unordered_map<std::string, ProfileResult> m_LastFrameData;
     mutable std::mutex m_Mutex;
+
+    // Zone sites and thread buffers; only touched when a site or thread is first seen, and by EndFrame
+    std::mutex m_RegistryMutex;
+    std::vector<const ProfileZoneDesc *> m_Zones;
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> m_Buffers;
+    std::vector<ProfileThreadBuffer *> m_FreeBuffers;
+
+    // Per-zone totals while draining, indexed by zone id
+    std::vector<uint64_t> m_ZoneTicks;
+    std::vector<int> m_ZoneCalls;
+
+    // One zone execution while building the tree; its children are a range of m_ChildInstances
+    struct ZoneInstance
+    {
+        uint32_t Zone;
+        uint64_t Ticks;
+        uint32_t FirstChild;
+        uint32_t ChildCount;
+    };
+    std::vector<ZoneInstance> m_Instances;
+    std::vector<uint32_t> m_ChildInstances;
+    std::vector<std::vector<uint32_t>> m_PendingByDepth; // Completed instances whose parent hasn't completed yet
+
+    std::vector<ProfileNode> m_Tree;
+    std::vector<ProfileNode> m_LastFrameTree;
+    double m_LastFrameRootTime = 0.0;
+
+    uint64_t m_CalibrationTicks;
+    std::chrono::steady_clock::time_point m_CalibrationTime;
+    double m_TicksPerMicrosecond = 1.0;
+
+    double m_ZoneOverheadNs = 0.0;
+    uint64_t m_DroppedEvents = 0;
+
+    // Trace capture; events keep raw ticks and are converted when written
+    struct CapturedEvent
+    {
+        uint64_t Start;
+        uint64_t End;
+        uint32_t Zone;
+        uint32_t Thread; // Index of the thread's buffer; the main thread is written as thread 0
+    };
+    static const size_t MaxCaptureEvents = 1 << 22;
+    std::vector<CapturedEvent> m_CaptureEvents;
+    std::vector<uint64_t> m_CaptureFrameEnds;
+    std::string m_CapturePath;
+    uint64_t m_CaptureOrigin = 0;
+    uint64_t m_CaptureDropped = 0;
+    uint32_t m_CaptureMainThread = 0;
+    int m_CaptureFramesLeft = 0;
+
+    std::string m_LastCapturePath;
+    bool m_LastCaptureSucceeded = false;
+    size_t m_LastCaptureEventCount = 0;
+
+    uint64_t m_LastFrameEnd; // Tick at which the previous EndFrame ran, i.e. the start of the current frame
+
+    static inline thread_local ProfileThreadBuffer *t_Buffer = nullptr;
+
+    // Innermost open zone and nesting depth of the calling thread, maintained by ProfileZone
+    static inline thread_local uint32_t t_CurrentZone = ProfileEvent::NoZone;
+    static inline thread_local uint32_t t_Depth = 0;
+
+    friend class ProfileZone;
 };
+
+// Times the enclosing scope into the calling thread's buffer
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const ProfileZoneDesc &zone)
+        : m_Zone(zone.Id), m_Parent(Profiler::t_CurrentZone), m_Depth(Profiler::t_Depth++)
+    {
+        Profiler::t_CurrentZone = m_Zone;
+        m_Start = ProfilerTimestamp();
+    }
+    ~ProfileZone()
+    {
+        uint64_t end = ProfilerTimestamp();
+        Profiler::t_CurrentZone = m_Parent;
+        Profiler::t_Depth = m_Depth;
+        Profiler::ThreadBuffer()->Push(m_Zone, m_Parent, m_Depth, m_Start, end);
+    }
+
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    uint32_t m_Zone;
+    uint32_t m_Parent;
+    uint32_t m_Depth;
+    uint64_t m_Start;
+};
+
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+/**
+ * @brief Profiles the rest of the enclosing scope under `name` (a string literal).
+ *
+ * No locks, hashing or allocations per call: the site's descriptor is a
+ * static and the event goes into a per-thread ring buffer.
+ */
+#define PROFILE_ZONE(name)                                                                     \
+    static ProfileZoneDesc PROFILER_CONCAT(s_ProfileZoneDesc, __LINE__)(name, __FILE__, __LINE__); \
+    ProfileZone PROFILER_CONCAT(profileZone, __LINE__)(PROFILER_CONCAT(s_ProfileZoneDesc, __LINE__))
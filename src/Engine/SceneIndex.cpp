@@ -0,0 +1,133 @@
+// SceneIndex.cpp
+
+#include "SceneIndex.h"
+#include "Componenets/GameObject.h"
+
+#include <algorithm>
+
+void SceneIndex::Rebuild(const std::vector<std::shared_ptr<GameObject>> &gameObjects)
+{
+    Clear();
+    m_Order.reserve(gameObjects.size());
+    m_ByName.reserve(gameObjects.size());
+    for (const auto &gameObject : gameObjects)
+    {
+        if (gameObject)
+            Add(gameObject.get());
+    }
+}
+
+void SceneIndex::Clear()
+{
+    m_ByName.clear();
+    m_ByTag.clear();
+    m_Order.clear();
+    m_NextOrder = 0;
+}
+
+void SceneIndex::Add(GameObject *gameObject)
+{
+    if (!gameObject || m_Order.count(gameObject))
+        return;
+
+    m_Order[gameObject] = m_NextOrder++;
+
+    // Appended objects are last in scene order, so a push_back keeps buckets sorted
+    m_ByName[gameObject->name].push_back(gameObject);
+    for (const std::string &tag : gameObject->tags)
+        m_ByTag[tag].push_back(gameObject);
+}
+
+void SceneIndex::Remove(GameObject *gameObject)
+{
+    if (!gameObject || !m_Order.count(gameObject))
+        return;
+
+    Erase(m_ByName, gameObject->name, gameObject);
+    for (const std::string &tag : gameObject->tags)
+        Erase(m_ByTag, tag, gameObject);
+
+    m_Order.erase(gameObject);
+}
+
+void SceneIndex::Rename(GameObject *gameObject, const std::string &newName)
+{
+    if (!gameObject || gameObject->name == newName)
+        return;
+
+    if (!m_Order.count(gameObject))
+    {
+        gameObject->name = newName;
+        return;
+    }
+
+    Erase(m_ByName, gameObject->name, gameObject);
+    gameObject->name = newName;
+    InsertOrdered(m_ByName[newName], gameObject);
+}
+
+bool SceneIndex::AddTag(GameObject *gameObject, const std::string &tag)
+{
+    if (!gameObject || tag.empty() || gameObject->HasTag(tag))
+        return false;
+
+    gameObject->tags.push_back(tag);
+    if (m_Order.count(gameObject))
+        InsertOrdered(m_ByTag[tag], gameObject);
+    return true;
+}
+
+bool SceneIndex::RemoveTag(GameObject *gameObject, const std::string &tag)
+{
+    if (!gameObject)
+        return false;
+
+    auto it = std::find(gameObject->tags.begin(), gameObject->tags.end(), tag);
+    if (it == gameObject->tags.end())
+        return false;
+
+    gameObject->tags.erase(it);
+    if (m_Order.count(gameObject))
+        Erase(m_ByTag, tag, gameObject);
+    return true;
+}
+
+GameObject *SceneIndex::FindByName(const std::string &name) const
+{
+    auto it = m_ByName.find(name);
+    return (it != m_ByName.end() && !it->second.empty()) ? it->second.front() : nullptr;
+}
+
+GameObject *SceneIndex::FindByTag(const std::string &tag) const
+{
+    auto it = m_ByTag.find(tag);
+    return (it != m_ByTag.end() && !it->second.empty()) ? it->second.front() : nullptr;
+}
+
+const std::vector<GameObject *> &SceneIndex::FindAllByTag(const std::string &tag) const
+{
+    static const Bucket empty;
+    auto it = m_ByTag.find(tag);
+    return it != m_ByTag.end() ? it->second : empty;
+}
+
+void SceneIndex::InsertOrdered(Bucket &bucket, GameObject *gameObject)
+{
+    size_t order = m_Order[gameObject];
+    auto position = std::upper_bound(bucket.begin(), bucket.end(), order,
+                                     [this](size_t value, GameObject *other)
+                                     { return value < m_Order[other]; });
+    bucket.insert(position, gameObject);
+}
+
+void SceneIndex::Erase(std::unordered_map<std::string, Bucket> &map, const std::string &key, GameObject *gameObject)
+{
+    auto it = map.find(key);
+    if (it == map.end())
+        return;
+
+    Bucket &bucket = it->second;
+    bucket.erase(std::remove(bucket.begin(), bucket.end(), gameObject), bucket.end());
+    if (bucket.empty())
+        map.erase(it);
+}
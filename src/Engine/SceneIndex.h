@@ -0,0 +1,66 @@
+// SceneIndex.h
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class GameObject;
+
+/**
+ * @brief Hash index over the scene's GameObjects by name and by tag.
+ *
+ * Replaces linear scans of g_GameObjects for lookups from scripts. The index
+ * holds non-owning pointers, so every place that adds, removes, renames or
+ * re-tags an object must go through it (SceneManager, SceneWindow and the
+ * Inspector do). Objects sharing a name or tag are kept in scene order, so
+ * lookups return the same object a front-to-back scan would.
+ */
+class SceneIndex
+{
+public:
+    // Drops everything and indexes `gameObjects` in order
+    void Rebuild(const std::vector<std::shared_ptr<GameObject>> &gameObjects);
+    void Clear();
+
+    // Appends an object (call after pushing it to the end of g_GameObjects)
+    void Add(GameObject *gameObject);
+
+    // Call before the object is destroyed
+    void Remove(GameObject *gameObject);
+
+    // Changes the object's name and keeps the index in sync
+    void Rename(GameObject *gameObject, const std::string &newName);
+
+    // Tag edits; return false if the object already had / didn't have the tag
+    bool AddTag(GameObject *gameObject, const std::string &tag);
+    bool RemoveTag(GameObject *gameObject, const std::string &tag);
+
+    // First object (in scene order) with the given name, or nullptr
+    GameObject *FindByName(const std::string &name) const;
+
+    // First object (in scene order) carrying `tag`, or nullptr
+    GameObject *FindByTag(const std::string &tag) const;
+
+    // Every object carrying `tag`, in scene order
+    const std::vector<GameObject *> &FindAllByTag(const std::string &tag) const;
+
+    size_t Size() const { return m_Order.size(); }
+
+private:
+    using Bucket = std::vector<GameObject *>;
+
+    // Inserts into a bucket keeping scene order
+    void InsertOrdered(Bucket &bucket, GameObject *gameObject);
+    static void Erase(std::unordered_map<std::string, Bucket> &map, const std::string &key, GameObject *gameObject);
+
+    std::unordered_map<std::string, Bucket> m_ByName;
+    std::unordered_map<std::string, Bucket> m_ByTag;
+
+    // Scene position of every indexed object, used to order buckets
+    std::unordered_map<GameObject *, size_t> m_Order;
+    size_t m_NextOrder = 0;
+};
+
+extern SceneIndex g_SceneIndex;
@@ -8,6 +8,8 @@
 #include "imgui.h"
 
 #include "./Windows/LoggerWindow.h"
+#include "./Engine/SceneIndex.h"
+#include "./Engine/MemoryTracker.h"
 
 
 
@@ -22,6 +24,8 @@ extern LoggerWindow *g_LoggerWindow;
 
 void SceneManager::SaveScene(const std::vector<std::shared_ptr<GameObject>> &gameobjects, const std::string &filename)
 {
+    MemoryTagScope memoryTag(MemoryTag::Scene);
+
     YAML::Node sceneNode;
 
     for (const auto &gameobject : gameobjects)
@@ -35,6 +39,8 @@ void SceneManager::SaveScene(const std::vector<std::shared_ptr<GameObject>> &gam
 
 void SceneManager::LoadScene(std::vector<std::shared_ptr<GameObject>> &gameobjects, const std::string &filename)
 {
+    MemoryTagScope memoryTag(MemoryTag::Scene);
+
     if (!std::filesystem::exists(filename) || !std::filesystem::is_regular_file(filename)) {
 
         g_LoggerWindow->AddLog("Error: File not found: %s", ImVec4(1.0f,0.0f,0.0f,1.0f), filename.c_str());
@@ -44,6 +50,9 @@ void SceneManager::LoadScene(std::vector<std::shared_ptr<GameObject>> &gameobjec
 
 
     YAML::Node sceneNode = YAML::LoadFile(filename);
+
+    // Unindex before the objects are destroyed; scripts running during the load only see objects loaded so far
+    g_SceneIndex.Clear();
     gameobjects.clear();
 
     if (sceneNode["Entities"])
@@ -55,6 +64,7 @@ void SceneManager::LoadScene(std::vector<std::shared_ptr<GameObject>> &gameobjec
             auto gameobject = std::make_shared<GameObject>(id, name);
             gameobject->Deserialize(gameobjectNode);
             gameobjects.push_back(gameobject);
+            g_SceneIndex.Add(gameobject.get());
         }
     }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <string>
 #include <random>
 #include <chrono>
+#include <cstdio>
 
 namespace fs = std::filesystem;
 
@@ -55,4 +56,30 @@ std::filesystem::path createTempFolder() {
     }
 }
 
-
+// File paths in profiler zones and benchmark names carry backslashes on Windows
+void WriteJsonString(std::ostream &out, std::string_view text)
+{
+    out << '"';
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out << escaped;
+            }
+            else
+                out << c;
+        }
+    }
+    out << '"';
+}
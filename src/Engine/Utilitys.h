@@ -1,7 +1,12 @@
 #include <filesystem>
+#include <ostream>
 #include <string>
+#include <string_view>
 
 
 
 std::filesystem::path createTempFolder();
 
+// Writes `text` as a quoted JSON string (quotes, backslashes and control characters escaped)
+void WriteJsonString(std::ostream &out, std::string_view text);
+
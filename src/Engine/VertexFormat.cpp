@@ -0,0 +1,205 @@
+// VertexFormat.cpp
+
+#include "VertexFormat.h"
+#include "Engine/AssetManager.h"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// Half floats have 10 mantissa bits, so past 2.0 the UV step is coarser than a texel of a 1024px texture
+static const float MaxHalfTexCoord = 2.0f;
+
+const char *VertexLayoutName(VertexLayout layout)
+{
+    switch (layout)
+    {
+    case VertexLayout::Float32:
+        return "Float32";
+    case VertexLayout::Compact:
+        return "Compact";
+    case VertexLayout::Quantized:
+        return "Quantized";
+    }
+    return "Unknown";
+}
+
+unsigned int VertexLayoutStride(VertexLayout layout)
+{
+    switch (layout)
+    {
+    case VertexLayout::Compact:
+        return sizeof(CompactVertex);
+    case VertexLayout::Quantized:
+        return sizeof(QuantizedVertex);
+    case VertexLayout::Float32:
+    default:
+        return sizeof(Vertex);
+    }
+}
+
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    // Inf / NaN
+    if (exponent == 0xFFu)
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+
+    int halfExponent = static_cast<int>(exponent) - 127 + 15;
+
+    // Overflow -> Inf
+    if (halfExponent >= 31)
+        return static_cast<uint16_t>(sign | 0x7C00u);
+
+    // Subnormal or zero
+    if (halfExponent <= 0)
+    {
+        if (halfExponent < -10)
+            return static_cast<uint16_t>(sign);
+
+        mantissa |= 0x800000u; // Implicit leading one
+        int shift = 14 - halfExponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u)))
+            half++;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = (static_cast<uint32_t>(halfExponent) << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFFu;
+    // Round to nearest even; a carry correctly bumps the exponent (and saturates to Inf)
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+        half++;
+    return static_cast<uint16_t>(sign | half);
+}
+
+static int16_t ToSnorm16(float value)
+{
+    value = std::max(-1.0f, std::min(1.0f, value));
+    return static_cast<int16_t>(std::lround(value * 32767.0f));
+}
+
+void EncodeOctahedralNormal(const float normal[3], int16_t out[2])
+{
+    float x = normal[0];
+    float y = normal[1];
+    float z = normal[2];
+
+    float l1 = std::fabs(x) + std::fabs(y) + std::fabs(z);
+    if (l1 <= 0.0f)
+    {
+        out[0] = 0;
+        out[1] = 0;
+        return;
+    }
+
+    x /= l1;
+    y /= l1;
+
+    // Fold the lower hemisphere over the diagonals
+    if (z < 0.0f)
+    {
+        float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+
+    out[0] = ToSnorm16(x);
+    out[1] = ToSnorm16(y);
+}
+
+PackedVertexData PackVertices(const std::vector<Vertex> &vertices, VertexLayout requestedLayout)
+{
+    PackedVertexData packed;
+    packed.layout = requestedLayout;
+
+    if (requestedLayout != VertexLayout::Float32)
+    {
+        for (const Vertex &v : vertices)
+        {
+            if (std::fabs(v.texCoord[0]) > MaxHalfTexCoord || std::fabs(v.texCoord[1]) > MaxHalfTexCoord)
+            {
+                packed.layout = VertexLayout::Float32;
+                break;
+            }
+        }
+    }
+
+    packed.stride = VertexLayoutStride(packed.layout);
+    packed.bytes.resize(vertices.size() * packed.stride);
+
+    switch (packed.layout)
+    {
+    case VertexLayout::Float32:
+    {
+        if (!vertices.empty())
+            std::memcpy(packed.bytes.data(), vertices.data(), packed.bytes.size());
+        break;
+    }
+    case VertexLayout::Compact:
+    {
+        CompactVertex *out = reinterpret_cast<CompactVertex *>(packed.bytes.data());
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const Vertex &v = vertices[i];
+            out[i].position[0] = v.position[0];
+            out[i].position[1] = v.position[1];
+            out[i].position[2] = v.position[2];
+            out[i].texCoord[0] = FloatToHalf(v.texCoord[0]);
+            out[i].texCoord[1] = FloatToHalf(v.texCoord[1]);
+            EncodeOctahedralNormal(v.normal, out[i].normal);
+        }
+        break;
+    }
+    case VertexLayout::Quantized:
+    {
+        float minPos[3] = {0.0f, 0.0f, 0.0f};
+        float maxPos[3] = {0.0f, 0.0f, 0.0f};
+        if (!vertices.empty())
+        {
+            for (int a = 0; a < 3; ++a)
+                minPos[a] = maxPos[a] = vertices[0].position[a];
+        }
+        for (const Vertex &v : vertices)
+        {
+            for (int a = 0; a < 3; ++a)
+            {
+                minPos[a] = std::min(minPos[a], v.position[a]);
+                maxPos[a] = std::max(maxPos[a], v.position[a]);
+            }
+        }
+
+        // Map the bounding box onto [-1, 1] per axis
+        for (int a = 0; a < 3; ++a)
+        {
+            float halfExtent = 0.5f * (maxPos[a] - minPos[a]);
+            packed.positionOffset[a] = 0.5f * (maxPos[a] + minPos[a]);
+            packed.positionScale[a] = (halfExtent > 0.0f) ? halfExtent : 1.0f;
+        }
+
+        QuantizedVertex *out = reinterpret_cast<QuantizedVertex *>(packed.bytes.data());
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const Vertex &v = vertices[i];
+            for (int a = 0; a < 3; ++a)
+                out[i].position[a] = ToSnorm16((v.position[a] - packed.positionOffset[a]) / packed.positionScale[a]);
+            out[i].position[3] = 0;
+            out[i].texCoord[0] = FloatToHalf(v.texCoord[0]);
+            out[i].texCoord[1] = FloatToHalf(v.texCoord[1]);
+            EncodeOctahedralNormal(v.normal, out[i].normal);
+        }
+        break;
+    }
+    }
+
+    return packed;
+}
@@ -0,0 +1,63 @@
+// VertexFormat.h
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct Vertex;
+
+// GPU-side vertex layouts a Submesh can be uploaded with
+enum class VertexLayout
+{
+    Float32,   // 32 bytes: float position, float UV, float normal
+    Compact,   // 20 bytes: float position, half-float UV, octahedral snorm16 normal
+    Quantized, // 16 bytes: snorm16 position (per-submesh dequant), half-float UV, octahedral snorm16 normal
+};
+
+struct CompactVertex
+{
+    float position[3];
+    uint16_t texCoord[2]; // IEEE half floats
+    int16_t normal[2];    // Octahedral encoded, snorm16
+};
+
+struct QuantizedVertex
+{
+    int16_t position[4];  // snorm16, w is padding for 4 byte alignment
+    uint16_t texCoord[2]; // IEEE half floats
+    int16_t normal[2];    // Octahedral encoded, snorm16
+};
+
+static_assert(sizeof(CompactVertex) == 20, "CompactVertex must be tightly packed");
+static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex must be tightly packed");
+
+// Result of packing a vertex array for upload
+struct PackedVertexData
+{
+    VertexLayout layout = VertexLayout::Float32;
+    std::vector<uint8_t> bytes;
+    unsigned int stride = 0;
+
+    // Dequantization transform: position = packed * positionScale + positionOffset
+    float positionScale[3] = {1.0f, 1.0f, 1.0f};
+    float positionOffset[3] = {0.0f, 0.0f, 0.0f};
+};
+
+const char *VertexLayoutName(VertexLayout layout);
+
+unsigned int VertexLayoutStride(VertexLayout layout);
+
+// IEEE 754 binary32 -> binary16 with round-to-nearest-even
+uint16_t FloatToHalf(float value);
+
+// Octahedral normal encoding into two snorm16 components
+void EncodeOctahedralNormal(const float normal[3], int16_t out[2]);
+
+/**
+ * @brief Packs vertices into the requested layout.
+ *
+ * Layouts with half float UVs fall back to Float32 when any |UV| exceeds
+ * MaxHalfTexCoord (2.0), because half floats lose sub-texel precision
+ * beyond that range.
+ */
+PackedVertexData PackVertices(const std::vector<Vertex> &vertices, VertexLayout requestedLayout);
@@ -1,6 +1,7 @@
 // src/Rendering/FBO.cpp
 
 #include "FBO.h"
+#include "GPUMemory.h"
 #include <cstdio>
 
 bool FBO::Create(int width, int height)
@@ -24,11 +25,13 @@ bool FBO::Create(int width, int height)
 
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
                            GL_TEXTURE_2D, m_TextureID, 0);
+    GPUMemory::Get().RecordTexture(m_TextureID, GPUMemoryCategory::RenderTarget, GPUMemory::TextureBytes(width, height, 4, false), "Framebuffer");
 
     // 3) Create RBO for depth/stencil
     glGenRenderbuffers(1, &m_RBO);
     glBindRenderbuffer(GL_RENDERBUFFER, m_RBO);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    GPUMemory::Get().RecordRenderbuffer(m_RBO, GPUMemory::TextureBytes(width, height, 4, false), "Framebuffer");
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
                               GL_RENDERBUFFER, m_RBO);
 
@@ -49,11 +52,13 @@ void FBO::Cleanup()
 {
     if (m_TextureID)
     {
+        GPUMemory::Get().ReleaseTexture(m_TextureID);
         glDeleteTextures(1, &m_TextureID);
         m_TextureID = 0;
     }
     if (m_RBO)
     {
+        GPUMemory::Get().ReleaseRenderbuffer(m_RBO);
         glDeleteRenderbuffers(1, &m_RBO);
         m_RBO = 0;
     }
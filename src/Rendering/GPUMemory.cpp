@@ -0,0 +1,115 @@
+// src/Rendering/GPUMemory.cpp
+
+#include "GPUMemory.h"
+
+#include <algorithm>
+
+void GPUMemory::RecordBuffer(GLuint buffer, GPUMemoryCategory category, size_t bytes, const std::string &owner)
+{
+    Record(ObjectKind::Buffer, buffer, category, bytes, owner);
+}
+
+void GPUMemory::RecordTexture(GLuint texture, GPUMemoryCategory category, size_t bytes, const std::string &owner)
+{
+    Record(ObjectKind::Texture, texture, category, bytes, owner);
+}
+
+void GPUMemory::RecordRenderbuffer(GLuint renderbuffer, size_t bytes, const std::string &owner)
+{
+    Record(ObjectKind::Renderbuffer, renderbuffer, GPUMemoryCategory::RenderTarget, bytes, owner);
+}
+
+void GPUMemory::ReleaseBuffer(GLuint buffer)
+{
+    Release(ObjectKind::Buffer, buffer);
+}
+
+void GPUMemory::ReleaseTexture(GLuint texture)
+{
+    Release(ObjectKind::Texture, texture);
+}
+
+void GPUMemory::ReleaseRenderbuffer(GLuint renderbuffer)
+{
+    Release(ObjectKind::Renderbuffer, renderbuffer);
+}
+
+size_t GPUMemory::TextureBytes(int width, int height, int bytesPerPixel, bool mipmapped)
+{
+    size_t base = static_cast<size_t>(std::max(width, 0)) * static_cast<size_t>(std::max(height, 0)) * static_cast<size_t>(std::max(bytesPerPixel, 0));
+    return mipmapped ? base + base / 3 : base;
+}
+
+const char *GPUMemory::CategoryName(GPUMemoryCategory category)
+{
+    switch (category)
+    {
+    case GPUMemoryCategory::VertexBuffer:
+        return "Vertex Buffers";
+    case GPUMemoryCategory::IndexBuffer:
+        return "Index Buffers";
+    case GPUMemoryCategory::Texture:
+        return "Textures";
+    case GPUMemoryCategory::RenderTarget:
+        return "Render Targets";
+    default:
+        return "Unknown";
+    }
+}
+
+void GPUMemory::Record(ObjectKind kind, GLuint name, GPUMemoryCategory category, size_t bytes, const std::string &owner)
+{
+    if (name == 0)
+        return;
+
+    // Re-uploading into the same object replaces its previous size
+    Release(kind, name);
+
+    size_t index = static_cast<size_t>(category);
+    m_Allocations[Key(kind, name)] = {category, bytes, owner};
+    m_CategoryBytes[index] += bytes;
+    m_TotalBytes += bytes;
+
+    GPUAssetMemory &asset = m_Assets[owner];
+    asset.Owner = owner;
+    asset.Bytes[index] += bytes;
+    asset.TotalBytes += bytes;
+}
+
+void GPUMemory::Release(ObjectKind kind, GLuint name)
+{
+    auto it = m_Allocations.find(Key(kind, name));
+    if (it == m_Allocations.end())
+        return;
+
+    const Allocation &allocation = it->second;
+    size_t index = static_cast<size_t>(allocation.Category);
+    m_CategoryBytes[index] -= allocation.Bytes;
+    m_TotalBytes -= allocation.Bytes;
+
+    auto asset = m_Assets.find(allocation.Owner);
+    if (asset != m_Assets.end())
+    {
+        asset->second.Bytes[index] -= allocation.Bytes;
+        asset->second.TotalBytes -= allocation.Bytes;
+        if (asset->second.TotalBytes == 0)
+            m_Assets.erase(asset);
+    }
+
+    m_Allocations.erase(it);
+}
+
+std::vector<GPUAssetMemory> GPUMemory::GetLargestAssets(size_t count) const
+{
+    std::vector<GPUAssetMemory> assets;
+    assets.reserve(m_Assets.size());
+    for (const auto &[owner, asset] : m_Assets)
+        assets.push_back(asset);
+
+    count = std::min(count, assets.size());
+    std::partial_sort(assets.begin(), assets.begin() + count, assets.end(),
+                      [](const GPUAssetMemory &a, const GPUAssetMemory &b)
+                      { return a.TotalBytes > b.TotalBytes; });
+    assets.resize(count);
+    return assets;
+}
@@ -0,0 +1,97 @@
+// src/Rendering/GPUMemory.h
+
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class GPUMemoryCategory : uint8_t
+{
+    VertexBuffer,
+    IndexBuffer,
+    Texture,
+    RenderTarget,
+    Count
+};
+
+// GPU bytes owned by one asset (a model, texture file or render target)
+struct GPUAssetMemory
+{
+    std::string Owner;
+    size_t Bytes[static_cast<size_t>(GPUMemoryCategory::Count)] = {};
+    size_t TotalBytes = 0;
+};
+
+/**
+ * @brief Bookkeeping of GL allocations: byte size, category and owning asset.
+ *
+ * GL doesn't report what it allocates, so every upload site records its
+ * object here and every delete site releases it. Sizes are what was
+ * requested (textures include an estimated 1/3 for their mip chain), not
+ * what the driver actually reserves after padding and alignment.
+ */
+class GPUMemory
+{
+public:
+    static GPUMemory &Get()
+    {
+        static GPUMemory instance;
+        return instance;
+    }
+
+    // Records a buffer (VertexBuffer/IndexBuffer) or texture/renderbuffer; re-recording a name replaces it
+    void RecordBuffer(GLuint buffer, GPUMemoryCategory category, size_t bytes, const std::string &owner);
+    void RecordTexture(GLuint texture, GPUMemoryCategory category, size_t bytes, const std::string &owner);
+    void RecordRenderbuffer(GLuint renderbuffer, size_t bytes, const std::string &owner);
+
+    // Call next to glDeleteBuffers / glDeleteTextures / glDeleteRenderbuffers; unknown names are ignored
+    void ReleaseBuffer(GLuint buffer);
+    void ReleaseTexture(GLuint texture);
+    void ReleaseRenderbuffer(GLuint renderbuffer);
+
+    // Bytes for a 2D texture with a full mip chain
+    static size_t TextureBytes(int width, int height, int bytesPerPixel, bool mipmapped);
+
+    static const char *CategoryName(GPUMemoryCategory category);
+
+    size_t GetTotalBytes() const { return m_TotalBytes; }
+    size_t GetCategoryBytes(GPUMemoryCategory category) const { return m_CategoryBytes[static_cast<size_t>(category)]; }
+    size_t GetAllocationCount() const { return m_Allocations.size(); }
+
+    // Largest owners first
+    std::vector<GPUAssetMemory> GetLargestAssets(size_t count) const;
+
+private:
+    GPUMemory() {}
+    GPUMemory(const GPUMemory &) = delete;
+    GPUMemory &operator=(const GPUMemory &) = delete;
+
+    // GL names are only unique per object kind
+    enum class ObjectKind : uint8_t
+    {
+        Buffer,
+        Texture,
+        Renderbuffer
+    };
+
+    struct Allocation
+    {
+        GPUMemoryCategory Category;
+        size_t Bytes;
+        std::string Owner;
+    };
+
+    static uint64_t Key(ObjectKind kind, GLuint name) { return (static_cast<uint64_t>(kind) << 32) | name; }
+
+    void Record(ObjectKind kind, GLuint name, GPUMemoryCategory category, size_t bytes, const std::string &owner);
+    void Release(ObjectKind kind, GLuint name);
+
+    std::unordered_map<uint64_t, Allocation> m_Allocations;
+    std::unordered_map<std::string, GPUAssetMemory> m_Assets;
+    size_t m_CategoryBytes[static_cast<size_t>(GPUMemoryCategory::Count)] = {};
+    size_t m_TotalBytes = 0;
+};
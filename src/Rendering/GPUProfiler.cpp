@@ -0,0 +1,153 @@
+// src/Rendering/GPUProfiler.cpp
+
+#include "GPUProfiler.h"
+#include "gcml.h"
+
+#include <cstring>
+
+void GPUProfiler::Initialize()
+{
+    m_Supported = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+    if (m_Supported)
+    {
+        // Some software implementations expose the entry points but no counter
+        GLint bits = 0;
+        glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &bits);
+        m_Supported = bits > 0;
+    }
+
+    DEBUG_PRINT("[GPUProfiler] Timer queries %s", m_Supported ? "available" : "unsupported, GPU zones disabled");
+}
+
+void GPUProfiler::Shutdown()
+{
+    for (Frame &frame : m_Frames)
+    {
+        if (!frame.Queries.empty())
+            glDeleteQueries(static_cast<GLsizei>(frame.Queries.size()), frame.Queries.data());
+        frame.Queries.clear();
+        frame.Zones.clear();
+        frame.UsedQueries = 0;
+        frame.Pending = false;
+    }
+    m_Supported = false;
+}
+
+uint32_t GPUProfiler::AllocateQuery(Frame &frame)
+{
+    if (frame.UsedQueries == frame.Queries.size())
+    {
+        // Grow in chunks so a busy first frame doesn't call glGenQueries per zone
+        size_t grow = frame.Queries.empty() ? 64 : frame.Queries.size();
+        frame.Queries.resize(frame.Queries.size() + grow);
+        glGenQueries(static_cast<GLsizei>(grow), frame.Queries.data() + frame.Queries.size() - grow);
+    }
+    return frame.UsedQueries++;
+}
+
+uint32_t GPUProfiler::BeginZone(const char *name)
+{
+    if (!m_Supported || !m_Enabled)
+        return NoZone;
+
+    Frame &frame = m_Frames[m_CurrentFrame];
+    if (frame.Zones.size() >= MaxZonesPerFrame)
+    {
+        m_DroppedZones++;
+        return NoZone;
+    }
+
+    Zone zone;
+    zone.Name = name;
+    zone.Depth = m_Depth++;
+    zone.BeginQuery = AllocateQuery(frame);
+    zone.EndQuery = NoZone;
+    glQueryCounter(frame.Queries[zone.BeginQuery], GL_TIMESTAMP);
+
+    frame.Zones.push_back(zone);
+    return static_cast<uint32_t>(frame.Zones.size() - 1);
+}
+
+void GPUProfiler::EndZone(uint32_t zoneIndex)
+{
+    Frame &frame = m_Frames[m_CurrentFrame];
+    if (zoneIndex >= frame.Zones.size())
+        return;
+
+    Zone &zone = frame.Zones[zoneIndex];
+    zone.EndQuery = AllocateQuery(frame);
+    glQueryCounter(frame.Queries[zone.EndQuery], GL_TIMESTAMP);
+    m_Depth = zone.Depth;
+}
+
+void GPUProfiler::EndFrame()
+{
+    if (!m_Supported)
+        return;
+
+    m_Frames[m_CurrentFrame].Pending = !m_Frames[m_CurrentFrame].Zones.empty();
+    m_CurrentFrame = (m_CurrentFrame + 1) % FrameLatency;
+    m_Depth = 0;
+
+    // Oldest first; the GPU finishes frames in order, so stop at the first one still in flight
+    for (int i = 0; i < FrameLatency; ++i)
+    {
+        Frame &frame = m_Frames[(m_CurrentFrame + i) % FrameLatency];
+        if (frame.Pending && !Collect(frame))
+            break;
+    }
+
+    // The slot about to be reused: drop its results rather than wait for them
+    Frame &next = m_Frames[m_CurrentFrame];
+    if (next.Pending)
+        m_SkippedFrames++;
+    next.Pending = false;
+    next.UsedQueries = 0;
+    next.Zones.clear();
+}
+
+bool GPUProfiler::Collect(Frame &frame)
+{
+    GLuint available = 0;
+    glGetQueryObjectuiv(frame.Queries[frame.UsedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return false;
+
+    m_LastFrameResults.clear();
+    m_LastFrameTimeUs = 0.0;
+
+    for (const Zone &zone : frame.Zones)
+    {
+        if (zone.EndQuery == NoZone)
+            continue;
+
+        GLuint64 begin = 0, end = 0;
+        glGetQueryObjectui64v(frame.Queries[zone.BeginQuery], GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(frame.Queries[zone.EndQuery], GL_QUERY_RESULT, &end);
+        double timeUs = end > begin ? (end - begin) / 1000.0 : 0.0;
+
+        if (zone.Depth == 0)
+            m_LastFrameTimeUs += timeUs;
+
+        // Repeated zones (e.g. one per draw batch) merge into one row per name and depth
+        GPUZoneResult *result = nullptr;
+        for (GPUZoneResult &existing : m_LastFrameResults)
+        {
+            if (existing.Depth == zone.Depth && std::strcmp(existing.Name, zone.Name) == 0)
+            {
+                result = &existing;
+                break;
+            }
+        }
+        if (!result)
+        {
+            m_LastFrameResults.push_back({zone.Name, zone.Depth, 0.0, 0});
+            result = &m_LastFrameResults.back();
+        }
+        result->TimeUs += timeUs;
+        result->CallCount++;
+    }
+
+    frame.Pending = false;
+    return true;
+}
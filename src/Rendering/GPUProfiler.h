@@ -0,0 +1,124 @@
+// src/Rendering/GPUProfiler.h
+
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <vector>
+
+// GPU time of one zone name at one nesting depth, summed over a frame
+struct GPUZoneResult
+{
+    const char *Name;
+    uint32_t Depth;
+    double TimeUs;
+    int CallCount;
+};
+
+/**
+ * @brief GPU timings from GL timestamp queries.
+ *
+ * Each zone writes a timestamp when the GPU reaches its begin and end. Query
+ * sets are ring-buffered over FrameLatency frames and only read once the GPU
+ * reports them available, so profiling never waits on the GPU; results lag
+ * the CPU by a few frames. Without timer query support (GL < 3.3 and no
+ * ARB_timer_query, or a driver reporting 0 counter bits, as some software
+ * renderers do) every zone is a no-op.
+ */
+class GPUProfiler
+{
+public:
+    static GPUProfiler &Get()
+    {
+        static GPUProfiler instance;
+        return instance;
+    }
+
+    // Call once with a current GL context
+    void Initialize();
+    void Shutdown();
+
+    bool IsSupported() const { return m_Supported; }
+    bool IsEnabled() const { return m_Enabled; }
+    void SetEnabled(bool enabled) { m_Enabled = enabled; }
+
+    // Zone index for EndZone, or NoZone when not recording
+    uint32_t BeginZone(const char *name);
+    void EndZone(uint32_t zone);
+
+    // Call once per frame after the last GPU zone; collects the oldest frame if the GPU has finished it
+    void EndFrame();
+
+    // Zones of the newest completed frame, in the order they began
+    const std::vector<GPUZoneResult> &GetLastFrameResults() const { return m_LastFrameResults; }
+
+    // GPU time of the outermost zones of the newest completed frame
+    double GetLastFrameTimeUs() const { return m_LastFrameTimeUs; }
+
+    // Frames whose results weren't ready when their slot was reused, and zones beyond MaxZonesPerFrame
+    uint64_t GetSkippedFrames() const { return m_SkippedFrames; }
+    uint64_t GetDroppedZones() const { return m_DroppedZones; }
+
+    static const uint32_t NoZone = UINT32_MAX;
+    static const int FrameLatency = 3;
+    static const uint32_t MaxZonesPerFrame = 1024;
+
+private:
+    GPUProfiler() {}
+    GPUProfiler(const GPUProfiler &) = delete;
+    GPUProfiler &operator=(const GPUProfiler &) = delete;
+
+    struct Zone
+    {
+        const char *Name;
+        uint32_t Depth;
+        uint32_t BeginQuery; // Indices into the frame's query pool
+        uint32_t EndQuery;
+    };
+
+    struct Frame
+    {
+        std::vector<GLuint> Queries; // Grows on demand, reused every FrameLatency frames
+        uint32_t UsedQueries = 0;
+        std::vector<Zone> Zones;
+        bool Pending = false; // Issued and not yet read back
+    };
+
+    uint32_t AllocateQuery(Frame &frame);
+
+    // Reads a finished frame into m_LastFrameResults; false if the GPU hasn't reached its last query yet
+    bool Collect(Frame &frame);
+
+    bool m_Supported = false;
+    bool m_Enabled = true;
+
+    Frame m_Frames[FrameLatency];
+    int m_CurrentFrame = 0;
+    uint32_t m_Depth = 0;
+
+    std::vector<GPUZoneResult> m_LastFrameResults;
+    double m_LastFrameTimeUs = 0.0;
+
+    uint64_t m_SkippedFrames = 0;
+    uint64_t m_DroppedZones = 0;
+};
+
+// Times the GPU work submitted in the rest of the scope
+class GPUProfileZone
+{
+public:
+    explicit GPUProfileZone(const char *name) : m_Zone(GPUProfiler::Get().BeginZone(name)) {}
+    ~GPUProfileZone() { GPUProfiler::Get().EndZone(m_Zone); }
+
+    GPUProfileZone(const GPUProfileZone &) = delete;
+    GPUProfileZone &operator=(const GPUProfileZone &) = delete;
+
+private:
+    uint32_t m_Zone;
+};
+
+#define GPU_PROFILER_CONCAT_INNER(a, b) a##b
+#define GPU_PROFILER_CONCAT(a, b) GPU_PROFILER_CONCAT_INNER(a, b)
+
+// GPU counterpart of PROFILE_ZONE; `name` must be a string literal
+#define GPU_PROFILE_ZONE(name) GPUProfileZone GPU_PROFILER_CONCAT(gpuProfileZone, __LINE__)(name)
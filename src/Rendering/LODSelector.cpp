@@ -0,0 +1,53 @@
+// src/Rendering/LODSelector.cpp
+
+#include "LODSelector.h"
+
+#include <algorithm>
+#include <cmath>
+
+LODSettings g_LODSettings;
+LODStats g_LODStats;
+
+float LODSelector::ProjectedScreenSize(const glm::vec3 &worldCenter, float worldRadius,
+                                       const glm::mat4 &view, const glm::mat4 &proj)
+{
+    glm::vec4 viewCenter = view * glm::vec4(worldCenter, 1.0f);
+
+    // proj[1][1] is cot(fov / 2) for perspective, 2 / (top - bottom) for orthographic
+    float yScale = std::fabs(proj[1][1]);
+
+    bool perspective = proj[2][3] != 0.0f;
+    if (!perspective)
+        return worldRadius * yScale;
+
+    float distance = glm::length(glm::vec3(viewCenter));
+    if (distance <= worldRadius)
+        return 1.0f; // Camera is inside the bounds
+
+    return worldRadius * yScale / distance;
+}
+
+int LODSelector::SelectLOD(float screenSize, int currentLOD, int lodCount, const LODSettings &settings)
+{
+    lodCount = std::min(lodCount, MAX_MESH_LODS);
+    if (lodCount <= 1)
+        return 0;
+
+    if (settings.ForcedLOD >= 0)
+        return std::min(settings.ForcedLOD, lodCount - 1);
+
+    if (!settings.Enabled)
+        return 0;
+
+    int lod = std::max(0, std::min(currentLOD, lodCount - 1));
+
+    // Coarser while clearly under the threshold of the current LOD
+    while (lod + 1 < lodCount && screenSize < settings.Thresholds[lod] * (1.0f - settings.Hysteresis))
+        lod++;
+
+    // Finer while clearly over the threshold of the next finer LOD
+    while (lod > 0 && screenSize > settings.Thresholds[lod - 1] * (1.0f + settings.Hysteresis))
+        lod--;
+
+    return lod;
+}
@@ -0,0 +1,58 @@
+// src/Rendering/LODSelector.h
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+// Maximum number of LODs a submesh can carry (full resolution + simplified levels)
+#define MAX_MESH_LODS 4
+
+// Tunables for screen-size based LOD selection
+struct LODSettings
+{
+    bool Enabled = true;
+    int ForcedLOD = -1; // >= 0 renders every object at that LOD
+
+    // Projected screen height fraction below which LOD i+1 is used instead of LOD i
+    float Thresholds[MAX_MESH_LODS - 1] = {0.5f, 0.25f, 0.1f};
+
+    // Fraction around each threshold inside which the current LOD is kept (avoids popping)
+    float Hysteresis = 0.15f;
+};
+
+// Per-frame LOD counters, reset at the start of every scene render
+struct LODStats
+{
+    int ObjectsPerLOD[MAX_MESH_LODS] = {0};
+    int TrianglesDrawn = 0;
+    int TrianglesFullDetail = 0;
+
+    void Reset()
+    {
+        for (int &count : ObjectsPerLOD)
+            count = 0;
+        TrianglesDrawn = 0;
+        TrianglesFullDetail = 0;
+    }
+};
+
+extern LODSettings g_LODSettings;
+extern LODStats g_LODStats;
+
+class LODSelector
+{
+public:
+    /**
+     * @brief Fraction of the viewport height covered by a bounding sphere.
+     *
+     * Works for both perspective and orthographic projections.
+     */
+    static float ProjectedScreenSize(const glm::vec3 &worldCenter, float worldRadius,
+                                     const glm::mat4 &view, const glm::mat4 &proj);
+
+    /**
+     * @brief Picks a LOD for the given screen size, keeping currentLOD while
+     * the size stays inside the hysteresis band around its thresholds.
+     */
+    static int SelectLOD(float screenSize, int currentLOD, int lodCount, const LODSettings &settings);
+};
@@ -0,0 +1,77 @@
+// src/Rendering/MeshletCulling.cpp
+
+#include "MeshletCulling.h"
+#include "Engine/Meshlet.h"
+
+#include <cmath>
+
+MeshletCullingSettings g_MeshletCullingSettings;
+MeshletStats g_MeshletStats;
+
+Frustum MeshletCulling::ExtractFrustum(const glm::mat4 &m)
+{
+    // glm is column major: m[column][row]
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum frustum;
+    frustum.Planes[0] = row3 + row0; // Left
+    frustum.Planes[1] = row3 - row0; // Right
+    frustum.Planes[2] = row3 + row1; // Bottom
+    frustum.Planes[3] = row3 - row1; // Top
+    frustum.Planes[4] = row3 + row2; // Near
+    frustum.Planes[5] = row3 - row2; // Far
+
+    for (glm::vec4 &plane : frustum.Planes)
+    {
+        float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f)
+            plane = plane / length;
+    }
+    return frustum;
+}
+
+bool MeshletCulling::SphereInFrustum(const Frustum &frustum, const glm::vec3 &center, float radius)
+{
+    for (const glm::vec4 &plane : frustum.Planes)
+    {
+        if (plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+bool MeshletCulling::ConeBackfacing(const glm::vec3 &center, float radius, const glm::vec3 &coneAxis,
+                                    float coneCutoff, const glm::vec3 &eye)
+{
+    if (coneCutoff >= 1.0f)
+        return false;
+
+    glm::vec3 toCenter = center - eye;
+    float distance = glm::length(toCenter);
+    if (distance <= radius)
+        return false;
+
+    return glm::dot(toCenter, coneAxis) >= coneCutoff * distance + radius;
+}
+
+MeshletVisibility MeshletCulling::Classify(const Meshlet &meshlet, const glm::mat4 &model, float maxScale,
+                                           const Frustum &frustum, const glm::vec3 &eye,
+                                           bool frustumCulling, bool coneCulling)
+{
+    glm::vec3 center = glm::vec3(model * glm::vec4(meshlet.center[0], meshlet.center[1], meshlet.center[2], 1.f));
+    float radius = meshlet.radius * maxScale;
+
+    if (frustumCulling && !SphereInFrustum(frustum, center, radius))
+        return MeshletVisibility::FrustumCulled;
+
+    if (coneCulling)
+    {
+        glm::vec3 axis = glm::normalize(glm::vec3(model * glm::vec4(meshlet.coneAxis[0], meshlet.coneAxis[1], meshlet.coneAxis[2], 0.f)));
+        if (ConeBackfacing(center, radius, axis, meshlet.coneCutoff, eye))
+            return MeshletVisibility::ConeCulled;
+    }
+    return MeshletVisibility::Visible;
+}
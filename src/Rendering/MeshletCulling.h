@@ -0,0 +1,85 @@
+// src/Rendering/MeshletCulling.h
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+struct Meshlet;
+
+// Tunables for per-meshlet culling
+struct MeshletCullingSettings
+{
+    bool Enabled = true;
+    bool FrustumCulling = true;
+    bool ConeCulling = true;
+
+    // The renderer doesn't cull back faces, so on open meshes a back-facing cluster can be visible.
+    // Cone culling is only applied to closed meshes unless this is set.
+    bool ConeCullOpenMeshes = false;
+};
+
+// Per-frame meshlet counters, reset at the start of every scene render
+struct MeshletStats
+{
+    int Meshlets = 0;
+    int FrustumCulled = 0;
+    int ConeCulled = 0;
+    int Drawn = 0;
+    int DrawRanges = 0; // Ranges submitted after merging adjacent visible meshlets
+    int TrianglesCulled = 0;
+
+    void Reset()
+    {
+        Meshlets = 0;
+        FrustumCulled = 0;
+        ConeCulled = 0;
+        Drawn = 0;
+        DrawRanges = 0;
+        TrianglesCulled = 0;
+    }
+};
+
+extern MeshletCullingSettings g_MeshletCullingSettings;
+extern MeshletStats g_MeshletStats;
+
+// World space frustum planes (xyz = normal pointing inside, w = distance)
+struct Frustum
+{
+    glm::vec4 Planes[6];
+};
+
+// Outcome of MeshletCulling::Classify
+enum class MeshletVisibility
+{
+    Visible,
+    FrustumCulled,
+    ConeCulled
+};
+
+class MeshletCulling
+{
+public:
+    // Gribb/Hartmann plane extraction from a view-projection matrix
+    static Frustum ExtractFrustum(const glm::mat4 &viewProj);
+
+    static bool SphereInFrustum(const Frustum &frustum, const glm::vec3 &center, float radius);
+
+    /**
+     * @brief Normal cone test against a world space eye position.
+     *
+     * @return true if every triangle in the meshlet faces away from the eye.
+     */
+    static bool ConeBackfacing(const glm::vec3 &center, float radius, const glm::vec3 &coneAxis,
+                               float coneCutoff, const glm::vec3 &eye);
+
+    /**
+     * @brief Frustum test, then cone test, of one meshlet placed by `model`.
+     *
+     * `maxScale` is the largest absolute scale of `model`. Only pass
+     * coneCulling for rotation + uniform scale transforms of meshes where
+     * hidden back faces are guaranteed (see MeshletCullingSettings).
+     */
+    static MeshletVisibility Classify(const Meshlet &meshlet, const glm::mat4 &model, float maxScale,
+                                      const Frustum &frustum, const glm::vec3 &eye,
+                                      bool frustumCulling, bool coneCulling);
+};
@@ -0,0 +1,163 @@
+// src/Rendering/OpenGLBackend.cpp
+
+#include "OpenGLBackend.h"
+
+#include <GL/glew.h>
+#include <string>
+
+#include "gcml.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/Profiler.h"
+#include "Rendering/GPUProfiler.h"
+#include "Rendering/Shader.h"
+
+extern AssetManager g_AssetManager;
+
+bool OpenGLBackend::Init()
+{
+    std::shared_ptr<Shader> shaderAsset = g_AssetManager.loadAsset<Shader>(AssetType::SHADER, "assets/shaders/UnlitMaterial");
+    if (!shaderAsset)
+    {
+        fprintf(stderr, "[OpenGLBackend] Failed to load shader via AssetManager.\n");
+        return false;
+    }
+    m_ShaderPtr = shaderAsset.get();
+    return true;
+}
+
+void OpenGLBackend::Resize(int width, int height)
+{
+    m_FBO.Create(width, height);
+    m_Width = width;
+    m_Height = height;
+}
+
+unsigned int OpenGLBackend::GetTextureID() const
+{
+    return static_cast<unsigned int>((uintptr_t)m_FBO.GetTextureID());
+}
+
+bool OpenGLBackend::BeginFrame()
+{
+    // Bind the FBO
+    m_FBO.Bind();
+    glViewport(0, 0, m_Width, m_Height);
+
+    glEnable(GL_DEPTH_TEST);
+
+    glClearColor(0.f, 0.f, 0.f, 1.f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    // Use our loaded shader
+    if (!m_ShaderPtr)
+    {
+        DEBUG_PRINT("[OpenGLBackend] Shader pointer is null. Cannot render.");
+        m_FBO.Unbind();
+        return false; // Can't render without a shader
+    }
+
+    m_ShaderPtr->Use();
+    return true;
+}
+
+bool OpenGLBackend::CanDraw(const Submesh &submesh) const
+{
+    if (submesh.vao == 0)
+    {
+        DEBUG_PRINT("[OpenGLBackend] Warning: Submesh VAO is not initialized.");
+        return false;
+    }
+    return true;
+}
+
+void OpenGLBackend::DrawSubmesh(const SubmeshDraw &draw)
+{
+    const Submesh &submesh = *draw.submesh;
+
+    // Pass MVP and Model matrices to the shader
+    m_ShaderPtr->SetMat4("uMVP", draw.mvp);
+    m_ShaderPtr->SetMat4("uModel", draw.model);
+
+    // Bind textures for the submesh
+    // Assuming the shader has uniform arrays like uTextures.texture_diffuse[32]
+    const int MAX_DIFFUSE = 32; // Must match the shader's MAX_DIFFUSE
+    int textureUnit = 0;
+
+    // Iterate through all textures and bind those with type "texture_diffuse"
+    for (const auto &texture : submesh.textures)
+    {
+        if (texture.type == "texture_diffuse")
+        {
+            if (textureUnit >= MAX_DIFFUSE)
+            {
+                DEBUG_PRINT("[OpenGLBackend] Warning: Exceeded maximum number of diffuse textures (%d) for shader.", MAX_DIFFUSE);
+                break; // Prevent exceeding the array bounds in the shader
+            }
+
+            // Activate the appropriate texture unit
+            glActiveTexture(GL_TEXTURE0 + textureUnit);
+            glBindTexture(GL_TEXTURE_2D, texture.id);
+
+            // Construct the uniform name dynamically (e.g., "uTextures.texture_diffuse[0]")
+            std::string uniformName = "uTextures.texture_diffuse[" + std::to_string(textureUnit) + "]";
+            m_ShaderPtr->SetInt(uniformName, textureUnit);
+
+            textureUnit++;
+        }
+    }
+
+    // Assign default texture to unused texture slots to prevent shader errors
+    for (int i = textureUnit; i < MAX_DIFFUSE; ++i)
+    {
+        std::string uniformName = "uTextures.texture_diffuse[" + std::to_string(i) + "]";
+        m_ShaderPtr->SetInt(uniformName, 0); // Assign texture unit 0 (ensure texture 0 is a valid default)
+    }
+
+    // Set the number of active diffuse textures
+    m_ShaderPtr->SetInt("uNumDiffuseTextures", textureUnit);
+
+    // Dequantization / normal decode parameters for the submesh's vertex layout
+    submesh.SetVertexFormatUniforms(m_ShaderPtr);
+
+    // Draw the submesh
+    glBindVertexArray(submesh.vao);
+    size_t indexSize = submesh.IndexSize();
+    if (draw.meshletCulled)
+    {
+        GPU_PROFILE_ZONE("DrawMeshlets");
+
+        // Surviving meshlet ranges go out in one glMultiDrawElements
+        m_MeshletCounts.clear();
+        m_MeshletOffsets.clear();
+        for (const IndexRange &range : *draw.ranges)
+        {
+            m_MeshletCounts.push_back(static_cast<int>(range.count));
+            m_MeshletOffsets.push_back((const void *)(range.offset * indexSize));
+        }
+        if (!m_MeshletCounts.empty())
+        {
+            glMultiDrawElements(GL_TRIANGLES, m_MeshletCounts.data(), submesh.indexType,
+                                m_MeshletOffsets.data(), static_cast<GLsizei>(m_MeshletCounts.size()));
+        }
+    }
+    else
+    {
+        GPU_PROFILE_ZONE("DrawElements");
+        for (const IndexRange &range : *draw.ranges)
+            glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(range.count), submesh.indexType, (void *)(range.offset * indexSize));
+    }
+    glBindVertexArray(0);
+
+    // Reset active texture to default
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void OpenGLBackend::EndFrame()
+{
+    // Cleanup: Unbind the shader program
+    glUseProgram(0);
+
+    // Unbind the FBO
+    m_FBO.Unbind();
+}
@@ -0,0 +1,37 @@
+// src/Rendering/OpenGLBackend.h
+
+#pragma once
+
+#include "RenderBackend.h"
+#include "FBO.h"
+
+class Shader;
+
+// Draws the scene into an offscreen FBO with the UnlitMaterial shader
+class OpenGLBackend : public RenderBackend
+{
+public:
+    RenderBackendType GetType() const override { return RenderBackendType::OpenGL; }
+
+    bool Init() override;
+    void Resize(int width, int height) override;
+
+    unsigned int GetTextureID() const override;
+
+protected:
+    bool BeginFrame() override;
+    void DrawSubmesh(const SubmeshDraw &draw) override;
+    void EndFrame() override;
+    bool CanDraw(const Submesh &submesh) const override;
+
+private:
+    // Offscreen render target
+    FBO m_FBO;
+
+    // The loaded shader program (via AssetManager)
+    Shader *m_ShaderPtr = nullptr;
+
+    // Scratch buffers for glMultiDrawElements, reused across frames
+    std::vector<int> m_MeshletCounts;
+    std::vector<const void *> m_MeshletOffsets;
+};
@@ -0,0 +1,136 @@
+// src/Rendering/PNGWriter.cpp
+
+#include "PNGWriter.h"
+
+#include <algorithm>
+#include <fstream>
+
+uint32_t Crc32(const uint8_t *data, size_t size, uint32_t crc)
+{
+    // Reflected polynomial 0xEDB88320, table built on first use
+    static const struct CrcTable
+    {
+        uint32_t Entries[256];
+        CrcTable()
+        {
+            for (uint32_t i = 0; i < 256; ++i)
+            {
+                uint32_t c = i;
+                for (int bit = 0; bit < 8; ++bit)
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                Entries[i] = c;
+            }
+        }
+    } table;
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i)
+        crc = table.Entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+uint32_t Adler32(const uint8_t *data, size_t size, uint32_t adler)
+{
+    const uint32_t mod = 65521;
+    uint32_t a = adler & 0xFFFF;
+    uint32_t b = adler >> 16;
+
+    // 5552 bytes is the longest run before the sums can overflow 32 bits
+    while (size > 0)
+    {
+        size_t run = std::min<size_t>(size, 5552);
+        size -= run;
+        for (size_t i = 0; i < run; ++i)
+        {
+            a += *data++;
+            b += a;
+        }
+        a %= mod;
+        b %= mod;
+    }
+    return (b << 16) | a;
+}
+
+static void AppendBigEndian(std::vector<uint8_t> &out, uint32_t value)
+{
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Length, type, data, then the CRC over type and data
+static void AppendChunk(std::vector<uint8_t> &out, const char type[4], const std::vector<uint8_t> &data)
+{
+    AppendBigEndian(out, static_cast<uint32_t>(data.size()));
+    size_t typeStart = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    AppendBigEndian(out, Crc32(out.data() + typeStart, 4 + data.size()));
+}
+
+std::vector<uint8_t> EncodePNG(int width, int height, const uint8_t *rgba)
+{
+    std::vector<uint8_t> png;
+    if (width <= 0 || height <= 0 || !rgba)
+        return png;
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png.insert(png.end(), signature, signature + 8);
+
+    // 8 bit RGBA, deflate, adaptive filtering, no interlace
+    std::vector<uint8_t> header;
+    AppendBigEndian(header, static_cast<uint32_t>(width));
+    AppendBigEndian(header, static_cast<uint32_t>(height));
+    header.insert(header.end(), {8, 6, 0, 0, 0});
+    AppendChunk(png, "IHDR", header);
+
+    // Scanlines: filter type 0 (none) followed by the row
+    size_t rowBytes = static_cast<size_t>(width) * 4;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (int y = 0; y < height; ++y)
+    {
+        raw.push_back(0);
+        const uint8_t *row = rgba + y * rowBytes;
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+
+    // zlib header (deflate, 32K window, no dictionary), stored blocks of at most 65535 bytes, Adler-32
+    const size_t maxBlock = 65535;
+    std::vector<uint8_t> zlib;
+    zlib.reserve(raw.size() + raw.size() / maxBlock * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    size_t offset = 0;
+    do
+    {
+        size_t length = std::min(maxBlock, raw.size() - offset);
+        bool final = offset + length == raw.size();
+        zlib.push_back(final ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(length));
+        zlib.push_back(static_cast<uint8_t>(length >> 8));
+        zlib.push_back(static_cast<uint8_t>(~length));
+        zlib.push_back(static_cast<uint8_t>(~length >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+        offset += length;
+    } while (offset < raw.size());
+    AppendBigEndian(zlib, Adler32(raw.data(), raw.size()));
+
+    AppendChunk(png, "IDAT", zlib);
+    AppendChunk(png, "IEND", {});
+    return png;
+}
+
+bool WritePNG(const std::string &path, int width, int height, const uint8_t *rgba)
+{
+    std::vector<uint8_t> png = EncodePNG(width, height, rgba);
+    if (png.empty())
+        return false;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+    file.write(reinterpret_cast<const char *>(png.data()), static_cast<std::streamsize>(png.size()));
+    return static_cast<bool>(file);
+}
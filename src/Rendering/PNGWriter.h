@@ -0,0 +1,26 @@
+// src/Rendering/PNGWriter.h
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// CRC-32 (ISO 3309) as used by PNG chunks; pass the previous result to continue a running checksum
+uint32_t Crc32(const uint8_t *data, size_t size, uint32_t crc = 0);
+
+// Adler-32 as used by zlib streams; pass the previous result to continue a running checksum
+uint32_t Adler32(const uint8_t *data, size_t size, uint32_t adler = 1);
+
+/**
+ * @brief Encodes RGBA8 pixels (top row first) as a PNG file in memory.
+ *
+ * The zlib stream uses stored (uncompressed) deflate blocks, so no codec is
+ * needed and the output for a given image is byte-for-byte stable, which is
+ * what golden-image comparisons want. Files are about as large as the raw pixels.
+ */
+std::vector<uint8_t> EncodePNG(int width, int height, const uint8_t *rgba);
+
+// EncodePNG to a file; false if the image is empty or the file can't be written
+bool WritePNG(const std::string &path, int width, int height, const uint8_t *rgba);
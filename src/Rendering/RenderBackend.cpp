@@ -0,0 +1,194 @@
+// src/Rendering/RenderBackend.cpp
+
+#include "RenderBackend.h"
+#include "OpenGLBackend.h"
+#include "SoftwareRasterizer.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+#include "Componenets/GameObject.h"
+#include "Componenets/Mesh.h"
+#include "Componenets/Transform.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Profiler.h"
+#include "Rendering/LODSelector.h"
+#include "Rendering/MeshletCulling.h"
+
+RenderBackendType g_RenderBackendType = RenderBackendType::OpenGL;
+RenderFrameStats g_RenderFrameStats;
+
+std::unique_ptr<RenderBackend> RenderBackend::Create(RenderBackendType type)
+{
+    switch (type)
+    {
+    case RenderBackendType::Software:
+        return std::make_unique<SoftwareRasterizer>();
+    case RenderBackendType::OpenGL:
+    default:
+        return std::make_unique<OpenGLBackend>();
+    }
+}
+
+const char *RenderBackend::TypeName(RenderBackendType type)
+{
+    switch (type)
+    {
+    case RenderBackendType::OpenGL:
+        return "OpenGL";
+    case RenderBackendType::Software:
+        return "Software";
+    default:
+        return "Unknown";
+    }
+}
+
+void RenderBackend::RenderScene(const std::vector<std::shared_ptr<GameObject>> &objects, const glm::mat4 &view,
+                                const glm::mat4 &proj)
+{
+    PROFILE_ZONE("RenderScene");
+
+    m_FrameStats = RenderFrameStats();
+    g_LODStats.Reset();
+    g_MeshletStats.Reset();
+
+    if (!BeginFrame())
+    {
+        g_RenderFrameStats = m_FrameStats;
+        return;
+    }
+
+    // World space culling inputs for meshlets
+    Frustum frustum = MeshletCulling::ExtractFrustum(proj * view);
+    glm::vec3 eye = glm::vec3(glm::inverse(view)[3]);
+
+    for (const auto &obj : objects)
+    {
+        std::shared_ptr<TransformComponent> transform = obj->GetComponent<TransformComponent>();
+        std::shared_ptr<MeshComponent> mesh = obj->GetComponent<MeshComponent>();
+        if (!transform || !mesh)
+            continue;
+
+        m_FrameStats.Objects++;
+
+        glm::mat4 model = glm::mat4(1.f);
+        model = glm::translate(model, transform->position);
+        model = glm::rotate(model, glm::radians(transform->rotation.x), glm::vec3(1.f, 0.f, 0.f));
+        model = glm::rotate(model, glm::radians(transform->rotation.y), glm::vec3(0.f, 1.f, 0.f));
+        model = glm::rotate(model, glm::radians(transform->rotation.z), glm::vec3(0.f, 0.f, 1.f));
+        model = glm::scale(model, transform->scale);
+
+        glm::mat4 mvp = proj * view * model;
+
+        // Pick a LOD for the whole object from its projected bounding sphere
+        int lodCount = 1;
+        glm::vec3 boundsMin(0.f), boundsMax(0.f);
+        bool hasBounds = false;
+        for (const auto &submesh : mesh->submeshes)
+        {
+            lodCount = std::max(lodCount, submesh.LODCount());
+            glm::vec3 subMin(submesh.boundsMin[0], submesh.boundsMin[1], submesh.boundsMin[2]);
+            glm::vec3 subMax(submesh.boundsMax[0], submesh.boundsMax[1], submesh.boundsMax[2]);
+            boundsMin = hasBounds ? glm::min(boundsMin, subMin) : subMin;
+            boundsMax = hasBounds ? glm::max(boundsMax, subMax) : subMax;
+            hasBounds = true;
+        }
+
+        glm::vec3 worldCenter = glm::vec3(model * glm::vec4((boundsMin + boundsMax) * 0.5f, 1.f));
+        float maxScale = std::max(std::fabs(transform->scale.x), std::max(std::fabs(transform->scale.y), std::fabs(transform->scale.z)));
+        float worldRadius = glm::length(boundsMax - boundsMin) * 0.5f * maxScale;
+        float screenSize = LODSelector::ProjectedScreenSize(worldCenter, worldRadius, view, proj);
+
+        mesh->CurrentLOD = LODSelector::SelectLOD(screenSize, mesh->CurrentLOD, lodCount, g_LODSettings);
+        g_LODStats.ObjectsPerLOD[std::min(mesh->CurrentLOD, MAX_MESH_LODS - 1)]++;
+
+        for (const auto &submesh : mesh->submeshes)
+        {
+            if (!CanDraw(submesh))
+            {
+                m_FrameStats.SkippedSubmeshes++;
+                continue;
+            }
+
+            SubmeshLOD lod = submesh.GetLOD(mesh->CurrentLOD);
+            g_LODStats.TrianglesDrawn += static_cast<int>(lod.indexCount / 3);
+            g_LODStats.TrianglesFullDetail += static_cast<int>(submesh.indexCount / 3);
+
+            SubmeshDraw draw;
+            draw.submesh = &submesh;
+            draw.meshPath = &mesh->MeshPath;
+            draw.model = model;
+            draw.mvp = mvp;
+            draw.ranges = &m_Ranges;
+            draw.meshletCulled = mesh->CurrentLOD == 0 && !submesh.meshlets.empty() && g_MeshletCullingSettings.Enabled;
+
+            m_Ranges.clear();
+            if (draw.meshletCulled)
+                CullMeshlets(submesh, model, transform->scale, frustum, eye);
+            else
+                m_Ranges.push_back({lod.indexOffset, static_cast<size_t>(lod.indexCount)});
+
+            m_FrameStats.Submeshes++;
+            m_FrameStats.DrawRanges += static_cast<int>(m_Ranges.size());
+            for (const IndexRange &range : m_Ranges)
+                m_FrameStats.Triangles += static_cast<int>(range.count / 3);
+
+            DrawSubmesh(draw);
+        }
+    }
+
+    EndFrame();
+    g_RenderFrameStats = m_FrameStats;
+}
+
+void RenderBackend::CullMeshlets(const Submesh &submesh, const glm::mat4 &model, const glm::vec3 &scale,
+                                 const Frustum &frustum, const glm::vec3 &eye)
+{
+    PROFILE_ZONE("CullMeshlets");
+
+    // Cone culling needs winding preserved and normals transformed by a rotation + uniform scale
+    float maxScale = std::max(std::fabs(scale.x), std::max(std::fabs(scale.y), std::fabs(scale.z)));
+    float minScale = std::min(scale.x, std::min(scale.y, scale.z));
+    bool uniformScale = minScale > 0.0f && (maxScale - minScale) <= 1e-4f * maxScale;
+    bool coneCulling = g_MeshletCullingSettings.ConeCulling && uniformScale &&
+                       (submesh.closed || g_MeshletCullingSettings.ConeCullOpenMeshes);
+
+    IndexRange range;
+    bool rangeOpen = false;
+
+    for (const Meshlet &meshlet : submesh.meshlets)
+    {
+        g_MeshletStats.Meshlets++;
+
+        MeshletVisibility visibility = MeshletCulling::Classify(meshlet, model, maxScale, frustum, eye,
+                                                                g_MeshletCullingSettings.FrustumCulling, coneCulling);
+        if (visibility == MeshletVisibility::FrustumCulled)
+            g_MeshletStats.FrustumCulled++;
+        else if (visibility == MeshletVisibility::ConeCulled)
+            g_MeshletStats.ConeCulled++;
+
+        if (visibility != MeshletVisibility::Visible)
+        {
+            g_MeshletStats.TrianglesCulled += static_cast<int>(meshlet.indexCount / 3);
+            continue;
+        }
+        g_MeshletStats.Drawn++;
+
+        // Meshlets are contiguous in the index buffer: merge neighbours into one range
+        if (rangeOpen && meshlet.indexOffset == range.offset + range.count)
+        {
+            range.count += meshlet.indexCount;
+            continue;
+        }
+        if (rangeOpen)
+            m_Ranges.push_back(range);
+        range.offset = meshlet.indexOffset;
+        range.count = meshlet.indexCount;
+        rangeOpen = true;
+    }
+    if (rangeOpen)
+        m_Ranges.push_back(range);
+
+    g_MeshletStats.DrawRanges += static_cast<int>(m_Ranges.size());
+}
@@ -0,0 +1,119 @@
+// src/Rendering/RenderBackend.h
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Submesh;
+struct Frustum;
+class GameObject;
+
+enum class RenderBackendType
+{
+    OpenGL,   // Draws into an FBO on the GPU
+    Software, // Tile-based CPU rasterizer, no GL context needed
+};
+
+// A contiguous range of a submesh's index buffer, in indices (LODs follow LOD 0 back to back)
+struct IndexRange
+{
+    size_t offset = 0;
+    size_t count = 0;
+};
+
+// One submesh draw after LOD selection and meshlet culling
+struct SubmeshDraw
+{
+    const Submesh *submesh = nullptr;
+    const std::string *meshPath = nullptr; // Model the submesh came from; texture paths are relative to it
+    glm::mat4 model = glm::mat4(1.0f);
+    glm::mat4 mvp = glm::mat4(1.0f);
+    const std::vector<IndexRange> *ranges = nullptr;
+    bool meshletCulled = false; // Ranges are surviving meshlets rather than one LOD
+};
+
+// Counters for the last rendered frame
+struct RenderFrameStats
+{
+    int Objects = 0;
+    int Submeshes = 0;
+    int SkippedSubmeshes = 0; // Missing the data this backend draws from (VAO or CPU copy)
+    int DrawRanges = 0;
+    int Triangles = 0;        // Submitted after LOD selection and meshlet culling
+};
+
+// Backend the editor viewport renders with; RenderWindow switches when this changes
+extern RenderBackendType g_RenderBackendType;
+
+// Counters of the last RenderScene call
+extern RenderFrameStats g_RenderFrameStats;
+
+/**
+ * @brief Interface between the scene traversal and the API that draws it.
+ *
+ * RenderScene does the backend independent work (model matrices, LOD
+ * selection, meshlet culling, stats) and hands every surviving submesh to
+ * DrawSubmesh between BeginFrame and EndFrame. Backends produce either a GL
+ * texture or an RGBA8 pixel buffer with the finished frame.
+ */
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    static std::unique_ptr<RenderBackend> Create(RenderBackendType type);
+    static const char *TypeName(RenderBackendType type);
+
+    virtual RenderBackendType GetType() const = 0;
+
+    // One-time setup; false if the backend can't render (e.g. a shader failed to load)
+    virtual bool Init() = 0;
+
+    // Reallocates the render target; called whenever the viewport size changes
+    virtual void Resize(int width, int height) = 0;
+
+    /**
+     * @brief Draws every object with a transform and a mesh.
+     *
+     * Resets g_LODStats and g_MeshletStats, which are filled in along the way,
+     * and publishes the frame's counters to g_RenderFrameStats.
+     */
+    void RenderScene(const std::vector<std::shared_ptr<GameObject>> &objects, const glm::mat4 &view,
+                     const glm::mat4 &proj);
+
+    // GL texture with the last frame, 0 if the backend renders to CPU memory
+    virtual unsigned int GetTextureID() const { return 0; }
+
+    // RGBA8 pixels of the last frame, top row first; nullptr if the frame only lives on the GPU
+    virtual const uint8_t *GetPixels() const { return nullptr; }
+
+    int GetWidth() const { return m_Width; }
+    int GetHeight() const { return m_Height; }
+    const RenderFrameStats &GetFrameStats() const { return m_FrameStats; }
+
+protected:
+    // False stops the frame; the backend has already undone anything it bound
+    virtual bool BeginFrame() = 0;
+    virtual void DrawSubmesh(const SubmeshDraw &draw) = 0;
+    virtual void EndFrame() = 0;
+
+    // Whether the submesh holds the data this backend draws from
+    virtual bool CanDraw(const Submesh &submesh) const = 0;
+
+    int m_Width = 0;
+    int m_Height = 0;
+    RenderFrameStats m_FrameStats;
+
+private:
+    // Tests the submesh's meshlets and merges the visible ones into contiguous ranges
+    void CullMeshlets(const Submesh &submesh, const glm::mat4 &model, const glm::vec3 &scale,
+                      const Frustum &frustum, const glm::vec3 &eye);
+
+    // Scratch for the current submesh, reused across frames
+    std::vector<IndexRange> m_Ranges;
+};
@@ -0,0 +1,533 @@
+// src/Rendering/SoftwareRasterizer.cpp
+
+#include "SoftwareRasterizer.h"
+#include "PNGWriter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "stb/stb_image.h"
+
+#include "gcml.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/JobSystem.h"
+#include "Engine/MemoryTracker.h"
+#include "Engine/Profiler.h"
+
+// The GL path never sets lightPos, so UnlitMaterial.frag lights every fragment from the origin
+static const glm::vec3 UnlitLightPosition(0.0f);
+
+// Must match the shader's MAX_DIFFUSE
+static const size_t MaxDiffuseTextures = 32;
+
+// Triangles reaching past this many viewport half-extents are clipped, which bounds the fixed point edge values
+static const float GuardBand = 16.0f;
+
+// Sub-pixel precision of the edge functions
+static const int64_t SubpixelScale = 256;
+
+// Vertices transformed per job
+static const size_t VertexBatchSize = 4096;
+
+static int64_t ToFixed(float value)
+{
+    return static_cast<int64_t>(std::llround(value * static_cast<float>(SubpixelScale)));
+}
+
+// Index data behind a range; LOD ranges continue past the full resolution indices
+static const unsigned int *ResolveIndices(const Submesh &submesh, const IndexRange &range)
+{
+    size_t offset = range.offset;
+    if (offset < submesh.indices.size())
+        return offset + range.count <= submesh.indices.size() ? submesh.indices.data() + offset : nullptr;
+
+    offset -= submesh.indices.size();
+    for (const std::vector<unsigned int> &lod : submesh.lodIndices)
+    {
+        if (offset < lod.size())
+            return offset + range.count <= lod.size() ? lod.data() + offset : nullptr;
+        offset -= lod.size();
+    }
+    return nullptr;
+}
+
+void SoftwareRasterizer::Resize(int width, int height)
+{
+    m_Width = std::max(width, 0);
+    m_Height = std::max(height, 0);
+    m_Color.assign(static_cast<size_t>(m_Width) * m_Height * 4, 0);
+    m_Depth.assign(static_cast<size_t>(m_Width) * m_Height, 1.0f);
+
+    m_TilesX = (m_Width + TileSize - 1) / TileSize;
+    m_TilesY = (m_Height + TileSize - 1) / TileSize;
+    m_TileBins.assign(static_cast<size_t>(m_TilesX) * m_TilesY, std::vector<uint32_t>());
+}
+
+bool SoftwareRasterizer::SavePNG(const std::string &path) const
+{
+    return WritePNG(path, m_Width, m_Height, GetPixels());
+}
+
+bool SoftwareRasterizer::BeginFrame()
+{
+    if (m_Width <= 0 || m_Height <= 0)
+        return false;
+
+    m_Vertices.clear();
+    m_Triangles.clear();
+    m_Materials.clear();
+    for (std::vector<uint32_t> &bin : m_TileBins)
+        bin.clear();
+    return true;
+}
+
+bool SoftwareRasterizer::CanDraw(const Submesh &submesh) const
+{
+    return !submesh.vertices.empty() && !submesh.indices.empty();
+}
+
+const SoftwareRasterizer::CPUTexture *SoftwareRasterizer::LoadTexture(const std::string &path)
+{
+    auto it = m_Textures.find(path);
+    if (it != m_Textures.end())
+        return it->second.get();
+
+    MemoryTagScope memoryTag(MemoryTag::Textures);
+    std::unique_ptr<CPUTexture> texture = std::make_unique<CPUTexture>();
+
+    int width, height, channels;
+    unsigned char *data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+    if (data)
+    {
+        // Same channel expansion as the GL upload: one channel lands in red
+        texture->width = width;
+        texture->height = height;
+        texture->pixels.resize(static_cast<size_t>(width) * height * 4);
+        for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+        {
+            const unsigned char *src = data + i * channels;
+            uint8_t *dst = texture->pixels.data() + i * 4;
+            dst[0] = src[0];
+            dst[1] = channels >= 2 ? src[1] : 0;
+            dst[2] = channels >= 3 ? src[2] : 0;
+            dst[3] = channels == 4 ? src[3] : 255;
+        }
+        stbi_image_free(data);
+    }
+    else
+    {
+        DEBUG_PRINT("[SoftwareRasterizer] failed to load texture: %s: %s", path.c_str(), stbi_failure_reason());
+    }
+
+    const CPUTexture *result = texture.get();
+    m_Textures.emplace(path, std::move(texture));
+    return result;
+}
+
+void SoftwareRasterizer::DrawSubmesh(const SubmeshDraw &draw)
+{
+    PROFILE_ZONE("SoftwareDrawSubmesh");
+
+    const Submesh &submesh = *draw.submesh;
+
+    // Texture paths in a model are relative to the model file
+    std::string directory;
+    if (draw.meshPath)
+    {
+        size_t slash = draw.meshPath->find_last_of("/\\");
+        if (slash != std::string::npos)
+            directory = draw.meshPath->substr(0, slash + 1);
+    }
+
+    RasterMaterial material;
+    for (const auto &texture : submesh.textures)
+    {
+        if (texture.type == "texture_diffuse" && material.diffuse.size() < MaxDiffuseTextures)
+            material.diffuse.push_back(LoadTexture(directory + texture.path));
+    }
+    uint32_t materialIndex = static_cast<uint32_t>(m_Materials.size());
+    m_Materials.push_back(std::move(material));
+
+    // Vertex stage: clip space for clipping, screen space for triangles that don't need it
+    const std::vector<Vertex> &vertices = submesh.vertices;
+    size_t vertexCount = vertices.size();
+    size_t base = m_Vertices.size();
+    m_ClipVertices.resize(vertexCount);
+    m_Vertices.resize(base + vertexCount);
+
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(draw.model)));
+    size_t batches = (vertexCount + VertexBatchSize - 1) / VertexBatchSize;
+    JobSystem::Get().ParallelFor(batches, [&](size_t batch)
+                                 {
+        size_t end = std::min(vertexCount, (batch + 1) * VertexBatchSize);
+        for (size_t i = batch * VertexBatchSize; i < end; ++i)
+        {
+            const Vertex &v = vertices[i];
+            glm::vec4 position(v.position[0], v.position[1], v.position[2], 1.0f);
+
+            ClipVertex &clip = m_ClipVertices[i];
+            clip.clip = draw.mvp * position;
+            clip.uv = glm::vec2(v.texCoord[0], v.texCoord[1]);
+            clip.normal = normalMatrix * glm::vec3(v.normal[0], v.normal[1], v.normal[2]);
+            clip.worldPos = glm::vec3(draw.model * position);
+
+            // Only read for triangles entirely in front of the near plane
+            m_Vertices[base + i] = Project(clip);
+        } });
+
+    // Primitive stage: clipping and binning in submission order
+    for (const IndexRange &range : *draw.ranges)
+    {
+        const unsigned int *indices = ResolveIndices(submesh, range);
+        if (!indices)
+            continue;
+
+        for (size_t t = 0; t + 2 < range.count; t += 3)
+        {
+            unsigned int i0 = indices[t], i1 = indices[t + 1], i2 = indices[t + 2];
+            if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+                continue;
+            ClipAndEmit(m_ClipVertices[i0], m_ClipVertices[i1], m_ClipVertices[i2], static_cast<uint32_t>(base + i0),
+                        static_cast<uint32_t>(base + i1), static_cast<uint32_t>(base + i2), materialIndex);
+        }
+    }
+}
+
+static int OutCode(const glm::vec4 &c)
+{
+    int code = 0;
+    if (c.x < -c.w)
+        code |= 1;
+    if (c.x > c.w)
+        code |= 2;
+    if (c.y < -c.w)
+        code |= 4;
+    if (c.y > c.w)
+        code |= 8;
+    if (c.z < -c.w)
+        code |= 16;
+    if (c.z > c.w)
+        code |= 32;
+    return code;
+}
+
+// Behind the near plane or outside the guard band
+static bool NeedsClipping(const glm::vec4 &c)
+{
+    return c.w <= 0.0f || c.z < -c.w || std::fabs(c.x) > GuardBand * c.w || std::fabs(c.y) > GuardBand * c.w;
+}
+
+// Signed distance to a clip plane: the near plane, then the four guard band planes
+static float PlaneDistance(const glm::vec4 &c, int plane)
+{
+    switch (plane)
+    {
+    case 0:
+        return c.z + c.w;
+    case 1:
+        return GuardBand * c.w + c.x;
+    case 2:
+        return GuardBand * c.w - c.x;
+    case 3:
+        return GuardBand * c.w + c.y;
+    default:
+        return GuardBand * c.w - c.y;
+    }
+}
+
+void SoftwareRasterizer::ClipAndEmit(const ClipVertex &a, const ClipVertex &b, const ClipVertex &c, uint32_t ia,
+                                     uint32_t ib, uint32_t ic, uint32_t material)
+{
+    // Entirely outside one frustum plane
+    if (OutCode(a.clip) & OutCode(b.clip) & OutCode(c.clip))
+        return;
+
+    if (!NeedsClipping(a.clip) && !NeedsClipping(b.clip) && !NeedsClipping(c.clip))
+    {
+        EmitTriangle(ia, ib, ic, material);
+        return;
+    }
+
+    // Sutherland-Hodgman; every plane adds at most one vertex
+    const int planeCount = 5;
+    ClipVertex polygons[2][3 + planeCount];
+    polygons[0][0] = a;
+    polygons[0][1] = b;
+    polygons[0][2] = c;
+    int count = 3;
+    int current = 0;
+
+    for (int plane = 0; plane < planeCount; ++plane)
+    {
+        const ClipVertex *in = polygons[current];
+        ClipVertex *out = polygons[current ^ 1];
+        int outCount = 0;
+
+        for (int i = 0; i < count; ++i)
+        {
+            const ClipVertex &from = in[i];
+            const ClipVertex &to = in[(i + 1) % count];
+            float fromDistance = PlaneDistance(from.clip, plane);
+            float toDistance = PlaneDistance(to.clip, plane);
+
+            if (fromDistance >= 0.0f)
+                out[outCount++] = from;
+            if ((fromDistance >= 0.0f) != (toDistance >= 0.0f))
+            {
+                float t = fromDistance / (fromDistance - toDistance);
+                ClipVertex &split = out[outCount++];
+                split.clip = glm::mix(from.clip, to.clip, t);
+                split.uv = glm::mix(from.uv, to.uv, t);
+                split.normal = glm::mix(from.normal, to.normal, t);
+                split.worldPos = glm::mix(from.worldPos, to.worldPos, t);
+            }
+        }
+
+        count = outCount;
+        current ^= 1;
+        if (count < 3)
+            return;
+    }
+
+    uint32_t first = AddVertex(polygons[current][0]);
+    uint32_t previous = AddVertex(polygons[current][1]);
+    for (int i = 2; i < count; ++i)
+    {
+        uint32_t next = AddVertex(polygons[current][i]);
+        EmitTriangle(first, previous, next, material);
+        previous = next;
+    }
+}
+
+SoftwareRasterizer::RasterVertex SoftwareRasterizer::Project(const ClipVertex &vertex) const
+{
+    float invW = vertex.clip.w > 0.0f ? 1.0f / vertex.clip.w : 0.0f;
+
+    RasterVertex raster;
+    raster.x = (vertex.clip.x * invW + 1.0f) * m_Width * 0.5f;
+    raster.y = (1.0f - vertex.clip.y * invW) * m_Height * 0.5f;
+    raster.z = vertex.clip.z * invW * 0.5f + 0.5f;
+    raster.invW = invW;
+    raster.uv = vertex.uv * invW;
+    raster.normal = vertex.normal * invW;
+    raster.worldPos = vertex.worldPos * invW;
+    return raster;
+}
+
+uint32_t SoftwareRasterizer::AddVertex(const ClipVertex &vertex)
+{
+    m_Vertices.push_back(Project(vertex));
+    return static_cast<uint32_t>(m_Vertices.size() - 1);
+}
+
+void SoftwareRasterizer::EmitTriangle(uint32_t a, uint32_t b, uint32_t c, uint32_t material)
+{
+    const RasterVertex &va = m_Vertices[a];
+    const RasterVertex &vb = m_Vertices[b];
+    const RasterVertex &vc = m_Vertices[c];
+
+    // Orientation from the same fixed point coordinates the tiles rasterize with; no face culling
+    int64_t ax = ToFixed(va.x), ay = ToFixed(va.y);
+    int64_t area = (ToFixed(vb.x) - ax) * (ToFixed(vc.y) - ay) - (ToFixed(vb.y) - ay) * (ToFixed(vc.x) - ax);
+    if (area == 0)
+        return;
+    if (area < 0)
+        std::swap(b, c);
+
+    // Pixels whose centers can be covered
+    float minX = std::min(va.x, std::min(vb.x, vc.x));
+    float maxX = std::max(va.x, std::max(vb.x, vc.x));
+    float minY = std::min(va.y, std::min(vb.y, vc.y));
+    float maxY = std::max(va.y, std::max(vb.y, vc.y));
+
+    RasterTriangle triangle;
+    triangle.v[0] = a;
+    triangle.v[1] = b;
+    triangle.v[2] = c;
+    triangle.material = material;
+    triangle.minX = std::max(0, static_cast<int>(std::ceil(minX - 0.5f)));
+    triangle.maxX = std::min(m_Width - 1, static_cast<int>(std::floor(maxX - 0.5f)));
+    triangle.minY = std::max(0, static_cast<int>(std::ceil(minY - 0.5f)));
+    triangle.maxY = std::min(m_Height - 1, static_cast<int>(std::floor(maxY - 0.5f)));
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+        return;
+
+    uint32_t index = static_cast<uint32_t>(m_Triangles.size());
+    m_Triangles.push_back(triangle);
+
+    for (int ty = triangle.minY / TileSize; ty <= triangle.maxY / TileSize; ++ty)
+    {
+        for (int tx = triangle.minX / TileSize; tx <= triangle.maxX / TileSize; ++tx)
+            m_TileBins[static_cast<size_t>(ty) * m_TilesX + tx].push_back(index);
+    }
+}
+
+void SoftwareRasterizer::EndFrame()
+{
+    PROFILE_ZONE("SoftwareRasterize");
+
+    JobSystem::Get().ParallelFor(m_TileBins.size(), [this](size_t tile)
+                                 { RasterizeTile(tile); });
+}
+
+// Bilinear, repeat wrapping, base level only
+static glm::vec4 SampleTexture(const uint8_t *pixels, int width, int height, glm::vec2 uv)
+{
+    float u = std::isfinite(uv.x) ? uv.x - std::floor(uv.x) : 0.0f;
+    float v = std::isfinite(uv.y) ? uv.y - std::floor(uv.y) : 0.0f;
+
+    float x = u * width - 0.5f;
+    float y = v * height - 0.5f;
+    float fx = std::floor(x);
+    float fy = std::floor(y);
+    float tx = x - fx;
+    float ty = y - fy;
+
+    int x0 = (static_cast<int>(fx) + width) % width;
+    int y0 = (static_cast<int>(fy) + height) % height;
+    int x1 = (x0 + 1) % width;
+    int y1 = (y0 + 1) % height;
+
+    auto texel = [&](int px, int py)
+    {
+        const uint8_t *p = pixels + (static_cast<size_t>(py) * width + px) * 4;
+        return glm::vec4(p[0], p[1], p[2], p[3]);
+    };
+
+    glm::vec4 top = glm::mix(texel(x0, y0), texel(x1, y0), tx);
+    glm::vec4 bottom = glm::mix(texel(x0, y1), texel(x1, y1), tx);
+    return glm::mix(top, bottom, ty) * (1.0f / 255.0f);
+}
+
+// One edge of a triangle as an integer edge function over pixel centers
+struct EdgeFunction
+{
+    int64_t stepX;
+    int64_t stepY;
+    int64_t row;
+    int64_t threshold; // 0 for top-left edges, so shared edges are covered exactly once
+
+    EdgeFunction(int64_t ax, int64_t ay, int64_t bx, int64_t by, int64_t px, int64_t py)
+    {
+        int64_t dx = bx - ax;
+        int64_t dy = by - ay;
+        stepX = -dy * SubpixelScale;
+        stepY = dx * SubpixelScale;
+        row = dx * (py - ay) - dy * (px - ax);
+        threshold = (dy < 0 || (dy == 0 && dx > 0)) ? 0 : 1;
+    }
+};
+
+void SoftwareRasterizer::RasterizeTile(size_t tile)
+{
+    int tileX0 = static_cast<int>(tile % m_TilesX) * TileSize;
+    int tileY0 = static_cast<int>(tile / m_TilesX) * TileSize;
+    int tileX1 = std::min(tileX0 + TileSize, m_Width) - 1;
+    int tileY1 = std::min(tileY0 + TileSize, m_Height) - 1;
+
+    // Clear to the GL path's glClearColor(0, 0, 0, 1) and depth 1
+    for (int y = tileY0; y <= tileY1; ++y)
+    {
+        size_t pixel = static_cast<size_t>(y) * m_Width + tileX0;
+        std::fill(m_Depth.begin() + pixel, m_Depth.begin() + pixel + (tileX1 - tileX0 + 1), 1.0f);
+        for (int x = tileX0; x <= tileX1; ++x, ++pixel)
+        {
+            uint8_t *color = &m_Color[pixel * 4];
+            color[0] = 0;
+            color[1] = 0;
+            color[2] = 0;
+            color[3] = 255;
+        }
+    }
+
+    for (uint32_t triangleIndex : m_TileBins[tile])
+    {
+        const RasterTriangle &triangle = m_Triangles[triangleIndex];
+        int minX = std::max(triangle.minX, tileX0);
+        int maxX = std::min(triangle.maxX, tileX1);
+        int minY = std::max(triangle.minY, tileY0);
+        int maxY = std::min(triangle.maxY, tileY1);
+        if (minX > maxX || minY > maxY)
+            continue;
+
+        const RasterVertex &v0 = m_Vertices[triangle.v[0]];
+        const RasterVertex &v1 = m_Vertices[triangle.v[1]];
+        const RasterVertex &v2 = m_Vertices[triangle.v[2]];
+        int64_t x0 = ToFixed(v0.x), y0 = ToFixed(v0.y);
+        int64_t x1 = ToFixed(v1.x), y1 = ToFixed(v1.y);
+        int64_t x2 = ToFixed(v2.x), y2 = ToFixed(v2.y);
+
+        int64_t area = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+        if (area <= 0)
+            continue;
+        double invArea = 1.0 / static_cast<double>(area);
+
+        // Edge opposite each vertex, so its value is that vertex's barycentric weight times the area
+        int64_t startX = minX * SubpixelScale + SubpixelScale / 2;
+        int64_t startY = minY * SubpixelScale + SubpixelScale / 2;
+        EdgeFunction e0(x1, y1, x2, y2, startX, startY);
+        EdgeFunction e1(x2, y2, x0, y0, startX, startY);
+        EdgeFunction e2(x0, y0, x1, y1, startX, startY);
+
+        const RasterMaterial &material = m_Materials[triangle.material];
+
+        for (int y = minY; y <= maxY; ++y)
+        {
+            int64_t w0 = e0.row;
+            int64_t w1 = e1.row;
+            int64_t w2 = e2.row;
+            size_t pixel = static_cast<size_t>(y) * m_Width + minX;
+
+            for (int x = minX; x <= maxX; ++x, ++pixel, w0 += e0.stepX, w1 += e1.stepX, w2 += e2.stepX)
+            {
+                if (w0 < e0.threshold || w1 < e1.threshold || w2 < e2.threshold)
+                    continue;
+
+                float l0 = static_cast<float>(w0 * invArea);
+                float l1 = static_cast<float>(w1 * invArea);
+                float l2 = static_cast<float>(w2 * invArea);
+
+                // Depth test GL_LESS, fragments past the far plane are clipped
+                float z = l0 * v0.z + l1 * v1.z + l2 * v2.z;
+                if (z < 0.0f || z > 1.0f || !(z < m_Depth[pixel]))
+                    continue;
+
+                // Perspective correct attributes
+                float w = 1.0f / (l0 * v0.invW + l1 * v1.invW + l2 * v2.invW);
+                glm::vec2 uv = (l0 * v0.uv + l1 * v1.uv + l2 * v2.uv) * w;
+                glm::vec3 normal = (l0 * v0.normal + l1 * v1.normal + l2 * v2.normal) * w;
+                glm::vec3 worldPos = (l0 * v0.worldPos + l1 * v1.worldPos + l2 * v2.worldPos) * w;
+
+                // UnlitMaterial.frag: summed diffuse textures, Lambert term towards lightPos, 10% ambient of the lit color
+                glm::vec4 diffuseColor(0.0f);
+                for (const CPUTexture *texture : material.diffuse)
+                {
+                    if (texture && !texture->pixels.empty())
+                        diffuseColor += SampleTexture(texture->pixels.data(), texture->width, texture->height, uv);
+                    else
+                        diffuseColor += glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+                }
+
+                glm::vec3 toLight = UnlitLightPosition - worldPos;
+                float normalLength = glm::length(normal);
+                float lightLength = glm::length(toLight);
+                float diff = 0.0f;
+                if (normalLength > 0.0f && lightLength > 0.0f)
+                    diff = std::max(glm::dot(normal / normalLength, toLight / lightLength), 0.0f);
+                diffuseColor *= diff;
+
+                glm::vec4 fragColor(glm::vec3(diffuseColor) * 1.1f, diffuseColor.w);
+
+                m_Depth[pixel] = z;
+                uint8_t *color = &m_Color[pixel * 4];
+                for (int channel = 0; channel < 4; ++channel)
+                    color[channel] = static_cast<uint8_t>(std::clamp(fragColor[channel], 0.0f, 1.0f) * 255.0f + 0.5f);
+            }
+
+            e0.row += e0.stepY;
+            e1.row += e1.stepY;
+            e2.row += e2.stepY;
+        }
+    }
+}
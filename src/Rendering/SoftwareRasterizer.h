@@ -0,0 +1,128 @@
+// src/Rendering/SoftwareRasterizer.h
+
+#pragma once
+
+#include "RenderBackend.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief CPU rasterizer implementing the UnlitMaterial shading model.
+ *
+ * Draws from the submeshes' CPU-side vertex/index copies, so it runs
+ * without a GL context (headless, CI machines without GPUs) but needs mesh
+ * data retained after upload when used next to the GL renderer.
+ *
+ * DrawSubmesh transforms vertices in parallel, clips triangles against the
+ * near plane and a guard band, and bins them into fixed size screen tiles in
+ * submission order. EndFrame rasterizes the tiles in parallel on the
+ * JobSystem; each tile is owned by one job, so no pixel is shared between
+ * threads and the output doesn't depend on the worker count.
+ *
+ * Matches the GL path's state: depth test GL_LESS, no face culling, no
+ * blending. Textures are sampled bilinearly from the base level with
+ * repeat wrapping (the GL path uses trilinear mipmapping, so minified
+ * textures differ slightly).
+ */
+class SoftwareRasterizer : public RenderBackend
+{
+public:
+    static const int TileSize = 64;
+
+    RenderBackendType GetType() const override { return RenderBackendType::Software; }
+
+    bool Init() override { return true; }
+    void Resize(int width, int height) override;
+
+    const uint8_t *GetPixels() const override { return m_Color.empty() ? nullptr : m_Color.data(); }
+
+    // Writes the last frame as a PNG; false if nothing was rendered or the file can't be written
+    bool SavePNG(const std::string &path) const;
+
+    // Triangles binned last frame, after clipping
+    size_t GetRasterizedTriangleCount() const { return m_Triangles.size(); }
+
+    // Decoded textures kept across frames
+    void ClearTextureCache() { m_Textures.clear(); }
+
+protected:
+    bool BeginFrame() override;
+    void DrawSubmesh(const SubmeshDraw &draw) override;
+    void EndFrame() override;
+    bool CanDraw(const Submesh &submesh) const override;
+
+private:
+    // RGBA8 image with the GL upload's channel expansion applied
+    struct CPUTexture
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> pixels;
+    };
+
+    // Post-transform vertex before clipping
+    struct ClipVertex
+    {
+        glm::vec4 clip;
+        glm::vec2 uv;
+        glm::vec3 normal;
+        glm::vec3 worldPos;
+    };
+
+    // Screen space vertex; attributes are pre-divided by w for perspective correct interpolation
+    struct RasterVertex
+    {
+        float x, y, z, invW;
+        glm::vec2 uv;
+        glm::vec3 normal;
+        glm::vec3 worldPos;
+    };
+
+    struct RasterTriangle
+    {
+        uint32_t v[3]; // Into m_Vertices, ordered so the screen space area is positive
+        uint32_t material;
+        int minX, minY, maxX, maxY; // Pixel bounds, clamped to the viewport
+    };
+
+    // Diffuse textures of one draw, summed like uTextures.texture_diffuse[]
+    struct RasterMaterial
+    {
+        std::vector<const CPUTexture *> diffuse;
+    };
+
+    // Decodes on first use; failed loads are cached as empty and sample black like an incomplete GL texture
+    const CPUTexture *LoadTexture(const std::string &path);
+
+    // Perspective divide and viewport transform
+    RasterVertex Project(const ClipVertex &vertex) const;
+    uint32_t AddVertex(const ClipVertex &vertex);
+
+    // Rejects, clips or passes through one triangle; ia/ib/ic are its projected vertices if no clipping is needed
+    void ClipAndEmit(const ClipVertex &a, const ClipVertex &b, const ClipVertex &c, uint32_t ia, uint32_t ib,
+                     uint32_t ic, uint32_t material);
+
+    // Bounds and bins a projected triangle
+    void EmitTriangle(uint32_t a, uint32_t b, uint32_t c, uint32_t material);
+
+    void RasterizeTile(size_t tile);
+
+    std::vector<uint8_t> m_Color; // RGBA8, top row first
+    std::vector<float> m_Depth;
+    int m_TilesX = 0;
+    int m_TilesY = 0;
+
+    // Per-frame geometry
+    std::vector<RasterVertex> m_Vertices;
+    std::vector<RasterTriangle> m_Triangles;
+    std::vector<RasterMaterial> m_Materials;
+    std::vector<std::vector<uint32_t>> m_TileBins; // Triangle indices per tile, in submission order
+
+    // Per-draw scratch
+    std::vector<ClipVertex> m_ClipVertices;
+
+    std::unordered_map<std::string, std::unique_ptr<CPUTexture>> m_Textures;
+};
@@ -7,17 +7,21 @@
 #include <vector>
 
 #include "Icons.h"
+#include "Engine/SceneIndex.h"
+#include "Engine/Profiler.h"
 
-extern std::vector<GameObject> g_GameObjects;
+extern std::vector<std::shared_ptr<GameObject>> g_GameObjects;
 extern GameObject *g_SelectedObject; // Pointer to the currently selected object
 extern std::shared_ptr<CameraComponent> g_RuntimeCameraObject;
 
 #include "Engine/AssetManager.h"
-extern AssetManager *g_AssetManager;
+extern AssetManager g_AssetManager;
 extern LoggerWindow *g_LoggerWindow;
 
 void InspectorWindow::Show()
 {
+    PROFILE_ZONE("InspectorWindow");
+
     // Increase window/item spacing for a cleaner look
     ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(12, 12));
     ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(6, 4));
@@ -48,7 +52,7 @@ void InspectorWindow::Show()
             ImGui::SetColumnWidth(0, 100.0f);            // Optional: Set fixed width for the first column
 
             // Label in the first column
-            ImGui::Text("Tag:");
+            ImGui::Text("Name:");
             ImGui::NextColumn(); // Move to the second column
 
             // Define buffer size
@@ -60,17 +64,48 @@ void InspectorWindow::Show()
             buffer[BUFFER_SIZE - 1] = '\0'; // Ensure null-termination
 
             // Unique identifier for the InputText to prevent ImGui state conflicts
-            const char *inputLabel = "##TagInput";
+            const char *inputLabel = "##NameInput";
 
             // Render InputText widget
             if (ImGui::InputText(inputLabel, buffer, BUFFER_SIZE))
             {
-                // Update the GameObject's name if modified
-                g_SelectedObject->name = buffer;
+                // Update the GameObject's name (and the lookup index) if modified
+                g_SceneIndex.Rename(g_SelectedObject, buffer);
             }
 
             ImGui::NextColumn(); // Move back to the first column (if adding more fields)
 
+            ImGui::Text("Tags:");
+            ImGui::NextColumn();
+
+            // Existing tags; clicking one removes it
+            std::string removedTag;
+            for (size_t i = 0; i < g_SelectedObject->tags.size(); ++i)
+            {
+                const std::string &tag = g_SelectedObject->tags[i];
+                if (i > 0)
+                    ImGui::SameLine();
+                if (ImGui::SmallButton((tag + " x##Tag" + std::to_string(i)).c_str()))
+                    removedTag = tag;
+            }
+            if (!removedTag.empty())
+                g_SceneIndex.RemoveTag(g_SelectedObject, removedTag);
+
+            static char newTag[64] = "";
+            if (ImGui::InputText("##NewTagInput", newTag, sizeof(newTag), ImGuiInputTextFlags_EnterReturnsTrue))
+            {
+                g_SceneIndex.AddTag(g_SelectedObject, newTag);
+                newTag[0] = '\0';
+            }
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Add Tag"))
+            {
+                g_SceneIndex.AddTag(g_SelectedObject, newTag);
+                newTag[0] = '\0';
+            }
+
+            ImGui::NextColumn();
+
             // End columns
             ImGui::Columns(1);
 
@@ -423,10 +458,26 @@ void InspectorWindow::Show()
 
                     if (ImGui::InputText("Mesh Path", buffer, BUFFER_SIZE))
                     {
+                        // The retention request follows the mesh to its new path
+                        if (mesh->RetainCPUData)
+                        {
+                            g_AssetManager.RetainCPUMeshData(mesh->MeshPath, false);
+                            g_AssetManager.RetainCPUMeshData(buffer, true);
+                        }
                         mesh->MeshPath = buffer;
                         // Optionally, trigger reloading the mesh if the path changes
                         // Example:
-                        std::shared_ptr<Model> model = g_AssetManager->loadAsset<Model>(AssetType::MODEL, mesh->MeshPath.c_str());
+                        std::shared_ptr<Model> model = g_AssetManager.loadAsset<Model>(AssetType::MODEL, mesh->MeshPath.c_str());
+                    }
+
+                    // --- CPU Data Retention ---
+                    if (ImGui::Checkbox("Retain CPU Data", &mesh->RetainCPUData))
+                    {
+                        g_AssetManager.RetainCPUMeshData(mesh->MeshPath, mesh->RetainCPUData);
+                    }
+                    if (ImGui::IsItemHovered())
+                    {
+                        ImGui::SetTooltip("Keep vertex/index data in RAM after upload. Applies on next load.");
                     }
 
                     // --- Submeshes Information ---
@@ -456,7 +507,9 @@ void InspectorWindow::Show()
                                     ImGui::Text("VAO: %d", static_cast<int>(submesh.vao));
 
                                     // --- Submesh Index Count (Read-Only) ---
-                                    ImGui::Text("Index Count: %d", static_cast<int>(submesh.indices.size()));
+                                    ImGui::Text("Index Count: %d", static_cast<int>(submesh.indexCount));
+                                    ImGui::Text("Vertex Count: %d", static_cast<int>(submesh.vertexCount));
+                                    ImGui::Text("CPU Data: %s", submesh.cpuDataRetained ? "Retained" : "Released");
 
                                     // --- Textures Associated with the Submesh ---
                                     ImGui::Separator();
@@ -532,6 +585,12 @@ void InspectorWindow::Show()
                         script->ScriptPath = buffer; // Update the script path if modified
                     }
 
+                    ImGui::Checkbox("Thread-Safe", &script->ThreadSafe);
+                    if (ImGui::IsItemHovered())
+                    {
+                        ImGui::SetTooltip("Run OnUpdate on a worker thread in its own Lua state when parallel scripts are enabled.\nTransform writes are applied after the parallel pass. Applies on reload.");
+                    }
+
                     // Reload Script Button
                     if (ImGui::Button("Reload Script"))
                     {
@@ -5,6 +5,8 @@
 #include <cstdarg>
 #include <cstdio>
 #include "Icons.h"
+#include "Engine/Profiler.h"
+#include "Engine/MemoryTracker.h"
 
 // Helper function to format strings
 static std::string FormatString(const char* fmt, va_list args) {
@@ -14,28 +16,51 @@ static std::string FormatString(const char* fmt, va_list args) {
 }
 
 void LoggerWindow::AddLog(const char* fmt, ...) {
+    MemoryTagScope memoryTag(MemoryTag::Logger);
+
     va_list args;
     va_start(args, fmt);
     std::string formatted = FormatString(fmt, args);
     va_end(args);
 
-    m_Logs.emplace_back(formatted);
-    m_ScrollToBottom = true;
+    Append(std::move(formatted), std::nullopt);
 }
 
 void LoggerWindow::AddLog(const char* fmt, std::optional<ImVec4> color, ...) {
+    MemoryTagScope memoryTag(MemoryTag::Logger);
+
     va_list args;
     va_start(args, color);
     std::string formatted = FormatString(fmt, args);
     va_end(args);
 
-    m_Logs.emplace_back(formatted, color);
+    Append(std::move(formatted), color);
+}
+
+void LoggerWindow::Append(std::string text, std::optional<ImVec4> color) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    if (m_ConsoleOutput) {
+        // Nothing will ever show the list, so don't let it grow
+        std::fputs(text.c_str(), stdout);
+        std::fputc('\n', stdout);
+        return;
+    }
+    m_Logs.emplace_back(std::move(text), color);
     m_ScrollToBottom = true;
 }
 
+void LoggerWindow::Clear() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Logs.clear();
+}
+
 void LoggerWindow::Show() {
+    PROFILE_ZONE("LoggerWindow");
+
     ImGui::Begin(ICON_FA_TERMINAL " Logger##logger");
 
+    std::lock_guard<std::mutex> lock(m_Mutex);
+
     if (ImGui::Button("Clear")) {
         m_Logs.clear();
     }
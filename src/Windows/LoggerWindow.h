@@ -5,6 +5,7 @@
 #include <vector>
 #include <string>
 #include <optional>
+#include <mutex>
 #include <imgui.h>
 
 struct LogEntry {
@@ -15,13 +16,22 @@ struct LogEntry {
         : text(msg), color(col) {}
 };
 
+// AddLog may be called from any thread (e.g. scripts running on the job system)
 class LoggerWindow {
 public:
     void AddLog(const char* fmt, ...);
     void AddLog(const char* fmt, std::optional<ImVec4> color, ...);
+    void Clear();
     void Show();
 
+    // Headless runs: print each entry to stdout instead of keeping it for the window
+    void SetConsoleOutput(bool enabled) { m_ConsoleOutput = enabled; }
+
 private:
+    void Append(std::string text, std::optional<ImVec4> color);
+
     std::vector<LogEntry> m_Logs;
     bool m_ScrollToBottom = false;
+    bool m_ConsoleOutput = false;
+    std::mutex m_Mutex;
 };
@@ -0,0 +1,76 @@
+// src/Windows/MemoryWindow.cpp
+
+#include "MemoryWindow.h"
+#include "imgui.h"
+#include "Icons.h"
+#include "Engine/MemoryTracker.h"
+#include "Engine/Profiler.h"
+
+#include <algorithm>
+
+void MemoryWindow::Show()
+{
+    PROFILE_ZONE("MemoryWindow");
+
+    MemoryTracker &tracker = MemoryTracker::Get();
+    const double mb = 1024.0 * 1024.0;
+
+    m_History[m_HistoryOffset] = static_cast<float>(tracker.GetTotalBytes() / mb);
+    m_HistoryOffset = (m_HistoryOffset + 1) % HistorySize;
+
+    ImGui::Begin(ICON_FA_MEMORY " Memory##memory");
+
+    ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.2f, 1.0f), "Tracked Heap: %.2f MB", tracker.GetTotalBytes() / mb);
+    ImGui::SameLine();
+    ImGui::Text("| %lld allocations last frame", static_cast<long long>(tracker.GetTotalFrameAllocations()));
+
+    float maxMB = *std::max_element(m_History, m_History + HistorySize);
+    ImGui::PlotLines("MB", m_History, HistorySize, m_HistoryOffset, nullptr, 0.0f, std::max(1.0f, maxMB * 1.15f), ImVec2(0, 60));
+
+    ImGui::Separator();
+
+    if (ImGui::BeginTable("MemoryTable", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable))
+    {
+        ImGui::TableSetupColumn("Subsystem", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Current (MB)", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Peak (MB)", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Live Blocks", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Allocs/Frame", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Budget (MB, 0 = none)", ImGuiTableColumnFlags_None);
+        ImGui::TableHeadersRow();
+
+        for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i)
+        {
+            MemoryTag tag = static_cast<MemoryTag>(i);
+            const MemoryTagStats &stats = tracker.GetStats(tag);
+
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            if (stats.OverBudget)
+                ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.2f, 1.0f), "%s (over budget)", MemoryTracker::TagName(tag));
+            else
+                ImGui::TextUnformatted(MemoryTracker::TagName(tag));
+
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%.2f", stats.CurrentBytes / mb);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.2f", stats.PeakBytes / mb);
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%lld", static_cast<long long>(stats.LiveAllocations));
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%lld", static_cast<long long>(stats.FrameAllocations));
+
+            ImGui::TableSetColumnIndex(5);
+            int budgetMB = static_cast<int>(tracker.GetBudget(tag) / (1024 * 1024));
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::SetNextItemWidth(-1.0f);
+            if (ImGui::InputInt("##Budget", &budgetMB, 1, 16))
+                tracker.SetBudget(tag, static_cast<size_t>(std::max(0, budgetMB)) * 1024 * 1024);
+            ImGui::PopID();
+        }
+
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
@@ -0,0 +1,18 @@
+// src/Windows/MemoryWindow.h
+
+#pragma once
+
+#include <vector>
+
+// Heap usage per subsystem from MemoryTracker, with editable budgets
+class MemoryWindow
+{
+public:
+    void Show();
+
+private:
+    // Total tracked bytes, sampled every frame for the graph (ring buffer from m_HistoryOffset)
+    static const int HistorySize = 120;
+    float m_History[HistorySize] = {0.0f};
+    int m_HistoryOffset = 0;
+};
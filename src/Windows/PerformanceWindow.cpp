@@ -2,12 +2,27 @@
 #include "imgui.h"
 #include <algorithm> // for std::max_element, etc.
 #include "Engine/ThemeManager.h"
+#include "Engine/AssetManager.h"
+#include "Rendering/LODSelector.h"
+#include "Rendering/MeshletCulling.h"
+#include "Engine/Profiler.h"
+#include "Engine/FrameStats.h"
+#include "Rendering/GPUMemory.h"
+#include "Rendering/RenderBackend.h"
+#include "Windows/LoggerWindow.h"
 
 
 
 
-extern int LoadedAssets;
 extern int g_GPU_Triangles_drawn_to_screen;
+extern AssetManager g_AssetManager;
+extern LoggerWindow *g_LoggerWindow;
+
+const char* vertexLayoutOptions[] = { "Float32 (32 B)", "Compact (20 B)", "Quantized (16 B)" };
+const int numVertexLayouts = sizeof(vertexLayoutOptions) / sizeof(vertexLayoutOptions[0]);
+
+const char* renderBackendOptions[] = { "OpenGL", "Software" };
+const int numRenderBackends = sizeof(renderBackendOptions) / sizeof(renderBackendOptions[0]);
 
 const char* polygonModeOptions[] = { "Fill", "Wireframe", "Points" };
 const int numPolygonModes = sizeof(polygonModeOptions) / sizeof(polygonModeOptions[0]);
@@ -18,22 +33,21 @@ int polygonMode = 0;
 int PerformanceWindow::m_OpenGLCallCount = 0;
 int PerformanceWindow::m_TriangleCount = 0;
 
-// We'll store up to 60 data points for each stat.
+// We'll store up to 60 data points for each stat, as ring buffers starting at s_HistoryOffset
 static float s_FpsHistory[60] = {0.0f};
 static float s_MsHistory[60] = {0.0f};
 static float s_CallsHistory[60] = {0.0f};
 static float s_TriangleHistory[60] = {0.0f};
+static int s_HistoryOffset = 0;
 
 // Current dynamic max scale for FPS and ms
 static float s_FpsScale = 120.0f; // default starting scale for FPS
 static float s_MsScale = 25.0f;   // default starting scale for ms
 
-// This function shifts the old values left and appends a new value at the end.
-static void PushValueToHistory(float *historyArray, int historySize, float newValue)
+// Overwrites the oldest value; the plots read from s_HistoryOffset, so nothing has to shift
+static void PushValueToHistory(float *historyArray, float newValue)
 {
-    for (int i = 0; i < historySize - 1; i++)
-        historyArray[i] = historyArray[i + 1];
-    historyArray[historySize - 1] = newValue;
+    historyArray[s_HistoryOffset] = newValue;
 }
 
 // We'll track when we last pushed data to our history.
@@ -54,6 +68,8 @@ void PerformanceWindow::UpdatePerformanceStats(int newCallCount, int newTriangle
 
 void PerformanceWindow::Show(float fps, float ms)
 {
+    PROFILE_ZONE("PerformanceWindow");
+
     // 1) Get current time from ImGui's internal clock
     double currentTime = ImGui::GetTime();
 
@@ -63,10 +79,11 @@ void PerformanceWindow::Show(float fps, float ms)
         s_LastPushTime = currentTime;
 
         // Push new values into our history arrays
-        PushValueToHistory(s_FpsHistory, 60, fps);
-        PushValueToHistory(s_MsHistory, 60, ms);
-        PushValueToHistory(s_CallsHistory, 60, (float)m_OpenGLCallCount);
-        PushValueToHistory(s_TriangleHistory, 60, (float)m_TriangleCount);
+        PushValueToHistory(s_FpsHistory, fps);
+        PushValueToHistory(s_MsHistory, ms);
+        PushValueToHistory(s_CallsHistory, (float)m_OpenGLCallCount);
+        PushValueToHistory(s_TriangleHistory, (float)m_TriangleCount);
+        s_HistoryOffset = (s_HistoryOffset + 1) % 60;
     }
 
     // 3) Every 1 second, recalculate the max scale for FPS and ms
@@ -119,7 +136,7 @@ void PerformanceWindow::Show(float fps, float ms)
     ImGui::PlotLines("FPS",
                      s_FpsHistory,
                      IM_ARRAYSIZE(s_FpsHistory),
-                     0,
+                     s_HistoryOffset,
                      nullptr,
                      0.0f,
                      s_FpsScale,
@@ -128,12 +145,47 @@ void PerformanceWindow::Show(float fps, float ms)
     ImGui::PlotHistogram("ms/frame",
                          s_MsHistory,
                          IM_ARRAYSIZE(s_MsHistory),
-                         0,
+                         s_HistoryOffset,
                          nullptr,
                          0.0f,
                          s_MsScale,
                          ImVec2(0, 60));
 
+    // Frame time percentiles, recomputed with the history push rate
+    static FrameTimeSummary s_WindowSummary;
+    static FrameTimeSummary s_SessionSummary;
+    if (s_LastPushTime == currentTime)
+    {
+        s_WindowSummary = FrameStats::Get().ComputeWindow(FrameStats::Get().GetWindowFrames());
+        s_SessionSummary = FrameStats::Get().ComputeSession();
+    }
+
+    ImGui::Text("Last %d frames: p50 %.2f | p95 %.2f | p99 %.2f | max %.2f ms",
+                s_WindowSummary.Frames, s_WindowSummary.P50Ms, s_WindowSummary.P95Ms, s_WindowSummary.P99Ms, s_WindowSummary.MaxMs);
+    ImGui::Text("Session:        p50 %.2f | p95 %.2f | p99 %.2f | max %.2f ms",
+                s_SessionSummary.P50Ms, s_SessionSummary.P95Ms, s_SessionSummary.P99Ms, s_SessionSummary.MaxMs);
+
+    int windowFrames = static_cast<int>(FrameStats::Get().GetWindowFrames());
+    if (ImGui::SliderInt("Stats Window (frames)", &windowFrames, 60, static_cast<int>(FrameStats::Capacity)))
+        FrameStats::Get().SetWindowFrames(static_cast<size_t>(windowFrames));
+
+    float hitchThreshold = static_cast<float>(FrameStats::Get().GetHitchThresholdMs());
+    if (ImGui::InputFloat("Hitch Threshold (ms)", &hitchThreshold, 1.0f, 10.0f, "%.1f"))
+        FrameStats::Get().SetHitchThresholdMs(hitchThreshold);
+    ImGui::Text("Hitches: %llu", static_cast<unsigned long long>(FrameStats::Get().GetHitchCount()));
+
+    if (ImGui::Button("Export Frame Times (CSV)"))
+    {
+        std::string path = FrameStats::DefaultExportPath();
+        if (FrameStats::Get().ExportCSV(path))
+            g_LoggerWindow->AddLog("[FrameStats] Exported frame times to %s", path.c_str());
+        else
+            g_LoggerWindow->AddLog("[FrameStats] Failed to write %s", ImVec4(1.0f, 0.3f, 0.3f, 1.0f), path.c_str());
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Reset Frame Stats"))
+        FrameStats::Get().Reset();
+
     ImGui::Separator();
 
     // Show OpenGL calls + Triangles
@@ -141,7 +193,7 @@ void PerformanceWindow::Show(float fps, float ms)
     ImGui::PlotLines("GL Calls",
                      s_CallsHistory,
                      IM_ARRAYSIZE(s_CallsHistory),
-                     0,
+                     s_HistoryOffset,
                      nullptr,
                      0.0f,
                      300.0f,
@@ -151,7 +203,7 @@ void PerformanceWindow::Show(float fps, float ms)
     ImGui::PlotHistogram("Indices",
                          s_TriangleHistory,
                          IM_ARRAYSIZE(s_TriangleHistory),
-                         0,
+                         s_HistoryOffset,
                          nullptr,
                          0.0f,
                          m_TriangleCount*2.5,
@@ -162,6 +214,129 @@ void PerformanceWindow::Show(float fps, float ms)
     // Show asset count
     ImGui::TextColored(ImVec4(0.4f, 1.0f, 0.4f, 1.0f), "Assets: %d", LoadedAssets);
 
+    // Mesh vertex/index memory against what the same data costs as Float32 + uint32 indices
+    size_t meshBytes = g_AssetManager.GetMeshGPUBytes();
+    size_t float32Bytes = g_AssetManager.GetMeshFloat32Bytes();
+    ImGui::Text("Mesh Memory: %.2f MB (Float32: %.2f MB, %.0f%%)",
+                meshBytes / (1024.0 * 1024.0),
+                float32Bytes / (1024.0 * 1024.0),
+                float32Bytes > 0 ? 100.0 * meshBytes / float32Bytes : 100.0);
+
+    ImGui::Text("CPU Mesh Data: %.2f MB retained, %.2f MB released",
+                g_AssetManager.GetMeshCPUBytesRetained() / (1024.0 * 1024.0),
+                g_AssetManager.GetMeshCPUBytesReleased() / (1024.0 * 1024.0));
+
+    // VRAM as recorded at every GL upload
+    const GPUMemory &gpuMemory = GPUMemory::Get();
+    ImGui::Text("GPU Memory: %.2f MB in %zu allocations", gpuMemory.GetTotalBytes() / (1024.0 * 1024.0), gpuMemory.GetAllocationCount());
+    for (size_t i = 0; i < static_cast<size_t>(GPUMemoryCategory::Count); ++i)
+    {
+        GPUMemoryCategory category = static_cast<GPUMemoryCategory>(i);
+        ImGui::BulletText("%s: %.2f MB", GPUMemory::CategoryName(category), gpuMemory.GetCategoryBytes(category) / (1024.0 * 1024.0));
+    }
+
+    if (ImGui::TreeNode("Largest Assets (GPU)"))
+    {
+        if (ImGui::BeginTable("GPUAssetTable", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable))
+        {
+            ImGui::TableSetupColumn("Asset", ImGuiTableColumnFlags_None);
+            ImGui::TableSetupColumn("Total (KB)", ImGuiTableColumnFlags_None);
+            ImGui::TableSetupColumn("Vertices (KB)", ImGuiTableColumnFlags_None);
+            ImGui::TableSetupColumn("Indices (KB)", ImGuiTableColumnFlags_None);
+            ImGui::TableSetupColumn("Textures / Targets (KB)", ImGuiTableColumnFlags_None);
+            ImGui::TableHeadersRow();
+
+            for (const GPUAssetMemory &asset : gpuMemory.GetLargestAssets(20))
+            {
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextUnformatted(asset.Owner.empty() ? "(unnamed)" : asset.Owner.c_str());
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%.1f", asset.TotalBytes / 1024.0);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.1f", asset.Bytes[static_cast<size_t>(GPUMemoryCategory::VertexBuffer)] / 1024.0);
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%.1f", asset.Bytes[static_cast<size_t>(GPUMemoryCategory::IndexBuffer)] / 1024.0);
+                ImGui::TableSetColumnIndex(4);
+                ImGui::Text("%.1f", (asset.Bytes[static_cast<size_t>(GPUMemoryCategory::Texture)] +
+                                     asset.Bytes[static_cast<size_t>(GPUMemoryCategory::RenderTarget)]) / 1024.0);
+            }
+            ImGui::EndTable();
+        }
+        ImGui::TreePop();
+    }
+
+    bool retainCPUMeshData = g_AssetManager.GetRetainCPUMeshData();
+    if (ImGui::Checkbox("Retain CPU Mesh Data", &retainCPUMeshData))
+    {
+        // Applies to models loaded afterwards
+        g_AssetManager.SetRetainCPUMeshData(retainCPUMeshData);
+    }
+
+    ImGui::Separator();
+
+    // Level of detail
+    ImGui::Text("LOD Objects: %d / %d / %d / %d",
+                g_LODStats.ObjectsPerLOD[0], g_LODStats.ObjectsPerLOD[1],
+                g_LODStats.ObjectsPerLOD[2], g_LODStats.ObjectsPerLOD[3]);
+    ImGui::Text("LOD Triangles: %d of %d (%.0f%% saved)",
+                g_LODStats.TrianglesDrawn, g_LODStats.TrianglesFullDetail,
+                g_LODStats.TrianglesFullDetail > 0 ? 100.0f * (1.0f - (float)g_LODStats.TrianglesDrawn / g_LODStats.TrianglesFullDetail) : 0.0f);
+    ImGui::Checkbox("LOD Selection", &g_LODSettings.Enabled);
+    ImGui::SliderInt("Force LOD", &g_LODSettings.ForcedLOD, -1, MAX_MESH_LODS - 1);
+    ImGui::SliderFloat("LOD Hysteresis", &g_LODSettings.Hysteresis, 0.0f, 0.5f);
+
+    bool generateLODs = g_AssetManager.GetGenerateLODs();
+    if (ImGui::Checkbox("Generate LODs On Load", &generateLODs))
+    {
+        g_AssetManager.SetGenerateLODs(generateLODs);
+    }
+
+    ImGui::Separator();
+
+    // Meshlet culling
+    ImGui::Text("Meshlets: %d drawn of %d (%d ranges)",
+                g_MeshletStats.Drawn, g_MeshletStats.Meshlets, g_MeshletStats.DrawRanges);
+    ImGui::Text("Culled: %d frustum, %d cone (%d tris)",
+                g_MeshletStats.FrustumCulled, g_MeshletStats.ConeCulled, g_MeshletStats.TrianglesCulled);
+    ImGui::Checkbox("Meshlet Culling", &g_MeshletCullingSettings.Enabled);
+    ImGui::SameLine();
+    ImGui::Checkbox("Frustum", &g_MeshletCullingSettings.FrustumCulling);
+    ImGui::SameLine();
+    ImGui::Checkbox("Cone", &g_MeshletCullingSettings.ConeCulling);
+    ImGui::Checkbox("Cone Cull Open Meshes", &g_MeshletCullingSettings.ConeCullOpenMeshes);
+
+    bool buildMeshlets = g_AssetManager.GetBuildMeshlets();
+    if (ImGui::Checkbox("Build Meshlets On Load", &buildMeshlets))
+    {
+        g_AssetManager.SetBuildMeshlets(buildMeshlets);
+    }
+
+    ImGui::Separator();
+
+    int vertexLayout = static_cast<int>(g_AssetManager.GetVertexLayout());
+    if (ImGui::Combo("Vertex Layout", &vertexLayout, vertexLayoutOptions, numVertexLayouts))
+    {
+        // Applies to models loaded afterwards
+        g_AssetManager.SetVertexLayout(static_cast<VertexLayout>(vertexLayout));
+    }
+
+    ImGui::Separator();
+
+    // Viewport render backend; the software rasterizer draws from CPU mesh copies
+    int renderBackend = static_cast<int>(g_RenderBackendType);
+    if (ImGui::Combo("Render Backend", &renderBackend, renderBackendOptions, numRenderBackends))
+    {
+        g_RenderBackendType = static_cast<RenderBackendType>(renderBackend);
+    }
+    ImGui::Text("Submeshes: %d drawn, %d skipped (%d ranges, %d tris)",
+                g_RenderFrameStats.Submeshes, g_RenderFrameStats.SkippedSubmeshes,
+                g_RenderFrameStats.DrawRanges, g_RenderFrameStats.Triangles);
+    if (g_RenderBackendType == RenderBackendType::Software && g_RenderFrameStats.SkippedSubmeshes > 0)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "Skipped submeshes have no CPU data: enable Retain CPU Mesh Data and reload them");
+    }
+
     ImGui::Separator();
 
 
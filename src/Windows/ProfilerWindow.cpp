@@ -1,9 +1,12 @@
 #include "ProfilerWindow.h"
 #include <imgui.h>
 #include <algorithm>
+#include <cstring>
 #include <string>
 #include <iostream> // For debug statements
 #include "Icons.h"
+#include "Engine/LuaAPI.h"
+#include "Engine/FrameStats.h"
 
 // Constructor
 ProfilerWindow::ProfilerWindow()
@@ -101,6 +104,8 @@ void ProfilerWindow::Show()
     // Begin ImGui window with improved styling
     ImGui::Begin(ICON_FA_GAUGE  " Profiler", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_HorizontalScrollbar);
 
+    PROFILE_ZONE("ProfilerWindow");
+
     const auto &data = Profiler::Get().GetLastFrameData();
 
     if (data.empty())
@@ -112,26 +117,37 @@ void ProfilerWindow::Show()
 
     if (shouldUpdate)
     {
-        // Calculate total frame time
-        double totalFrameTime = 0.0;
-        for (const auto &[name, result] : data)
-        {
-            totalFrameTime += result.TotalTime;
-        }
+        // Only the outermost zones: nested ones are already part of their parents' time
+        double totalFrameTime = Profiler::Get().GetLastFrameRootTime();
 
         // Update history data
         UpdateHistory(data, totalFrameTime);
 
-        // Reset profiling data for the next interval
-        Profiler::Get().EndFrame();
+        m_CallTree = Profiler::Get().GetLastFrameTree();
+        m_CallTreeRootTime = totalFrameTime;
+
+        m_GPUResults = GPUProfiler::Get().GetLastFrameResults();
+        m_GPUFrameTime = GPUProfiler::Get().GetLastFrameTimeUs();
     }
 
     // Render profiling data table
     RenderTable();
 
+    // Nested zones with self vs inclusive time
+    RenderCallTree();
+
+    // Timer query results per render pass / draw batch
+    RenderGPUTable();
+
+    // Slow frames with the zones they spent their time in
+    RenderHitches();
+
     // Render profiling graphs
     RenderGraphs();
 
+    // Per-script CPU / memory
+    RenderScriptTable();
+
     // Display total frame time (from the last update)
     if (!m_TotalFrameTimeHistory.empty())
     {
@@ -140,6 +156,37 @@ void ProfilerWindow::Show()
         ImGui::TextColored(ImVec4(0.4f, 0.7f, 0.0f, 1.0f), "Total Frame Time: %.3f µs", lastTotalFrameTime);
     }
 
+    // Cost of one PROFILE_ZONE on this machine
+    if (Profiler::Get().GetZoneOverheadNs() == 0.0)
+        Profiler::Get().MeasureZoneOverhead();
+    if (ImGui::Button("Measure Zone Overhead"))
+        Profiler::Get().MeasureZoneOverhead();
+    ImGui::SameLine();
+    ImGui::Text("%.1f ns per zone, %llu events dropped", Profiler::Get().GetZoneOverheadNs(),
+                static_cast<unsigned long long>(Profiler::Get().GetDroppedEvents()));
+
+    // Trace capture for chrome://tracing / ui.perfetto.dev
+    static int captureFrames = 300;
+    if (Profiler::Get().IsCapturing())
+    {
+        ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.0f, 1.0f), "Capturing trace: %d frames left", Profiler::Get().GetCaptureFramesLeft());
+    }
+    else
+    {
+        ImGui::SetNextItemWidth(100.0f);
+        ImGui::InputInt("##CaptureFrames", &captureFrames);
+        captureFrames = std::max(1, captureFrames);
+        ImGui::SameLine();
+        if (ImGui::Button("Capture Trace"))
+            Profiler::Get().BeginCapture(captureFrames);
+        if (!Profiler::Get().GetLastCapturePath().empty())
+        {
+            ImGui::SameLine();
+            ImGui::Text("%s %s (%zu events)", Profiler::Get().GetLastCaptureSucceeded() ? "Last:" : "Failed:",
+                        Profiler::Get().GetLastCapturePath().c_str(), Profiler::Get().GetLastCaptureEventCount());
+        }
+    }
+
     ImGui::End();
 }
 
@@ -228,6 +275,256 @@ void ProfilerWindow::RenderTable()
     }
 }
 
+void ProfilerWindow::RenderCallTree()
+{
+    ImGui::Separator();
+    ImGui::TextColored(ImVec4(0.0f, 0.7f, 0.9f, 1.0f), "Call Tree");
+
+    if (m_CallTree.empty())
+    {
+        ImGui::Text("No zones recorded.");
+        return;
+    }
+
+    if (ImGui::BeginTable("ProfilerCallTree", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY, ImVec2(0, 250)))
+    {
+        ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_NoHide);
+        ImGui::TableSetupColumn("Inclusive (µs)", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Self (µs)", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("% of Frame", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("GPU (µs)", ImGuiTableColumnFlags_None);
+        ImGui::TableHeadersRow();
+
+        // Main thread first; roots from worker threads run concurrently with it
+        for (bool mainThread : {true, false})
+        {
+            for (uint32_t i = 0; i < m_CallTree.size(); ++i)
+            {
+                const ProfileNode &node = m_CallTree[i];
+                if (node.Parent == ProfileNode::NoParent && node.MainThread == mainThread)
+                    RenderCallTreeNode(i);
+            }
+        }
+
+        ImGui::EndTable();
+    }
+}
+
+void ProfilerWindow::RenderCallTreeNode(uint32_t index)
+{
+    const ProfileNode &node = m_CallTree[index];
+
+    ImGui::TableNextRow();
+    ImGui::TableSetColumnIndex(0);
+
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_SpanFullWidth;
+    if (node.Children.empty())
+        flags |= ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
+    else if (node.Depth < 2)
+        flags |= ImGuiTreeNodeFlags_DefaultOpen;
+
+    ImGui::PushID(static_cast<int>(index));
+    bool open = ImGui::TreeNodeEx(node.Name, flags, "%s%s", node.Name, node.MainThread ? "" : " (worker)");
+    ImGui::PopID();
+
+    ImGui::TableSetColumnIndex(1);
+    ImGui::Text("%.2f", node.InclusiveTime);
+    ImGui::TableSetColumnIndex(2);
+    ImGui::Text("%.2f", node.SelfTime);
+    ImGui::TableSetColumnIndex(3);
+    ImGui::Text("%d", node.CallCount);
+    ImGui::TableSetColumnIndex(4);
+    if (node.MainThread && m_CallTreeRootTime > 0.0)
+        ImGui::Text("%.1f%%", 100.0 * node.InclusiveTime / m_CallTreeRootTime);
+    else
+        ImGui::TextDisabled("-");
+
+    // Same-named GPU zone, if the pass has one
+    ImGui::TableSetColumnIndex(5);
+    double gpuTime = node.MainThread ? GPUTimeFor(node.Name) : -1.0;
+    if (gpuTime >= 0.0)
+        ImGui::Text("%.2f", gpuTime);
+    else
+        ImGui::TextDisabled("-");
+
+    if (open && !node.Children.empty())
+    {
+        for (uint32_t child : node.Children)
+            RenderCallTreeNode(child);
+        ImGui::TreePop();
+    }
+}
+
+double ProfilerWindow::GPUTimeFor(const char *name) const
+{
+    double timeUs = -1.0;
+    for (const GPUZoneResult &result : m_GPUResults)
+    {
+        if (std::strcmp(result.Name, name) == 0)
+            timeUs = (timeUs < 0.0 ? 0.0 : timeUs) + result.TimeUs;
+    }
+    return timeUs;
+}
+
+void ProfilerWindow::RenderGPUTable()
+{
+    ImGui::Separator();
+    ImGui::TextColored(ImVec4(0.0f, 0.7f, 0.9f, 1.0f), "GPU");
+
+    GPUProfiler &gpu = GPUProfiler::Get();
+    if (!gpu.IsSupported())
+    {
+        ImGui::TextDisabled("Timer queries are not supported by this GL driver.");
+        return;
+    }
+
+    bool enabled = gpu.IsEnabled();
+    if (ImGui::Checkbox("GPU Timer Queries", &enabled))
+        gpu.SetEnabled(enabled);
+    ImGui::SameLine();
+    ImGui::Text("%.2f µs GPU frame, %d frames behind, %llu frames skipped, %llu zones dropped", m_GPUFrameTime,
+                GPUProfiler::FrameLatency - 1, static_cast<unsigned long long>(gpu.GetSkippedFrames()),
+                static_cast<unsigned long long>(gpu.GetDroppedZones()));
+
+    if (m_GPUResults.empty())
+        return;
+
+    if (ImGui::BeginTable("ProfilerGPUTable", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable))
+    {
+        ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("GPU Time (µs)", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Calls", ImGuiTableColumnFlags_None);
+        ImGui::TableHeadersRow();
+
+        for (const GPUZoneResult &result : m_GPUResults)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Indent(result.Depth * ImGui::GetStyle().IndentSpacing + 0.001f);
+            ImGui::TextUnformatted(result.Name);
+            ImGui::Unindent(result.Depth * ImGui::GetStyle().IndentSpacing + 0.001f);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%.2f", result.TimeUs);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%d", result.CallCount);
+        }
+
+        ImGui::EndTable();
+    }
+}
+
+void ProfilerWindow::RenderHitches()
+{
+    const FrameStats &stats = FrameStats::Get();
+    const std::deque<FrameHitch> &hitches = stats.GetHitches();
+
+    ImGui::Separator();
+    ImGui::TextColored(ImVec4(0.0f, 0.7f, 0.9f, 1.0f), "Hitches (> %.1f ms): %llu", stats.GetHitchThresholdMs(),
+                       static_cast<unsigned long long>(stats.GetHitchCount()));
+
+    // Newest first
+    for (auto hitch = hitches.rbegin(); hitch != hitches.rend(); ++hitch)
+    {
+        ImGui::PushID(static_cast<int>(hitch->Frame));
+        if (ImGui::TreeNode("Hitch", "Frame %llu: %.2f ms", static_cast<unsigned long long>(hitch->Frame), hitch->TimeMs))
+        {
+            for (const HitchZone &zone : hitch->Zones)
+            {
+                ImGui::Indent(zone.Depth * ImGui::GetStyle().IndentSpacing + 0.001f);
+                ImGui::Text("%s: %.2f µs (self %.2f µs)", zone.Name, zone.InclusiveUs, zone.SelfUs);
+                ImGui::Unindent(zone.Depth * ImGui::GetStyle().IndentSpacing + 0.001f);
+            }
+            if (hitch->Zones.empty())
+                ImGui::TextDisabled("No zones recorded.");
+            ImGui::TreePop();
+        }
+        ImGui::PopID();
+    }
+}
+
+void ProfilerWindow::RenderScriptTable()
+{
+    ImGui::Separator();
+    ImGui::TextColored(ImVec4(0.0f, 0.7f, 0.9f, 1.0f), "Lua Scripts");
+
+    // Budgets apply to every script
+    int budgetThousands = static_cast<int>(LuaManager::GetInstructionBudget() / 1000);
+    if (ImGui::InputInt("Instruction Budget (k/frame)", &budgetThousands, 100, 1000))
+        LuaManager::SetInstructionBudget(static_cast<long long>(std::max(0, budgetThousands)) * 1000);
+
+    int limitMB = static_cast<int>(LuaManager::GetMemoryLimit() / (1024 * 1024));
+    if (ImGui::InputInt("Memory Limit (MB/script)", &limitMB, 1, 16))
+        LuaManager::SetMemoryLimit(static_cast<size_t>(std::max(0, limitMB)) * 1024 * 1024);
+
+    bool engineDrivenGC = LuaManager::IsEngineDrivenGC();
+    if (ImGui::Checkbox("Engine-driven GC", &engineDrivenGC))
+        LuaManager::SetEngineDrivenGC(engineDrivenGC);
+    ImGui::SameLine();
+    int gcMode = LuaManager::GetGCMode() == LuaGCMode::Generational ? 0 : 1;
+    if (ImGui::Combo("GC Mode", &gcMode, "Generational\0Incremental\0"))
+        LuaManager::SetGCMode(gcMode == 0 ? LuaGCMode::Generational : LuaGCMode::Incremental);
+
+    const LuaGCStats &gc = LuaManager::GetGCStats();
+    ImGui::Text("GC: %.3f ms of %.3f ms budget, %d steps, %d cycles, %d forced, %.1f KB heap",
+                gc.Ms, gc.BudgetMs, gc.Steps, gc.Cycles, gc.ForcedSteps, gc.HeapBytes / 1024.0);
+
+    std::vector<LuaScriptStats> stats = LuaManager::GetScriptStats();
+    std::sort(stats.begin(), stats.end(),
+              [](const LuaScriptStats &a, const LuaScriptStats &b)
+              { return a.CpuMs > b.CpuMs; });
+
+    ImGui::Text("%zu scripts, %zu coroutines, %.1f KB Lua heap outside scripts", stats.size(), LuaManager::GetTaskCount(),
+                LuaManager::GetEngineMemoryBytes() / 1024.0);
+
+    if (ImGui::BeginTable("LuaScriptTable", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY, ImVec2(0, 200)))
+    {
+        ImGui::TableSetupColumn("Script", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("CPU (ms)", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Instructions", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Memory (KB)", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Peak (KB)", ImGuiTableColumnFlags_None);
+        ImGui::TableSetupColumn("Status", ImGuiTableColumnFlags_None);
+        ImGui::TableHeadersRow();
+
+        for (const LuaScriptStats &script : stats)
+        {
+            ImGui::TableNextRow();
+
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(script.Name.c_str());
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("%s (%s VM)", script.Path.c_str(), script.Shared ? "shared" : "own");
+
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%.3f", script.CpuMs);
+
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%lld", script.Instructions);
+
+            ImGui::TableSetColumnIndex(3);
+            bool nearLimit = script.MemoryLimit > 0 && script.MemoryBytes * 10 > script.MemoryLimit * 9;
+            if (nearLimit)
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%.1f", script.MemoryBytes / 1024.0);
+            else
+                ImGui::Text("%.1f", script.MemoryBytes / 1024.0);
+
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%.1f", script.PeakMemoryBytes / 1024.0);
+
+            ImGui::TableSetColumnIndex(5);
+            if (script.Suspended)
+                ImGui::TextColored(ImVec4(1.0f, 0.8f, 0.0f, 1.0f), "Suspended (%d)", script.BudgetYields);
+            else if (script.MemoryLimitHits > 0)
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Memory limit hit (%d)", script.MemoryLimitHits);
+            else
+                ImGui::Text("OK");
+        }
+
+        ImGui::EndTable();
+    }
+}
+
 void ProfilerWindow::RenderGraphs()
 {
     ImGui::Separator();
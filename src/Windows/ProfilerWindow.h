@@ -6,6 +6,7 @@
 #include <deque>
 #include <chrono>
 #include "Engine/Profiler.h" // Ensure Profiler classes are included
+#include "Rendering/GPUProfiler.h"
 
 class ProfilerWindow
 {
@@ -17,6 +18,10 @@ public:
     void Show();
     void RenderTable();
     void RenderGraphs();
+    void RenderScriptTable();
+    void RenderCallTree();
+    void RenderGPUTable();
+    void RenderHitches();
 
 private:
     struct ProfileHistory
@@ -31,6 +36,20 @@ private:
     std::deque<double> m_TotalFrameTimeHistory;
     static const size_t MaxFrameHistory = 100;
 
+    // Call tree of the frame sampled at the last update, so the view doesn't change every frame
+    std::vector<ProfileNode> m_CallTree;
+    double m_CallTreeRootTime = 0.0;
+
+    // GPU zones sampled alongside the call tree (from a few frames earlier)
+    std::vector<GPUZoneResult> m_GPUResults;
+    double m_GPUFrameTime = 0.0;
+
+    // Summed GPU time of the zones named `name`, or a negative value if there are none
+    double GPUTimeFor(const char *name) const;
+
+    // Draws a node and, when expanded, its children as rows of the call tree table
+    void RenderCallTreeNode(uint32_t index);
+
     std::chrono::steady_clock::time_point m_LastUpdateTime;
     double m_UpdateInterval; // In seconds
 
@@ -20,9 +20,11 @@ extern std::vector<std::shared_ptr<GameObject>> g_GameObjects;
 #define CAM_NEAR_PLAIN 0.1f
 #define CAM_FAR_PLAIN 2048.0f
 
-// Include your AssetManager & Shader headers
+// Include your AssetManager & render backend headers
 #include "Engine/AssetManager.h"
-#include "Rendering/Shader.h"
+#include "Rendering/GPUMemory.h"
+#include "Engine/Profiler.h"
+#include "Rendering/GPUProfiler.h"
 
 #include "Icons.h"
 
@@ -252,6 +254,8 @@ bool PlayPauseButton(const char *label, bool *isPlaying, ImVec2 Size)
 
 void RenderWindow::Show(bool *GameRunning)
 {
+    PROFILE_ZONE("RenderWindow");
+
     ImGui::Begin(ICON_FA_GAMEPAD  " Editor##EditorWindow");
 
     if (!m_Initialized)
@@ -260,16 +264,18 @@ void RenderWindow::Show(bool *GameRunning)
         m_Initialized = true;
     }
 
+    EnsureBackend();
+
     ImVec2 size = ImGui::GetContentRegionAvail();
     int w = static_cast<int>(size.x);
     int h = static_cast<int>(size.y);
 
-    // If there's space, render to the FBO, then show it as an ImGui image
+    // If there's space, render the scene, then show it as an ImGui image
     if (w > 0 && h > 0)
     {
-        if (w != m_LastWidth || h != m_LastHeight)
+        if (w != m_LastWidth || h != m_LastHeight || w != m_Backend->GetWidth() || h != m_Backend->GetHeight())
         {
-            m_FBO.Create(w, h);
+            m_Backend->Resize(w, h);
             m_LastWidth = w;
             m_LastHeight = h;
         }
@@ -277,7 +283,7 @@ void RenderWindow::Show(bool *GameRunning)
         RenderSceneToFBO(GameRunning);
 
         // Render the image first
-        ImGui::Image(m_FBO.GetTextureID(), size, ImVec2(0, 0), ImVec2(1, 1));
+        ImGui::Image((ImTextureID)(uintptr_t)PresentFrame(), size, ImVec2(0, 0), ImVec2(1, 1));
 
         // Calculate button position to place it slightly right and down from the top-left of the image
         ImVec2 imagePos = ImGui::GetItemRectMin();
@@ -312,22 +318,7 @@ void RenderWindow::Show(bool *GameRunning)
 void RenderWindow::InitGLResources()
 {
     // ----------------------------------------------------
-    // 1) Load SHADER from the asset manager
-    // ----------------------------------------------------
-
-    {
-        std::shared_ptr<Shader> shaderAsset = g_AssetManager.loadAsset<Shader>(AssetType::SHADER, "assets/shaders/UnlitMaterial");
-        if (!shaderAsset)
-        {
-            fprintf(stderr, "[RenderWindow] Failed to load shader via AssetManager.\n");
-            return;
-        }
-        // Cast back to your Shader class
-        m_ShaderPtr = shaderAsset.get();
-    }
-
-    // ----------------------------------------------------
-    // 2) Create VAO/VBO/EBO for the cube
+    // 1) Create VAO/VBO/EBO for the cube
     // ----------------------------------------------------
     glGenVertexArrays(1, &m_VAO);
     glBindVertexArray(m_VAO);
@@ -352,7 +343,7 @@ void RenderWindow::InitGLResources()
     glBindVertexArray(0);
 
     // ----------------------------------------------------
-    // 3) Load TEXTURE from the asset manager
+    // 2) Load TEXTURE from the asset manager
     // ----------------------------------------------------
     {
         std::shared_ptr<GLuint> texAsset = g_AssetManager.loadAsset<GLuint>(AssetType::TEXTURE, "assets/textures/wood.png");
@@ -368,7 +359,7 @@ void RenderWindow::InitGLResources()
     }
 
     // ----------------------------------------------------
-    // 4) Initialize GameObjects
+    // 3) Initialize GameObjects
     // ----------------------------------------------------
 }
 
@@ -390,28 +381,77 @@ void CheckOpenGLError(const std::string &location)
 #include <glm/gtc/type_ptr.hpp> // For glm::value_ptr
 #include <algorithm>            // Ensure <algorithm> is included
 
-void RenderWindow::RenderSceneToFBO(bool *GameRunning)
+void RenderWindow::EnsureBackend()
 {
-    m_RotationAngle += 0.001f; // Spin per frame
+    if (m_Backend && m_Backend->GetType() == g_RenderBackendType)
+        return;
+
+    m_Backend = RenderBackend::Create(g_RenderBackendType);
+    m_LastWidth = 0;
+    m_LastHeight = 0;
+
+    // A backend that fails to initialize still clears its target, so the viewport and play button stay usable
+    if (!m_Backend->Init())
+    {
+        fprintf(stderr, "[RenderWindow] Failed to initialize the %s render backend.\n", RenderBackend::TypeName(g_RenderBackendType));
+    }
 
-    // Bind the FBO
-    m_FBO.Bind();
-    glViewport(0, 0, m_LastWidth, m_LastHeight);
+    // The upload texture only serves CPU backends
+    if (m_PresentTexture != 0 && g_RenderBackendType != RenderBackendType::Software)
+    {
+        GPUMemory::Get().ReleaseTexture(m_PresentTexture);
+        glDeleteTextures(1, &m_PresentTexture);
+        m_PresentTexture = 0;
+        m_PresentWidth = 0;
+        m_PresentHeight = 0;
+    }
+}
+
+unsigned int RenderWindow::PresentFrame()
+{
+    unsigned int texture = m_Backend->GetTextureID();
+    const uint8_t *pixels = m_Backend->GetPixels();
+    if (texture != 0 || !pixels)
+        return texture;
 
-    glEnable(GL_DEPTH_TEST);
+    PROFILE_ZONE("PresentSoftwareFrame");
 
-    glClearColor(0.f, 0.f, 0.f, 1.f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    int width = m_Backend->GetWidth();
+    int height = m_Backend->GetHeight();
 
-    // Use our loaded shader
-    if (!m_ShaderPtr)
+    if (m_PresentTexture == 0)
     {
-        DEBUG_PRINT("[RenderWindow] Shader pointer is null. Cannot render.");
-        m_FBO.Unbind();
-        return; // Can't render without a shader
+        glGenTextures(1, &m_PresentTexture);
+        glBindTexture(GL_TEXTURE_2D, m_PresentTexture);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     }
 
-    m_ShaderPtr->Use();
+    glBindTexture(GL_TEXTURE_2D, m_PresentTexture);
+    if (width != m_PresentWidth || height != m_PresentHeight)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        GPUMemory::Get().RecordTexture(m_PresentTexture, GPUMemoryCategory::RenderTarget, GPUMemory::TextureBytes(width, height, 4, false), "SoftwareRasterizer");
+        m_PresentWidth = width;
+        m_PresentHeight = height;
+    }
+    else
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return m_PresentTexture;
+}
+
+void RenderWindow::RenderSceneToFBO(bool *GameRunning)
+{
+    PROFILE_ZONE("RenderSceneToFBO");
+    GPU_PROFILE_ZONE("RenderSceneToFBO");
+
+    m_RotationAngle += 0.001f; // Spin per frame
 
     // Define view and projection matrices once
     std::shared_ptr<CameraComponent> activeCamera = nullptr;
@@ -439,95 +479,6 @@ void RenderWindow::RenderSceneToFBO(bool *GameRunning)
         proj = glm::perspective(glm::radians(CAM_FOV), aspect, CAM_NEAR_PLAIN, CAM_FAR_PLAIN);
     }
 
-    // Iterate over each GameObject and render it
-    for (auto &obj : g_GameObjects)
-    {
-        glm::mat4 model = glm::mat4(1.f);
-
-        std::shared_ptr<TransformComponent> transform = obj->GetComponent<TransformComponent>();
-        std::shared_ptr<MeshComponent> mesh = obj->GetComponent<MeshComponent>();
-
-        if (transform && mesh && mesh)
-        {
-            // Apply transformations
-            model = glm::translate(model, transform->position);
-            model = glm::rotate(model, glm::radians(transform->rotation.x), glm::vec3(1.f, 0.f, 0.f));
-            model = glm::rotate(model, glm::radians(transform->rotation.y), glm::vec3(0.f, 1.f, 0.f));
-            model = glm::rotate(model, glm::radians(transform->rotation.z), glm::vec3(0.f, 0.f, 1.f));
-            model = glm::scale(model, transform->scale);
-
-            // Compute MVP matrix
-            glm::mat4 mvp = proj * view * model;
-
-            // Pass MVP and Model matrices to the shader
-            m_ShaderPtr->SetMat4("uMVP", mvp);
-            m_ShaderPtr->SetMat4("uModel", model);
-
-            // Iterate through each submesh
-            for (const auto &submesh : mesh->submeshes)
-            {
-                // Validate VAO
-                if (submesh.vao == 0)
-                {
-                    DEBUG_PRINT("[RenderWindow] Warning: Submesh VAO is not initialized.");
-                    continue;
-                }
-
-                // Update triangle count
-                g_GPU_Triangles_drawn_to_screen += static_cast<int>(submesh.indices.size() / 3);
-
-                // Bind textures for the submesh
-                // Assuming the shader has uniform arrays like uTextures.texture_diffuse[32]
-                const int MAX_DIFFUSE = 32; // Must match the shader's MAX_DIFFUSE
-                int textureUnit = 0;
-
-                // Iterate through all textures and bind those with type "texture_diffuse"
-                for (const auto &texture : submesh.textures)
-                {
-                    if (texture.type == "texture_diffuse")
-                    {
-                        if (textureUnit >= MAX_DIFFUSE)
-                        {
-                            DEBUG_PRINT("[RenderWindow] Warning: Exceeded maximum number of diffuse textures (%d) for shader.", MAX_DIFFUSE);
-                            break; // Prevent exceeding the array bounds in the shader
-                        }
-
-                        // Activate the appropriate texture unit
-                        glActiveTexture(GL_TEXTURE0 + textureUnit);
-                        glBindTexture(GL_TEXTURE_2D, texture.id);
-
-                        // Construct the uniform name dynamically (e.g., "uTextures.texture_diffuse[0]")
-                        std::string uniformName = "uTextures.texture_diffuse[" + std::to_string(textureUnit) + "]";
-                        m_ShaderPtr->SetInt(uniformName, textureUnit);
-
-                        textureUnit++;
-                    }
-                }
-
-                // Assign default texture to unused texture slots to prevent shader errors
-                for (int i = textureUnit; i < MAX_DIFFUSE; ++i)
-                {
-                    std::string uniformName = "uTextures.texture_diffuse[" + std::to_string(i) + "]";
-                    m_ShaderPtr->SetInt(uniformName, 0); // Assign texture unit 0 (ensure texture 0 is a valid default)
-                }
-
-                // Set the number of active diffuse textures
-                m_ShaderPtr->SetInt("uNumDiffuseTextures", textureUnit);
-
-                // Draw the submesh
-                glBindVertexArray(submesh.vao);
-                glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(submesh.indices.size()), GL_UNSIGNED_INT, nullptr);
-                glBindVertexArray(0);
-
-                // Reset active texture to default
-                glActiveTexture(GL_TEXTURE0);
-            }
-        }
-    }
-
-    // Cleanup: Unbind the shader program
-    glUseProgram(0);
-
-    // Unbind the FBO
-    m_FBO.Unbind();
+    m_Backend->RenderScene(g_GameObjects, view, proj);
+    g_GPU_Triangles_drawn_to_screen += m_Backend->GetFrameStats().Triangles;
 }
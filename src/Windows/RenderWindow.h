@@ -1,9 +1,10 @@
 #pragma once
 
-#include "../Rendering/FBO.h"
 #include <glm/glm.hpp>
 
-#include "Rendering/Shader.h" // 
+#include "Rendering/RenderBackend.h"
+#include <memory>
+#include <vector>
 
 class RenderWindow
 {
@@ -14,8 +15,19 @@ private:
     void InitGLResources();
     void RenderSceneToFBO(bool *GameRunning);
 
-    // Offscreen render target
-    FBO m_FBO;
+    // Creates the backend, or replaces it when g_RenderBackendType changed
+    void EnsureBackend();
+
+    // GL texture showing the last frame; CPU backends' pixels are uploaded to m_PresentTexture
+    unsigned int PresentFrame();
+
+    // Draws the scene (see RenderBackend::RenderScene)
+    std::unique_ptr<RenderBackend> m_Backend;
+
+    // Upload target for backends that render to CPU memory
+    unsigned int m_PresentTexture = 0;
+    int m_PresentWidth = 0;
+    int m_PresentHeight = 0;
 
     // Keep track if we've initialized
     bool m_Initialized = false;
@@ -32,7 +44,4 @@ private:
 
     // The loaded texture
     unsigned int m_TextureID       = 0;
-
-    // The loaded shader program (via AssetManager)
-    Shader* m_ShaderPtr = nullptr; 
 };
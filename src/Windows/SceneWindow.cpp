@@ -5,6 +5,8 @@
 // Include your asset manager and any other necessary headers
 #include "Engine/AssetManager.h"
 #include "TestModel.h"
+#include "Engine/SceneIndex.h"
+#include "Engine/Profiler.h"
 #include "gcml.h"
 
 #include <iostream>
@@ -28,6 +30,8 @@ std::shared_ptr<GameObject> CreateDefaultCube()
 
 void SceneWindow::Show()
 {
+    PROFILE_ZONE("SceneWindow");
+
     if (ImGui::Begin("Scene Window##SceneWindow"))
     {
         // Add Button
@@ -119,6 +123,7 @@ void SceneWindow::AddGameObject()
     // Modify the name to ensure uniqueness
     newObj->name += " " + std::to_string(g_GameObjects.size());
     g_GameObjects.push_back(newObj);
+    g_SceneIndex.Add(newObj.get());
 }
 
 // RemoveGameObject: Removes a GameObject by index
@@ -132,6 +137,7 @@ void SceneWindow::RemoveGameObject(int index)
             g_SelectedObject = nullptr;
         }
 
+        g_SceneIndex.Remove(g_GameObjects[index].get());
         g_GameObjects.erase(g_GameObjects.begin() + index);
     }
     else
@@ -1,27 +1,91 @@
 // src/main.cpp
 
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include "Engine.h"
+#include "Engine/Profiler.h"
 
 
 
 
-int main()
+int main(int argc, char **argv)
 {
+    // --trace-frames N [--trace-file path]: capture a profiler trace of the first N frames
+    int traceFrames = 0;
+    std::string traceFile;
+
+    // --headless --scene path [--tick-rate hz] [--uncapped] [--ticks n] [--duration s] [--stats-interval s]
+    //            [--capture out.png] [--capture-size WxH]
+    bool headless = false;
+    HeadlessOptions headlessOptions;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--trace-frames") == 0 && i + 1 < argc)
+            traceFrames = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--trace-file") == 0 && i + 1 < argc)
+            traceFile = argv[++i];
+        else if (std::strcmp(argv[i], "--headless") == 0)
+            headless = true;
+        else if (std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc)
+            headlessOptions.ScenePath = argv[++i];
+        else if (std::strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc)
+            headlessOptions.TickRate = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--uncapped") == 0)
+            headlessOptions.Uncapped = true;
+        else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+            headlessOptions.MaxTicks = std::atoll(argv[++i]);
+        else if (std::strcmp(argv[i], "--duration") == 0 && i + 1 < argc)
+            headlessOptions.MaxSeconds = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--stats-interval") == 0 && i + 1 < argc)
+            headlessOptions.StatsInterval = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc)
+            headlessOptions.CapturePath = argv[++i];
+        else if (std::strcmp(argv[i], "--capture-size") == 0 && i + 1 < argc)
+        {
+            if (std::sscanf(argv[++i], "%dx%d", &headlessOptions.CaptureWidth, &headlessOptions.CaptureHeight) != 2)
+                fprintf(stderr, "Invalid capture size: %s (expected WxH)\n", argv[i]);
+        }
+        else
+            fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+    }
+
     DEBUG_PRINT("[START] Creating Global Engine ");
     // Small error where the constuctor would crash 
     MyEngine engine;
     DEBUG_PRINT("[OK] Creating Global Engine ");
 
-
-    if (!engine.Init(1280, 720, "Tesseract Engine"))
+    if (headless)
+    {
+        if (headlessOptions.ScenePath.empty())
+        {
+            fprintf(stderr, "--headless needs --scene <path>\n");
+            return 1;
+        }
+        if (!engine.InitHeadless(headlessOptions))
+        {
+            fprintf(stderr, "Failed to initialize headless engine.\n");
+            return 1;
+        }
+    }
+    else if (!engine.Init(1280, 720, "Tesseract Engine"))
     {
         fprintf(stderr, "Failed to initialize engine.\n");
         return 1;
     }
 
+    if (traceFrames > 0)
+    {
+        Profiler::Get().BeginCapture(traceFrames, traceFile);
+        DEBUG_PRINT("Capturing a trace of %d frames", traceFrames);
+    }
+
     // Main loop
-    engine.Run();
+    if (headless)
+        engine.RunHeadless();
+    else
+        engine.Run();
 
     // Cleanup
     engine.Cleanup();